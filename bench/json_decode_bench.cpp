@@ -0,0 +1,142 @@
+// Server page decoding: the streaming ServerPageDecoder against the nlohmann DOM walk it replaced.
+// Build with -DALTMAN_BUILD_BENCHMARKS=ON and run json_decode_bench [iterations].
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <format>
+#include <print>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "network/roblox/server_page_decoder.h"
+
+namespace {
+    // A full page as /v1/games/{placeId}/servers/Public returns it: 100 servers, 20 players each
+    std::string makeServerPage() {
+        nlohmann::json data = nlohmann::json::array();
+        for (int server = 0; server < 100; ++server) {
+            nlohmann::json tokens = nlohmann::json::array();
+            for (int player = 0; player < 20; ++player) {
+                tokens.push_back(std::format("{:08X}{:08X}{:016X}", server, player, server * 7919 + player));
+            }
+            data.push_back({
+                {"id", std::format("{:08x}-4b1d-4c7e-9a3f-{:012x}", server * 2654435761u, server)},
+                {"maxPlayers", 30},
+                {"playing", 20},
+                {"playerTokens", std::move(tokens)},
+                {"players", nlohmann::json::array()},
+                {"fps", 59.93 + server * 0.001},
+                {"ping", 40 + server % 60},
+            });
+        }
+        const nlohmann::json page = {
+            {"previousPageCursor", nullptr},
+            {"nextPageCursor", "eyJzdGFydEluZGV4IjoxMDAsImRpc2NyaW1pbmF0b3IiOiJzb3J0T3JkZXI6QXNjIn0KNDI"},
+            {"data", std::move(data)},
+        };
+        return page.dump();
+    }
+
+    // The DOM version parseServerPage used before the SAX decoder
+    Roblox::ServerPage decodeDom(const std::string &text) {
+        auto json = nlohmann::json::parse(text, nullptr, false);
+        Roblox::ServerPage page;
+        if (json.is_discarded()) {
+            return page;
+        }
+        if (json.contains("nextPageCursor")) {
+            page.nextCursor
+                = json["nextPageCursor"].is_null() ? std::string {} : json["nextPageCursor"].get<std::string>();
+        }
+        if (json.contains("previousPageCursor")) {
+            page.prevCursor
+                = json["previousPageCursor"].is_null() ? std::string {} : json["previousPageCursor"].get<std::string>();
+        }
+        if (json.contains("data") && json["data"].is_array()) {
+            page.data.reserve(json["data"].size());
+            for (auto &e: json["data"]) {
+                PublicServerInfo s;
+                s.jobId = e.value("id", "");
+                s.currentPlayers = e.value("playing", 0);
+                s.maximumPlayers = e.value("maxPlayers", 0);
+                s.averagePing = e.value("ping", 0.0);
+                s.averageFps = e.value("fps", 0.0);
+                if (auto tokens = e.find("playerTokens"); tokens != e.end() && tokens->is_array()) {
+                    s.playerTokens.reserve(tokens->size());
+                    for (const auto &token: *tokens) {
+                        if (token.is_string()) {
+                            s.playerTokens.push_back(token.get<std::string>());
+                        }
+                    }
+                }
+                page.data.push_back(std::move(s));
+            }
+        }
+        return page;
+    }
+
+    Roblox::ServerPage decodeSax(const std::string &text) {
+        Roblox::ServerPage page;
+        page.data.reserve(100);
+        Roblox::ServerPageDecoder decoder(page);
+        if (!HttpClient::saxDecode(text, decoder)) {
+            return {};
+        }
+        return page;
+    }
+
+    bool samePage(const Roblox::ServerPage &a, const Roblox::ServerPage &b) {
+        if (a.nextCursor != b.nextCursor || a.prevCursor != b.prevCursor || a.data.size() != b.data.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < a.data.size(); ++i) {
+            const auto &x = a.data[i];
+            const auto &y = b.data[i];
+            if (x.jobId != y.jobId || x.currentPlayers != y.currentPlayers || x.maximumPlayers != y.maximumPlayers
+                || x.averagePing != y.averagePing || x.averageFps != y.averageFps || x.playerTokens != y.playerTokens) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<typename Decode> void run(const char *name, const std::string &text, int iterations, Decode decode) {
+        std::vector<double> micros;
+        micros.reserve(static_cast<size_t>(iterations));
+        size_t servers = 0;
+        for (int i = 0; i < iterations; ++i) {
+            const auto started = std::chrono::steady_clock::now();
+            const Roblox::ServerPage page = decode(text);
+            micros.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - started).count());
+            servers += page.data.size();
+        }
+        std::ranges::sort(micros);
+        const double median = micros[micros.size() / 2];
+        std::println(
+            "{:<4} median {:8.1f} us  p99 {:8.1f} us  {:7.1f} MB/s  ({} servers)",
+            name,
+            median,
+            micros[std::min(micros.size() - 1, micros.size() * 99 / 100)],
+            static_cast<double>(text.size()) / median,
+            servers / static_cast<size_t>(iterations)
+        );
+    }
+} // namespace
+
+int main(int argc, char **argv) {
+    const int iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2000;
+    const std::string text = makeServerPage();
+
+    if (!samePage(decodeDom(text), decodeSax(text))) {
+        std::println(stderr, "DOM and SAX decoders disagree on the sample page");
+        return 1;
+    }
+
+    std::println("server page, {} bytes, {} iterations", text.size(), iterations);
+    run("DOM", text, iterations, decodeDom);
+    run("SAX", text, iterations, decodeSax);
+    return 0;
+}
@@ -0,0 +1,196 @@
+// Account refresh for synthetic fleets, answered by the replay transport instead of Roblox: the
+// per-account info phase and the batched presence call of refreshAccounts(), through the real
+// limiter, retries and hedging. Build with -DALTMAN_BUILD_BENCHMARKS=ON and run
+// refresh_replay_bench [accounts...] (100, 1000 and 10000 by default). ALTMAN_HTTP_CASSETTE picks a
+// recorded cassette; without it a synthetic one is written to the temp directory. The limiter is
+// configured as the app configures it, so past about 84 accounts a fleet is held to 150 requests
+// per 30 s window: four requests an account puts the 10,000 account fleet at over two hours.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <print>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "components/data.h"
+#include "console/console.h"
+#include "network/http.h"
+#include "network/http_transport.h"
+#include "network/roblox/auth.h"
+#include "network/roblox/session.h"
+#include "utils/shutdown_manager.h"
+
+// The console's sinks live in the UI; the bench only needs warnings and errors on stderr
+namespace Console {
+    const char *CategoryName(Category category) {
+        constexpr const char *NAMES[] = {
+            "General", "Network", "Auth", "Accounts", "Presence", "Friends", "Games", "History", "Launcher",
+        };
+        return NAMES[static_cast<size_t>(category)];
+    }
+
+    void Log(Category category, Level level, const std::string &message) {
+        if (level == Level::Warn || level == Level::Error) {
+            std::println(stderr, "[{}] {}", CategoryName(category), message);
+        }
+    }
+
+    void Log(Level level, const std::string &message) { Log(Category::General, level, message); }
+
+    void Event(Category category, Level level, const char *event, std::initializer_list<Field>) {
+        Log(category, level, std::string(event));
+    }
+} // namespace Console
+
+namespace {
+    // Distinct users the synthetic cassette hands out in turn
+    constexpr int CASSETTE_USERS = 100;
+    constexpr uint64_t FIRST_USER_ID = 1000000;
+
+    void writeInteraction(
+        std::ofstream &out,
+        const char *method,
+        const char *endpoint,
+        const nlohmann::json &response,
+        int elapsedMs
+    ) {
+        const nlohmann::json entry = {
+            {"method", method},
+            {"url", std::format("https://{}", endpoint)},
+            {"endpoint", endpoint},
+            {"body", ""},
+            {"status", 200},
+            {"headers", "HTTP/1.1 200 OK\r\ncontent-type: application/json\r\n\r\n"},
+            {"response", response.dump()},
+            {"elapsedMs", elapsedMs},
+        };
+        out << entry.dump() << '\n';
+    }
+
+    // What refresh asks for, with latencies in the range the live API answers in
+    std::filesystem::path writeSyntheticCassette() {
+        const auto path = std::filesystem::temp_directory_path() / "altman_refresh_bench.jsonl";
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        writeInteraction(out, "GET", "usermoderation.roblox.com/v1/not-approved", nlohmann::json::object(), 60);
+        writeInteraction(out, "GET", "usermoderation.roblox.com/v2/not-approved", {{"restriction", nullptr}}, 60);
+        writeInteraction(out, "GET", "voice.roblox.com/v1/settings", {{"isVoiceEnabled", false}}, 70);
+
+        nlohmann::json presences = nlohmann::json::array();
+        for (int i = 0; i < CASSETTE_USERS; ++i) {
+            const uint64_t userId = FIRST_USER_ID + static_cast<uint64_t>(i);
+            const nlohmann::json user = {
+                {"id", userId},
+                {"name", std::format("bench_user_{}", i)},
+                {"displayName", std::format("Bench {}", i)},
+            };
+            writeInteraction(out, "GET", "users.roblox.com/v1/users/authenticated", user, 50);
+            presences.push_back({{"userPresenceType", 0}, {"userId", userId}, {"lastLocation", "Website"}});
+        }
+        writeInteraction(out, "POST", "presence.roblox.com/v1/presence/users", {{"userPresences", presences}}, 90);
+        return path;
+    }
+
+    struct CycleResult {
+            std::chrono::milliseconds elapsed {0};
+            size_t refreshed = 0;
+            size_t presences = 0;
+    };
+
+    CycleResult refreshFleet(size_t accounts, size_t fleetIndex) {
+        HttpClient::PriorityScope priority(HttpClient::RequestPriority::Background);
+        // The limiter and concurrency configureRefreshConcurrency() sets up for a fleet this size, so
+        // the numbers include the time spent queued for the per-window budget
+        const int rateLimit = static_cast<int>(std::clamp(static_cast<double>(accounts) * 1.8, 30.0, 150.0));
+        HttpClient::RateLimiter::instance().configure(rateLimit, std::chrono::seconds(g_rateLimitWindow));
+        const size_t workers = static_cast<size_t>(rateLimit / 5);
+        // A fresh set of cookies per fleet, so no fleet is answered from the previous one's caches
+        std::vector<std::string> cookies(accounts);
+        for (size_t i = 0; i < accounts; ++i) {
+            cookies[i] = std::format("_|WARNING:-DO-NOT-SHARE-THIS.--bench-{}-{}", fleetIndex, i);
+        }
+
+        const auto started = std::chrono::steady_clock::now();
+        std::atomic<size_t> next {0};
+        std::vector<uint64_t> userIds(accounts, 0);
+        std::vector<std::thread> pool;
+        pool.reserve(workers);
+        for (size_t w = 0; w < workers; ++w) {
+            pool.emplace_back([&] {
+                HttpClient::PriorityScope workerPriority(HttpClient::RequestPriority::Background);
+                for (size_t i = next++; i < accounts; i = next++) {
+                    HttpClient::AccountScope account(static_cast<int>(i + 1));
+                    if (auto info = Roblox::fetchFullAccountInfo(cookies[i])) {
+                        userIds[i] = info->userId;
+                    }
+                }
+            });
+        }
+        for (auto &thread: pool) {
+            thread.join();
+        }
+
+        CycleResult result;
+        std::erase(userIds, 0);
+        result.refreshed = userIds.size();
+        if (!userIds.empty()) {
+            result.presences = Roblox::getPresences(userIds, cookies.front()).size();
+        }
+        result.elapsed
+            = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started);
+        return result;
+    }
+} // namespace
+
+int main(int argc, char **argv) {
+    std::vector<size_t> fleets;
+    for (int i = 1; i < argc; ++i) {
+        fleets.push_back(static_cast<size_t>(std::max(1, std::atoi(argv[i]))));
+    }
+    if (fleets.empty()) {
+        fleets = {100, 1000, 10000};
+    }
+
+    const char *recorded = std::getenv("ALTMAN_HTTP_CASSETTE");
+    const std::filesystem::path cassette = recorded && *recorded ? recorded : writeSyntheticCassette();
+    HttpClient::setTransport(HttpClient::makeReplayTransport(cassette));
+    std::println("replaying {}", cassette.string());
+
+    for (size_t f = 0; f < fleets.size(); ++f) {
+        HttpClient::Metrics::reset();
+        const CycleResult cycle = refreshFleet(fleets[f], f);
+
+        uint64_t requests = 0;
+        uint64_t retries = 0;
+        double limiterWaitMs = 0.0;
+        for (const auto &endpoint: HttpClient::endpointMetrics()) {
+            requests += endpoint.requests;
+            retries += endpoint.retries;
+            limiterWaitMs += endpoint.limiterWaitMs;
+        }
+        std::println(
+            "{:>6} accounts  {:8} ms  {:7.1f} accounts/s  {} refreshed  {} presences  {} requests  {} retries  "
+            "{:.0f} ms queued in the limiter",
+            fleets[f],
+            cycle.elapsed.count(),
+            static_cast<double>(fleets[f]) * 1000.0 / static_cast<double>(std::max<int64_t>(1, cycle.elapsed.count())),
+            cycle.refreshed,
+            cycle.presences,
+            requests,
+            retries,
+            limiterWaitMs
+        );
+    }
+
+    ShutdownManager::instance().requestShutdown();
+    ShutdownManager::instance().waitForShutdown();
+    return 0;
+}
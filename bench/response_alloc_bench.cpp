@@ -0,0 +1,236 @@
+// Allocations per response: the copies HttpClient used to make out of cpr's response against the
+// moves it makes now (Response::text, the lazily parsed Headers, get_binary's write callback).
+// Build with -DALTMAN_BUILD_BENCHMARKS=ON and run response_alloc_bench [iterations].
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <print>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "network/http_headers.h"
+
+namespace {
+    // Everything below runs on one thread, so plain counters will do
+    size_t g_allocations = 0;
+    size_t g_allocatedBytes = 0;
+} // namespace
+
+void *operator new(std::size_t size) {
+    ++g_allocations;
+    g_allocatedBytes += size;
+    if (void *p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+    constexpr std::string_view RAW_HEADER
+        = "HTTP/2 200\r\n"
+          "content-type: application/json; charset=utf-8\r\n"
+          "date: Sun, 18 Oct 2026 12:00:00 GMT\r\n"
+          "server: public-gateway\r\n"
+          "cache-control: no-cache\r\n"
+          "strict-transport-security: max-age=3600\r\n"
+          "x-frame-options: SAMEORIGIN\r\n"
+          "roblox-machine-id: 1a2b3c4d-5e6f\r\n"
+          "x-roblox-region: US-Central\r\n"
+          "x-roblox-edge: chicago\r\n"
+          "report-to: {\"group\":\"network-errors\",\"max_age\":604800}\r\n"
+          "nel: {\"report_to\":\"network-errors\",\"max_age\":604800}\r\n"
+          "set-cookie: RBXEventTrackerV2=CreateDate=10/18/2026; domain=roblox.com; path=/\r\n"
+          "set-cookie: GuestData=UserID=-123456789; domain=roblox.com; path=/\r\n"
+          "x-csrf-token: 0123456789ab\r\n"
+          "content-encoding: gzip\r\n"
+          "vary: Accept-Encoding\r\n"
+          "\r\n";
+
+    // What cpr has already split the block into by the time a response reaches HttpClient
+    std::map<std::string, std::string> parsedHeader() {
+        return {
+            {"content-type", "application/json; charset=utf-8"},
+            {"date", "Sun, 18 Oct 2026 12:00:00 GMT"},
+            {"server", "public-gateway"},
+            {"cache-control", "no-cache"},
+            {"strict-transport-security", "max-age=3600"},
+            {"x-frame-options", "SAMEORIGIN"},
+            {"roblox-machine-id", "1a2b3c4d-5e6f"},
+            {"x-roblox-region", "US-Central"},
+            {"x-roblox-edge", "chicago"},
+            {"report-to", "{\"group\":\"network-errors\",\"max_age\":604800}"},
+            {"nel", "{\"report_to\":\"network-errors\",\"max_age\":604800}"},
+            {"set-cookie",
+             "RBXEventTrackerV2=CreateDate=10/18/2026; domain=roblox.com; path=/, "
+             "GuestData=UserID=-123456789; domain=roblox.com; path=/"},
+            {"x-csrf-token", "0123456789ab"},
+            {"content-encoding", "gzip"},
+            {"vary", "Accept-Encoding"},
+        };
+    }
+
+    // The parts of a cpr::Response the conversion touches
+    struct Source {
+            std::string text;
+            std::string rawHeader;
+            std::map<std::string, std::string> header;
+    };
+
+    struct OldResponse {
+            int status_code;
+            std::string text;
+            std::map<std::string, std::string> headers;
+    };
+
+    struct NewResponse {
+            int status_code;
+            std::string text;
+            HttpClient::Headers headers;
+    };
+
+    struct Cost {
+            double allocations = 0.0;
+            double bytes = 0.0;
+            double medianNs = 0.0;
+    };
+
+    // prepare() builds the input outside the measurement; op() is what gets counted and timed
+    template<typename Prepare, typename Op> Cost measure(int iterations, Prepare prepare, Op op) {
+        std::vector<double> ns;
+        ns.reserve(static_cast<size_t>(iterations));
+        size_t allocations = 0;
+        size_t bytes = 0;
+        for (int i = 0; i < iterations; ++i) {
+            auto input = prepare();
+            const size_t allocationsBefore = g_allocations;
+            const size_t bytesBefore = g_allocatedBytes;
+            const auto started = std::chrono::steady_clock::now();
+            op(input);
+            const auto elapsed = std::chrono::steady_clock::now() - started;
+            allocations += g_allocations - allocationsBefore;
+            bytes += g_allocatedBytes - bytesBefore;
+            ns.push_back(std::chrono::duration<double, std::nano>(elapsed).count());
+        }
+        std::ranges::sort(ns);
+        return {
+            static_cast<double>(allocations) / iterations,
+            static_cast<double>(bytes) / iterations,
+            ns[ns.size() / 2],
+        };
+    }
+
+    void report(const char *name, const Cost &before, const Cost &after) {
+        std::println(
+            "{:<24} allocs {:6.1f} -> {:6.1f}   bytes {:9.0f} -> {:9.0f}   median {:8.0f} -> {:8.0f} ns",
+            name,
+            before.allocations,
+            after.allocations,
+            before.bytes,
+            after.bytes,
+            before.medianNs,
+            after.medianNs
+        );
+    }
+
+    int g_sink = 0; // keeps the optimiser from dropping the work
+
+    std::string jsonBody() {
+        std::string body = R"({"data":[)";
+        for (int i = 0; i < 40; ++i) {
+            body += R"({"id":1234567890,"name":"SomeUserName","displayName":"Some Display Name"},)";
+        }
+        body.back() = ']';
+        body += '}';
+        return body;
+    }
+} // namespace
+
+int main(int argc, char **argv) {
+    const int iterations = argc > 1 ? std::max(1, std::atoi(argv[1])) : 20000;
+    const std::string body = jsonBody();
+
+    auto source = [&] { return Source {body, std::string(RAW_HEADER), parsedHeader()}; };
+
+    auto copyOut = [](Source &s) {
+        OldResponse r {200, s.text, std::map<std::string, std::string>(s.header.begin(), s.header.end())};
+        g_sink += static_cast<int>(r.text.size() + r.headers.size());
+        return r;
+    };
+    auto moveOut = [](Source &s) {
+        return NewResponse {200, std::move(s.text), HttpClient::Headers(std::move(s.rawHeader))};
+    };
+
+    std::println("{} iterations, {} byte body, {} header lines", iterations, body.size(), parsedHeader().size());
+
+    report(
+        "response, headers unread",
+        measure(iterations, source, [&](Source &s) { copyOut(s); }),
+        measure(iterations, source, [&](Source &s) { g_sink += static_cast<int>(moveOut(s).text.size()); })
+    );
+
+    report(
+        "response, one lookup",
+        measure(
+            iterations,
+            source,
+            [&](Source &s) {
+                const OldResponse r = copyOut(s);
+                g_sink += r.headers.contains("x-csrf-token") ? 1 : 0;
+            }
+        ),
+        measure(
+            iterations,
+            source,
+            [&](Source &s) {
+                const NewResponse r = moveOut(s);
+                g_sink += r.headers.contains("X-CSRF-TOKEN") ? 1 : 0;
+            }
+        )
+    );
+
+    // A 150 KB image arriving in curl's 16 KB chunks: appended to cpr's text and copied into a
+    // vector, against appended to the returned vector directly
+    constexpr size_t IMAGE_BYTES = 150 * 1024;
+    constexpr size_t CHUNK_BYTES = 16 * 1024;
+    const std::string chunk(CHUNK_BYTES, '\x89');
+    auto deliver = [&](auto &&append) {
+        for (size_t sent = 0; sent < IMAGE_BYTES; sent += CHUNK_BYTES) {
+            append(std::string_view(chunk).substr(0, std::min(CHUNK_BYTES, IMAGE_BYTES - sent)));
+        }
+    };
+    auto nothing = [] { return 0; };
+
+    report(
+        "get_binary body",
+        measure(
+            iterations / 10 + 1,
+            nothing,
+            [&](int) {
+                std::string text;
+                deliver([&](std::string_view part) { text.append(part); });
+                const std::vector<uint8_t> data(text.begin(), text.end());
+                g_sink += static_cast<int>(data.size());
+            }
+        ),
+        measure(
+            iterations / 10 + 1,
+            nothing,
+            [&](int) {
+                std::vector<uint8_t> data;
+                deliver([&](std::string_view part) { data.insert(data.end(), part.begin(), part.end()); });
+                g_sink += static_cast<int>(data.size());
+            }
+        )
+    );
+
+    return g_sink == 42 ? 1 : 0;
+}
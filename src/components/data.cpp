@@ -17,6 +17,7 @@
 #include "console/console.h"
 #include "utils/account_utils.h"
 #include "utils/base64.h"
+#include "utils/json_fields.h"
 #include "utils/paths.h"
 
 namespace {
@@ -79,28 +80,45 @@ namespace {
         return it->get<T>();
     }
 
+    using JsonFields::field;
+
+    // Plain persisted fields; the cookie, password and HBA private key are stored encrypted under
+    // their own names and handled around these
+    constexpr auto kAccountFields = JsonFields::fields(
+        field("id", &AccountData::id),
+        field("displayName", &AccountData::displayName),
+        field("username", &AccountData::username),
+        field("userId", &AccountData::userId),
+        field("status", &AccountData::status),
+        field("voiceStatus", &AccountData::voiceStatus),
+        field("voiceBanExpiry", &AccountData::voiceBanExpiry),
+        field("banExpiry", &AccountData::banExpiry),
+        field("note", &AccountData::note),
+        field("isFavorite", &AccountData::isFavorite),
+        field("lastLocation", &AccountData::lastLocation),
+        field("placeId", &AccountData::placeId),
+        field("jobId", &AccountData::jobId),
+        //field("isUsingCustomClient", &AccountData::isUsingCustomClient),
+        //field("clientName", &AccountData::clientName),
+        field("customClientBase", &AccountData::customClientBase),
+        field("cookieAutoRefresh", &AccountData::cookieAutoRefresh),
+        field("cookieLastUse", &AccountData::cookieLastUse),
+        field("cookieLastRefreshAttempt", &AccountData::cookieLastRefreshAttempt),
+        field("hbaPublicKey", &AccountData::hbaPublicKey)
+    );
+    static_assert(JsonFields::uniqueNames(kAccountFields));
+
+    constexpr auto kFriendFields = JsonFields::fields(
+        field("userId", &FriendInfo::id),
+        field("username", &FriendInfo::username),
+        field("displayName", &FriendInfo::displayName)
+    );
+    static_assert(JsonFields::uniqueNames(kFriendFields));
+
     AccountData parseAccount(const nlohmann::json &item) {
         AccountData account {};
-        account.id = safeGet(item, "id", 0);
-        account.displayName = safeGet<std::string>(item, "displayName", "");
-        account.username = safeGet<std::string>(item, "username", "");
-        account.userId = safeGet<std::string>(item, "userId", "");
-        account.status = safeGet<std::string>(item, "status", "");
-        account.voiceStatus = safeGet<std::string>(item, "voiceStatus", "");
-        account.voiceBanExpiry = safeGet(item, "voiceBanExpiry", 0);
-        account.banExpiry = safeGet(item, "banExpiry", 0);
-        account.note = safeGet<std::string>(item, "note", "");
-        account.isFavorite = safeGet(item, "isFavorite", false);
-        account.lastLocation = safeGet<std::string>(item, "lastLocation", "");
-        account.placeId = safeGet(item, "placeId", 0ULL);
-        account.jobId = safeGet<std::string>(item, "jobId", "");
-        //account.isUsingCustomClient = safeGet<bool>(item, "isUsingCustomClient", false);
-        //account.clientName = safeGet<std::string>(item, "clientName", "");
-        account.customClientBase = safeGet<std::string>(item, "customClientBase", "");
-        account.cookieAutoRefresh = safeGet<bool>(item, "cookieAutoRefresh", false);
-        account.cookieLastUse = safeGet(item, "cookieLastUse", std::time(nullptr));
-        account.cookieLastRefreshAttempt = safeGet(item, "cookieLastRefreshAttempt", 0);
-        account.hbaPublicKey = safeGet<std::string>(item, "hbaPublicKey", "");
+        account.cookieLastUse = std::time(nullptr);
+        JsonFields::read(item, account, kAccountFields);
 
         if (item.contains("encryptedCookie")) {
             const auto encrypted = safeGet<std::string>(item, "encryptedCookie", "");
@@ -117,39 +135,25 @@ namespace {
             account.hbaPrivateKey = Data::decryptLocalData(encrypted);
         }
 
+        // Proxy URLs can carry credentials, so they are stored like the password
+        if (item.contains("encryptedProxy")) {
+            const auto encrypted = safeGet<std::string>(item, "encryptedProxy", "");
+            account.proxy = Data::decryptLocalData(encrypted);
+        }
+
         return account;
     }
 
     nlohmann::json serializeAccount(const AccountData &account) {
-        const auto encryptedCookie = Data::encryptLocalData(account.cookie).value_or("");
-        const auto encryptedPassword = Data::encryptLocalData(account.password).value_or("");
-        const auto encryptedHbaPrivateKey = Data::encryptLocalData(account.hbaPrivateKey).value_or("");
-
-        return {
-            {"id",                       account.id                      },
-            {"displayName",              account.displayName             },
-            {"username",                 account.username                },
-            {"userId",                   account.userId                  },
-            {"status",                   account.status                  },
-            {"voiceStatus",              account.voiceStatus             },
-            {"voiceBanExpiry",           account.voiceBanExpiry          },
-            {"banExpiry",                account.banExpiry               },
-            {"note",                     account.note                    },
-            {"encryptedCookie",          encryptedCookie                 },
-            {"encryptedPassword",        encryptedPassword               },
-            {"isFavorite",               account.isFavorite              },
-            {"lastLocation",             account.lastLocation            },
-            {"placeId",                  account.placeId                 },
-            {"jobId",                    account.jobId                   },
-            //{"isUsingCustomClient",      account.isUsingCustomClient     },
-            //{"clientName",               account.clientName              },
-            {"customClientBase",         account.customClientBase        },
-            {"cookieAutoRefresh",        account.cookieAutoRefresh       },
-            {"cookieLastUse",            account.cookieLastUse           },
-            {"cookieLastRefreshAttempt", account.cookieLastRefreshAttempt},
-            {"hbaPublicKey",             account.hbaPublicKey            },
-            {"hbaEncryptedPrivateKey",   encryptedHbaPrivateKey          }
-        };
+        nlohmann::json j = nlohmann::json::object();
+        JsonFields::write(j, account, kAccountFields);
+        j["encryptedCookie"] = Data::encryptLocalData(account.cookie).value_or("");
+        j["encryptedPassword"] = Data::encryptLocalData(account.password).value_or("");
+        j["hbaEncryptedPrivateKey"] = Data::encryptLocalData(account.hbaPrivateKey).value_or("");
+        if (!account.proxy.empty()) {
+            j["encryptedProxy"] = Data::encryptLocalData(account.proxy).value_or("");
+        }
+        return j;
     }
 
     std::vector<FriendInfo> parseFriendList(const nlohmann::json &arr) {
@@ -162,9 +166,7 @@ namespace {
             }
 
             FriendInfo info {};
-            info.id = safeGet(item, "userId", 0ULL);
-            info.username = safeGet<std::string>(item, "username", "");
-            info.displayName = safeGet<std::string>(item, "displayName", "");
+            JsonFields::read(item, info, kFriendFields);
             result.push_back(std::move(info));
         }
         return result;
@@ -173,11 +175,9 @@ namespace {
     nlohmann::json serializeFriendList(const std::vector<FriendInfo> &friends) {
         nlohmann::json arr = nlohmann::json::array();
         for (const auto &f: friends) {
-            arr.push_back({
-                {"userId",      f.id         },
-                {"username",    f.username   },
-                {"displayName", f.displayName}
-            });
+            nlohmann::json item = nlohmann::json::object();
+            JsonFields::write(item, f, kFriendFields);
+            arr.push_back(std::move(item));
         }
         return arr;
     }
@@ -476,6 +476,19 @@ namespace Data {
             g_clearCacheOnLaunch = safeGet(j, "clearCacheOnLaunch", false);
             g_multiRobloxEnabled = safeGet(j, "multiRobloxEnabled", false);
             g_privacyModeEnabled = safeGet(j, "privacyModeEnabled", false);
+            g_consoleRetention = std::max(100, safeGet(j, "consoleRetention", 5000));
+            Console::SetRetention(static_cast<size_t>(g_consoleRetention));
+
+            if (j.contains("logLevels") && j["logLevels"].is_object()) {
+                const auto &levels = j["logLevels"];
+                for (int c = 0; c < static_cast<int>(Console::Category::Count); ++c) {
+                    const auto category = static_cast<Console::Category>(c);
+                    const int level = safeGet(levels, Console::CategoryName(category), -1);
+                    if (level >= 0 && level <= static_cast<int>(Console::Level::Error)) {
+                        Console::SetCategoryLevel(category, static_cast<Console::Level>(level));
+                    }
+                }
+            }
 
             if (j.contains("clientKeys") && j["clientKeys"].is_object()) {
                 g_clientKeys.clear();
@@ -493,6 +506,12 @@ namespace Data {
     }
 
     void SaveSettings(std::string_view filename) {
+        nlohmann::json logLevels = nlohmann::json::object();
+        for (int c = 0; c < static_cast<int>(Console::Category::Count); ++c) {
+            const auto category = static_cast<Console::Category>(c);
+            logLevels[Console::CategoryName(category)] = static_cast<int>(Console::GetCategoryLevel(category));
+        }
+
         const nlohmann::json j = {
             {"defaultAccountId",      g_defaultAccountId     },
             {"statusRefreshInterval", g_statusRefreshInterval},
@@ -501,7 +520,9 @@ namespace Data {
             {"clearCacheOnLaunch",    g_clearCacheOnLaunch   },
             {"multiRobloxEnabled",    g_multiRobloxEnabled   },
             {"clientKeys",            g_clientKeys           },
-            {"privacyModeEnabled",    g_privacyModeEnabled   }
+            {"privacyModeEnabled",    g_privacyModeEnabled   },
+            {"consoleRetention",      g_consoleRetention     },
+            {"logLevels",             logLevels              }
         };
 
         const auto path = AltMan::Paths::Config(filename).string();
@@ -40,6 +40,7 @@ struct AccountData {
         time_t cookieLastRefreshAttempt = 0;
         std::string hbaPublicKey; // HBA keypair: persisted so Roblox sees the same device across restarts
         std::string hbaPrivateKey;
+        std::string proxy; // outbound proxy URL for this account's requests, empty for direct
 };
 
 struct AccountGroup {
@@ -94,6 +95,7 @@ inline std::unordered_map<std::string, std::string> g_clientKeys;
 inline bool g_forceLatestRobloxVersion = false;
 inline std::vector<std::string> g_availableClientsNames = {"Default", "MacSploit", "Hydrogen", "Delta"};
 inline bool g_privacyModeEnabled = false;
+inline int g_consoleRetention = 5000; // lines kept in the Console tab
 
 void invalidateAccountIndex();
 AccountData *getAccountById(int id);
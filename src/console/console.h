@@ -1,31 +1,130 @@
 #pragma once
 
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <format>
+#include <initializer_list>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
 #include <vector>
 
 namespace Console {
 
     enum class Level {
+        Debug,
         Info,
         Warn,
         Error
     };
 
+    // Source of a message, used to attribute log volume
+    enum class Category {
+        General,
+        Network,
+        Auth,
+        Accounts,
+        Presence,
+        Friends,
+        Games,
+        History,
+        Launcher,
+        Count
+    };
+
+    const char *CategoryName(Category category);
+
+    struct CategoryVolume {
+            Category category;
+            uint64_t messages = 0;
+            uint64_t bytes = 0;
+    };
+
+    // Structured key/value attached to an event. Values are stored raw and only turned into text
+    // when a line is rendered or written to disk.
+    struct Field {
+            using Value = std::variant<int64_t, uint64_t, double, bool, std::string>;
+
+            const char *key;
+            Value value;
+
+            Field(const char *k, bool v) : key(k), value(v) {}
+            template<std::signed_integral T> Field(const char *k, T v) : key(k), value(static_cast<int64_t>(v)) {}
+            template<std::unsigned_integral T> Field(const char *k, T v) : key(k), value(static_cast<uint64_t>(v)) {}
+            Field(const char *k, double v) : key(k), value(v) {}
+            Field(const char *k, std::string v) : key(k), value(std::move(v)) {}
+            Field(const char *k, std::string_view v) : key(k), value(std::string(v)) {}
+            Field(const char *k, const char *v) : key(k), value(std::string(v)) {}
+    };
+
+    // Lines kept in memory for the Console tab; older lines are dropped first
+    inline constexpr size_t DEFAULT_RETENTION = 5000;
+
     void Log(Level level, const std::string &message);
+    void Log(Category category, Level level, const std::string &message);
+    void Event(Category category, Level level, const char *event, std::initializer_list<Field> fields);
+
+    // Level threshold and token-bucket sampling for a category. Warnings and errors are never
+    // sampled; Debug and Info lines beyond the bucket are counted and reported in a periodic summary.
+    // Checked by the logging macros before any argument is formatted.
+    bool ShouldLog(Category category, Level level);
+    void SetCategoryLevel(Category category, Level level);
+    Level GetCategoryLevel(Category category);
+    void SetCategorySampling(Category category, double perSecond, double burst);
+    uint64_t GetSuppressedTotal(Category category);
+    std::vector<std::pair<Category, uint64_t>> TakeSuppressedCounts();
 
     template<typename... Args> void Log(Level level, std::format_string<Args...> fmt, Args &&...args);
+    template<typename... Args>
+    void Log(Category category, Level level, std::format_string<Args...> fmt, Args &&...args);
 
     void RenderConsoleTab();
 
+    // The thread that publishes queued entries to the console and the log file. Started once the app
+    // is initialising, so the log directory is only resolved then; entries logged earlier wait in the queue.
+    void StartLogger();
+    void StopLogger();
+
+    void SetRetention(size_t lines);
+    size_t GetRetention();
+
+    std::vector<CategoryVolume> GetCategoryVolumes();
+
     std::vector<std::string> GetLogs();
     std::string GetLatestLogMessageForStatus();
 
     template<typename... Args> inline void Log(Level level, std::format_string<Args...> fmt, Args &&...args) {
         Log(level, std::format(fmt, std::forward<Args>(args)...));
     }
+
+    template<typename... Args>
+    inline void Log(Category category, Level level, std::format_string<Args...> fmt, Args &&...args) {
+        Log(category, level, std::format(fmt, std::forward<Args>(args)...));
+    }
 } // namespace Console
 
 #define LOG_INFO(...) Console::Log(Console::Level::Info, __VA_ARGS__)
 #define LOG_WARN(...) Console::Log(Console::Level::Warn, __VA_ARGS__)
 #define LOG_ERROR(...) Console::Log(Console::Level::Error, __VA_ARGS__)
+
+#define LOG_CAT(category, level, ...)                                                                       \
+    do {                                                                                                   \
+        if (Console::ShouldLog(Console::Category::category, Console::Level::level)) {                      \
+            Console::Log(Console::Category::category, Console::Level::level, __VA_ARGS__);                \
+        }                                                                                                  \
+    } while (false)
+
+#define LOG_CAT_DEBUG(category, ...) LOG_CAT(category, Debug, __VA_ARGS__)
+#define LOG_CAT_INFO(category, ...) LOG_CAT(category, Info, __VA_ARGS__)
+#define LOG_CAT_WARN(category, ...) LOG_CAT(category, Warn, __VA_ARGS__)
+#define LOG_CAT_ERROR(category, ...) LOG_CAT(category, Error, __VA_ARGS__)
+
+// LOG_EVENT(Presence, Debug, "presence.fetch", {"userId", id}, {"status", code})
+#define LOG_EVENT(category, level, event, ...)                                                              \
+    do {                                                                                                   \
+        if (Console::ShouldLog(Console::Category::category, Console::Level::level)) {                      \
+            Console::Event(Console::Category::category, Console::Level::level, event, {__VA_ARGS__});      \
+        }                                                                                                  \
+    } while (false)
@@ -0,0 +1,255 @@
+#include "log_file_sink.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <ctime>
+#include <format>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <utility>
+
+namespace Console {
+
+    namespace {
+        constexpr size_t COMPRESS_CHUNK = 64 * 1024;
+
+        std::string rotationStamp(std::chrono::system_clock::time_point time) {
+            auto in_time_t = std::chrono::system_clock::to_time_t(time);
+            std::tm buf {};
+
+#ifdef _WIN32
+            localtime_s(&buf, &in_time_t);
+#else
+            localtime_r(&in_time_t, &buf);
+#endif
+
+            return std::format(
+                "{:04}{:02}{:02}-{:02}{:02}{:02}",
+                buf.tm_year + 1900,
+                buf.tm_mon + 1,
+                buf.tm_mday,
+                buf.tm_hour,
+                buf.tm_min,
+                buf.tm_sec
+            );
+        }
+
+        // Where a rotated file falls in rotation order: its stamp, then the -N suffix rotate() adds
+        // when the stamp is already taken (0 for none)
+        struct ArchiveOrder {
+                std::string stamp;
+                int index = 0;
+                std::filesystem::path path;
+        };
+
+        // Parses <prefix><YYYYMMDD-HHMMSS>[-N].log[.gz]; anything else in the directory is not ours
+        std::optional<ArchiveOrder> parseArchive(const std::filesystem::path &path, std::string_view prefix) {
+            constexpr size_t STAMP_LENGTH = 15;
+
+            const std::string filename = path.filename().string();
+            std::string_view name = filename;
+            if (!name.starts_with(prefix)) {
+                return std::nullopt;
+            }
+            name.remove_prefix(prefix.size());
+            if (name.ends_with(".gz")) {
+                name.remove_suffix(3);
+            }
+            if (!name.ends_with(".log")) {
+                return std::nullopt;
+            }
+            name.remove_suffix(4);
+
+            if (name.size() < STAMP_LENGTH || name[8] != '-') {
+                return std::nullopt;
+            }
+            for (size_t i = 0; i < STAMP_LENGTH; ++i) {
+                if (i != 8 && (name[i] < '0' || name[i] > '9')) {
+                    return std::nullopt;
+                }
+            }
+
+            ArchiveOrder order {std::string(name.substr(0, STAMP_LENGTH)), 0, path};
+            name.remove_prefix(STAMP_LENGTH);
+            if (!name.empty()) {
+                if (name.size() < 2 || name.front() != '-') {
+                    return std::nullopt;
+                }
+                name.remove_prefix(1);
+                const auto [end, error] = std::from_chars(name.data(), name.data() + name.size(), order.index);
+                if (error != std::errc {} || end != name.data() + name.size() || order.index < 1) {
+                    return std::nullopt;
+                }
+            }
+            return order;
+        }
+    } // namespace
+
+    LogFileSink::LogFileSink(std::filesystem::path directory, std::string baseName, Options options)
+        : m_directory(std::move(directory)),
+          m_baseName(std::move(baseName)),
+          m_options(options) {
+        m_thread = std::thread([this] {
+            run();
+        });
+    }
+
+    LogFileSink::~LogFileSink() {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopping = true;
+        }
+        m_cv.notify_all();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+    }
+
+    void LogFileSink::append(std::string &&chunk) {
+        {
+            std::lock_guard lock(m_mutex);
+            m_pending.push_back(std::move(chunk));
+        }
+        m_cv.notify_one();
+    }
+
+    void LogFileSink::run() {
+        // A log left over from the previous run is archived rather than appended to
+        std::error_code ec;
+        if (std::filesystem::file_size(currentPath(), ec) > 0 && !ec) {
+            rotate();
+        } else {
+            openFresh();
+        }
+
+        std::vector<std::string> batch;
+        for (;;) {
+            {
+                std::unique_lock lock(m_mutex);
+                m_cv.wait(lock, [this] {
+                    return !m_pending.empty() || m_stopping;
+                });
+                if (m_pending.empty() && m_stopping) {
+                    break;
+                }
+                batch.swap(m_pending);
+            }
+
+            if (m_file.is_open()) {
+                for (const auto &chunk: batch) {
+                    m_file.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+                    m_fileBytes += chunk.size();
+                }
+                m_file.flush();
+            }
+            batch.clear();
+
+            const bool tooBig = m_fileBytes >= m_options.maxBytes;
+            const bool tooOld = std::chrono::system_clock::now() - m_fileOpened >= m_options.maxAge;
+            if (tooBig || tooOld) {
+                rotate();
+            }
+        }
+
+        m_file.close();
+    }
+
+    void LogFileSink::openFresh() {
+        std::error_code ec;
+        std::filesystem::create_directories(m_directory, ec);
+
+        m_file.open(currentPath(), std::ios::binary | std::ios::trunc);
+        m_fileBytes = 0;
+        m_fileOpened = std::chrono::system_clock::now();
+    }
+
+    void LogFileSink::rotate() {
+        m_file.close();
+
+        const std::string stamp = rotationStamp(std::chrono::system_clock::now());
+        std::filesystem::path rotated = m_directory / std::format("{}-{}.log", m_baseName, stamp);
+        for (int n = 1; std::filesystem::exists(rotated) || std::filesystem::exists(rotated.string() + ".gz"); ++n) {
+            rotated = m_directory / std::format("{}-{}-{}.log", m_baseName, stamp, n);
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(currentPath(), rotated, ec);
+        openFresh();
+
+        if (!ec) {
+            compress(rotated);
+        }
+        pruneArchives();
+    }
+
+    void LogFileSink::compress(const std::filesystem::path &source) {
+        std::ifstream in(source, std::ios::binary);
+        if (!in.is_open()) {
+            return;
+        }
+
+        std::filesystem::path target = source;
+        target += ".gz";
+
+#ifdef _WIN32
+        gzFile out = gzopen_w(target.c_str(), "wb6");
+#else
+        gzFile out = gzopen(target.c_str(), "wb6");
+#endif
+        if (out == nullptr) {
+            return;
+        }
+
+        std::array<char, COMPRESS_CHUNK> buffer {};
+        bool ok = true;
+        while (ok && in) {
+            in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            const auto got = static_cast<unsigned>(in.gcount());
+            if (got > 0 && gzwrite(out, buffer.data(), got) != static_cast<int>(got)) {
+                ok = false;
+            }
+        }
+
+        ok = gzclose(out) == Z_OK && ok;
+        in.close();
+
+        std::error_code ec;
+        std::filesystem::remove(ok ? source : target, ec);
+    }
+
+    void LogFileSink::pruneArchives() {
+        const std::string prefix = m_baseName + "-";
+        std::vector<ArchiveOrder> archives;
+
+        std::error_code ec;
+        for (const auto &entry: std::filesystem::directory_iterator(m_directory, ec)) {
+            std::error_code typeEc;
+            if (!entry.is_regular_file(typeEc)) {
+                continue;
+            }
+            if (auto archive = parseArchive(entry.path(), prefix)) {
+                archives.push_back(std::move(*archive));
+            }
+        }
+
+        if (archives.size() <= m_options.keepFiles) {
+            return;
+        }
+
+        // Oldest first. Comparing names would put "<stamp>-1.log.gz" before "<stamp>.log.gz", since
+        // '-' sorts before '.', and prune the newer of the two
+        std::sort(archives.begin(), archives.end(), [](const ArchiveOrder &a, const ArchiveOrder &b) {
+            return std::tie(a.stamp, a.index) < std::tie(b.stamp, b.index);
+        });
+        const size_t excess = archives.size() - m_options.keepFiles;
+        for (size_t i = 0; i < excess; ++i) {
+            std::filesystem::remove(archives[i].path, ec);
+        }
+    }
+
+} // namespace Console
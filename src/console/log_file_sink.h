@@ -0,0 +1,63 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Console {
+
+    // Writes console output to <dir>/<baseName>.log on its own thread. Callers hand over whole
+    // batches of pre-formatted lines, so the logger thread never waits on disk. The active file is
+    // rotated when it passes maxBytes or maxAge; rotated files are gzipped on the sink thread and
+    // only the newest keepFiles archives are kept.
+    class LogFileSink {
+        public:
+            struct Options {
+                    uint64_t maxBytes = 8ull * 1024 * 1024;
+                    std::chrono::hours maxAge {24};
+                    size_t keepFiles = 14;
+            };
+
+            LogFileSink(std::filesystem::path directory, std::string baseName, Options options);
+            ~LogFileSink();
+
+            LogFileSink(const LogFileSink &) = delete;
+            LogFileSink &operator=(const LogFileSink &) = delete;
+
+            void append(std::string &&chunk);
+
+            [[nodiscard]] std::filesystem::path currentPath() const {
+                return m_directory / (m_baseName + ".log");
+            }
+
+        private:
+            void run();
+            void openFresh();
+            void rotate();
+            void compress(const std::filesystem::path &source);
+            void pruneArchives();
+
+            const std::filesystem::path m_directory;
+            const std::string m_baseName;
+            const Options m_options;
+
+            std::mutex m_mutex;
+            std::condition_variable m_cv;
+            std::vector<std::string> m_pending;
+            bool m_stopping = false;
+
+            // Sink thread only
+            std::ofstream m_file;
+            uint64_t m_fileBytes = 0;
+            std::chrono::system_clock::time_point m_fileOpened;
+
+            std::thread m_thread;
+    };
+
+} // namespace Console
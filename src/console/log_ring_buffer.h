@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace Console {
+
+    // Bounded multi-producer / single-consumer queue (Vyukov's sequence-numbered ring). Producers
+    // claim a slot with a single CAS and never block or allocate beyond moving their payload in;
+    // when the ring is full tryPush fails and the caller decides what to drop.
+    template<typename T> class RingBuffer {
+        public:
+            explicit RingBuffer(size_t capacity)
+                : m_mask(std::bit_ceil(capacity < 2 ? size_t {2} : capacity) - 1),
+                  m_cells(std::make_unique<Cell[]>(m_mask + 1)) {
+                for (size_t i = 0; i <= m_mask; ++i) {
+                    m_cells[i].sequence.store(i, std::memory_order_relaxed);
+                }
+            }
+
+            RingBuffer(const RingBuffer &) = delete;
+            RingBuffer &operator=(const RingBuffer &) = delete;
+
+            bool tryPush(T &&value) {
+                size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+                Cell *cell;
+
+                for (;;) {
+                    cell = &m_cells[pos & m_mask];
+                    const size_t seq = cell->sequence.load(std::memory_order_acquire);
+                    const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+                    if (diff == 0) {
+                        if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                            break;
+                        }
+                    } else if (diff < 0) {
+                        return false;
+                    } else {
+                        pos = m_enqueuePos.load(std::memory_order_relaxed);
+                    }
+                }
+
+                cell->value = std::move(value);
+                cell->sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+
+            // Consumer side only
+            bool tryPop(T &out) {
+                Cell &cell = m_cells[m_dequeuePos & m_mask];
+                if (cell.sequence.load(std::memory_order_acquire) != m_dequeuePos + 1) {
+                    return false;
+                }
+
+                out = std::move(cell.value);
+                cell.sequence.store(m_dequeuePos + m_mask + 1, std::memory_order_release);
+                ++m_dequeuePos;
+                return true;
+            }
+
+            [[nodiscard]] size_t capacity() const {
+                return m_mask + 1;
+            }
+
+        private:
+            struct Cell {
+                    std::atomic<size_t> sequence;
+                    T value;
+            };
+
+            static constexpr size_t CACHE_LINE = 64;
+
+            const size_t m_mask;
+            std::unique_ptr<Cell[]> m_cells;
+            alignas(CACHE_LINE) std::atomic<size_t> m_enqueuePos {0};
+            alignas(CACHE_LINE) size_t m_dequeuePos = 0;
+    };
+
+} // namespace Console
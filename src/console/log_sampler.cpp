@@ -0,0 +1,125 @@
+#include "console.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+namespace Console {
+
+    namespace {
+        struct CategoryPolicy {
+                std::atomic<int> threshold {static_cast<int>(Level::Info)};
+
+                std::mutex bucketMutex;
+                double perSecond = 0.0; // 0 disables sampling
+                double burst = 0.0;
+                double tokens = 0.0;
+                std::chrono::steady_clock::time_point lastRefill {};
+
+                std::atomic<uint64_t> suppressed {0}; // since the last summary
+                std::atomic<uint64_t> suppressedTotal {0};
+        };
+
+        struct SamplingDefault {
+                Category category;
+                double perSecond;
+                double burst;
+        };
+
+        // Sources that log once per account per refresh; everything else is unsampled
+        constexpr SamplingDefault SAMPLING_DEFAULTS[] = {
+            {Category::Network,  20.0, 100.0},
+            {Category::Auth,     10.0, 50.0 },
+            {Category::Accounts, 10.0, 50.0 },
+            {Category::Presence, 5.0,  25.0 },
+            {Category::Friends,  10.0, 50.0 },
+        };
+
+        std::array<CategoryPolicy, static_cast<size_t>(Category::Count)> &policies() {
+            static std::array<CategoryPolicy, static_cast<size_t>(Category::Count)> table;
+            static const bool seeded = [] {
+                for (const auto &d: SAMPLING_DEFAULTS) {
+                    auto &p = table[static_cast<size_t>(d.category)];
+                    p.perSecond = d.perSecond;
+                    p.burst = d.burst;
+                    p.tokens = d.burst;
+                }
+                return true;
+            }();
+            (void) seeded;
+            return table;
+        }
+
+        CategoryPolicy &policyFor(Category category) {
+            return policies()[std::min(static_cast<size_t>(category), static_cast<size_t>(Category::Count) - 1)];
+        }
+
+        bool takeToken(CategoryPolicy &p) {
+            std::lock_guard lock(p.bucketMutex);
+            if (p.perSecond <= 0.0) {
+                return true;
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            if (p.lastRefill != std::chrono::steady_clock::time_point {}) {
+                const double elapsed = std::chrono::duration<double>(now - p.lastRefill).count();
+                p.tokens = std::min(p.burst, p.tokens + elapsed * p.perSecond);
+            }
+            p.lastRefill = now;
+
+            if (p.tokens < 1.0) {
+                return false;
+            }
+            p.tokens -= 1.0;
+            return true;
+        }
+    } // namespace
+
+    bool ShouldLog(Category category, Level level) {
+        auto &p = policyFor(category);
+        if (static_cast<int>(level) < p.threshold.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        if (level >= Level::Warn || takeToken(p)) {
+            return true;
+        }
+
+        p.suppressed.fetch_add(1, std::memory_order_relaxed);
+        p.suppressedTotal.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void SetCategoryLevel(Category category, Level level) {
+        policyFor(category).threshold.store(static_cast<int>(level), std::memory_order_relaxed);
+    }
+
+    Level GetCategoryLevel(Category category) {
+        return static_cast<Level>(policyFor(category).threshold.load(std::memory_order_relaxed));
+    }
+
+    void SetCategorySampling(Category category, double perSecond, double burst) {
+        auto &p = policyFor(category);
+        std::lock_guard lock(p.bucketMutex);
+        p.perSecond = std::max(0.0, perSecond);
+        p.burst = std::max(1.0, burst);
+        p.tokens = p.burst;
+    }
+
+    uint64_t GetSuppressedTotal(Category category) {
+        return policyFor(category).suppressedTotal.load(std::memory_order_relaxed);
+    }
+
+    std::vector<std::pair<Category, uint64_t>> TakeSuppressedCounts() {
+        std::vector<std::pair<Category, uint64_t>> out;
+        auto &table = policies();
+        for (size_t i = 0; i < table.size(); ++i) {
+            if (const uint64_t n = table[i].suppressed.exchange(0, std::memory_order_relaxed); n > 0) {
+                out.emplace_back(static_cast<Category>(i), n);
+            }
+        }
+        return out;
+    }
+
+} // namespace Console
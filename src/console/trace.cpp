@@ -0,0 +1,223 @@
+#include "trace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <deque>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace Console {
+
+    namespace {
+        struct SpanRecord {
+                const char *name;
+                Category category;
+                uint32_t thread;
+                int64_t startUs; // since g_epoch
+                int64_t durationUs;
+                std::string detail;
+        };
+
+        // A thread's spans move to the shared store in batches of this many, and when it exits
+        constexpr size_t FLUSH_AT = 256;
+
+        std::atomic<bool> g_enabled {false};
+        const auto g_epoch = std::chrono::steady_clock::now();
+
+        struct ThreadBuffer;
+
+        struct TraceStore {
+                std::mutex mutex;
+                std::deque<SpanRecord> spans; // flushed by threads, oldest first
+                std::vector<ThreadBuffer *> threads;
+                std::atomic<uint32_t> nextThread {1};
+        };
+
+        // Never destroyed: detached workers can still finish spans while statics go away
+        TraceStore &traceStore() {
+            static auto *store = new TraceStore();
+            return *store;
+        }
+
+        void flush(std::vector<SpanRecord> &&spans) {
+            auto &store = traceStore();
+            std::lock_guard lock(store.mutex);
+            for (auto &span: spans) {
+                store.spans.push_back(std::move(span));
+            }
+            while (store.spans.size() > TRACE_CAPACITY) {
+                store.spans.pop_front();
+            }
+        }
+
+        // Lock order is the store's mutex before a buffer's own; a thread flushing its buffer lets
+        // go of its own mutex before calling flush()
+        struct ThreadBuffer {
+                std::mutex mutex;
+                std::vector<SpanRecord> spans;
+                const uint32_t id = traceStore().nextThread.fetch_add(1, std::memory_order_relaxed);
+
+                ThreadBuffer() {
+                    std::lock_guard lock(traceStore().mutex);
+                    traceStore().threads.push_back(this);
+                }
+
+                ~ThreadBuffer() {
+                    {
+                        std::lock_guard lock(traceStore().mutex);
+                        std::erase(traceStore().threads, this);
+                    }
+                    flush(std::move(spans));
+                }
+
+                void add(SpanRecord &&span) {
+                    std::vector<SpanRecord> full;
+                    {
+                        std::lock_guard lock(mutex);
+                        spans.push_back(std::move(span));
+                        if (spans.size() < FLUSH_AT) {
+                            return;
+                        }
+                        full.swap(spans);
+                    }
+                    flush(std::move(full));
+                }
+        };
+
+        ThreadBuffer &threadBuffer() {
+            thread_local ThreadBuffer buffer;
+            return buffer;
+        }
+
+        int64_t sinceEpochUs(std::chrono::steady_clock::time_point at) {
+            return std::chrono::duration_cast<std::chrono::microseconds>(at - g_epoch).count();
+        }
+
+        std::vector<SpanRecord> collect() {
+            auto &store = traceStore();
+            std::lock_guard lock(store.mutex);
+            std::vector<SpanRecord> out(store.spans.begin(), store.spans.end());
+            for (ThreadBuffer *buffer: store.threads) {
+                std::lock_guard bufferLock(buffer->mutex);
+                out.insert(out.end(), buffer->spans.begin(), buffer->spans.end());
+            }
+            return out;
+        }
+    } // namespace
+
+    void SetTracing(bool enabled) { g_enabled.store(enabled, std::memory_order_relaxed); }
+
+    bool IsTracing() { return g_enabled.load(std::memory_order_relaxed); }
+
+    void ConfigureTracingFromEnvironment() {
+        if (const char *trace = std::getenv("ALTMAN_TRACE"); trace && *trace && std::string_view(trace) != "0") {
+            SetTracing(true);
+        }
+    }
+
+    size_t TraceEventCount() {
+        auto &store = traceStore();
+        std::lock_guard lock(store.mutex);
+        size_t count = store.spans.size();
+        for (ThreadBuffer *buffer: store.threads) {
+            std::lock_guard bufferLock(buffer->mutex);
+            count += buffer->spans.size();
+        }
+        return count;
+    }
+
+    void ClearTrace() {
+        auto &store = traceStore();
+        std::lock_guard lock(store.mutex);
+        store.spans.clear();
+        for (ThreadBuffer *buffer: store.threads) {
+            std::lock_guard bufferLock(buffer->mutex);
+            buffer->spans.clear();
+        }
+    }
+
+    std::string TraceJson() {
+        auto events = nlohmann::json::array();
+        for (const auto &span: collect()) {
+            nlohmann::json event = {
+                {"name", span.name},
+                {"cat", CategoryName(span.category)},
+                {"ph", "X"},
+                {"pid", 1},
+                {"tid", span.thread},
+                {"ts", span.startUs},
+                {"dur", span.durationUs},
+            };
+            if (!span.detail.empty()) {
+                event["args"] = {{"detail", span.detail}};
+            }
+            events.push_back(std::move(event));
+        }
+        const nlohmann::json trace = {
+            {"traceEvents", std::move(events)},
+            {"displayTimeUnit", "ms"},
+        };
+        return trace.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+    }
+
+    std::filesystem::path WriteTrace(const std::filesystem::path &dir) {
+        const std::time_t now = std::time(nullptr);
+        std::tm local {};
+#ifdef _WIN32
+        localtime_s(&local, &now);
+#else
+        localtime_r(&now, &local);
+#endif
+        char stamp[32];
+        std::strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &local);
+
+        std::error_code ec;
+        std::filesystem::create_directories(dir, ec);
+        const auto path = dir / std::format("altman-trace-{}.json", stamp);
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            return {};
+        }
+        file << TraceJson();
+        return file ? path : std::filesystem::path {};
+    }
+
+    TraceSpan::TraceSpan(Category category, const char *name) noexcept
+        : m_category(category),
+          m_name(name),
+          m_active(g_enabled.load(std::memory_order_relaxed)) {
+        if (m_active) {
+            m_start = std::chrono::steady_clock::now();
+        }
+    }
+
+    TraceSpan::~TraceSpan() {
+        if (!m_active) {
+            return;
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - m_start;
+        auto &buffer = threadBuffer();
+        buffer.add({
+            m_name,
+            m_category,
+            buffer.id,
+            sinceEpochUs(m_start),
+            std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count(),
+            std::move(m_detail),
+        });
+    }
+
+    void TraceSpan::Detail(std::string_view detail) {
+        if (m_active) {
+            m_detail.assign(detail);
+        }
+    }
+
+} // namespace Console
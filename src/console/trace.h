@@ -0,0 +1,60 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "console.h"
+
+namespace Console {
+
+    // Span tracing in the Chrome trace event format, viewable in chrome://tracing or Perfetto.
+    // Spans are off until SetTracing(true) or ALTMAN_TRACE=1 at startup; while off a span is one
+    // relaxed atomic load. While on, each thread appends finished spans to its own buffer, so
+    // threads never contend with each other, only with a dump in progress.
+    void SetTracing(bool enabled);
+    bool IsTracing();
+    // Reads ALTMAN_TRACE; call once at startup
+    void ConfigureTracingFromEnvironment();
+
+    // Finished spans held for the next dump, at most TRACE_CAPACITY; the oldest go first
+    inline constexpr size_t TRACE_CAPACITY = 200000;
+    size_t TraceEventCount();
+    void ClearTrace();
+
+    // Every span held, as {"traceEvents": [...]} with one complete ("X") event per span
+    std::string TraceJson();
+    // Writes TraceJson() to a timestamped file in dir and returns its path, or an empty path on failure
+    std::filesystem::path WriteTrace(const std::filesystem::path &dir);
+
+    // Times its own lifetime. name must outlive the program (a string literal); detail is copied,
+    // and only when tracing is on.
+    class TraceSpan {
+        public:
+            TraceSpan(Category category, const char *name) noexcept;
+            ~TraceSpan();
+
+            TraceSpan(const TraceSpan &) = delete;
+            TraceSpan &operator=(const TraceSpan &) = delete;
+
+            // Shown as the span's "detail" argument, e.g. the URL or account it worked on
+            void Detail(std::string_view detail);
+
+        private:
+            Category m_category;
+            const char *m_name;
+            bool m_active;
+            std::chrono::steady_clock::time_point m_start {};
+            std::string m_detail;
+    };
+
+} // namespace Console
+
+#define CONSOLE_TRACE_CONCAT_(a, b) a##b
+#define CONSOLE_TRACE_CONCAT(a, b) CONSOLE_TRACE_CONCAT_(a, b)
+
+// TRACE_SPAN(Accounts, "refresh.presence") times the rest of the enclosing scope
+#define TRACE_SPAN(category, name)                                                                  \
+    Console::TraceSpan CONSOLE_TRACE_CONCAT(traceSpan_, __LINE__)(Console::Category::category, name)
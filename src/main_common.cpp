@@ -3,7 +3,10 @@
 #include "assets/fonts/embedded_rubik.h"
 
 #include <algorithm>
+#include <condition_variable>
 #include <fstream>
+#include <functional>
+#include <optional>
 
 void LoadImGuiFonts(float scaledFontSize) {
     ImGuiIO &io = ImGui::GetIO();
@@ -246,6 +249,79 @@ namespace AccountProcessor {
         return daysSinceUse > UNUSED_DAYS_THRESHOLD && daysSinceAttempt >= RETRY_DAYS_THRESHOLD;
     }
 
+    int refreshRateLimit(size_t accountCount) {
+        return static_cast<int>(std::clamp(static_cast<double>(accountCount) * 1.8, 30.0, 150.0));
+    }
+
+    // Workers that outlive a refresh cycle. Requests run on their thread's own connection cache, so an
+    // account refreshed on a worker reuses the connections the accounts before it opened, in this cycle
+    // and the next, instead of every account's thread resolving and handshaking from scratch.
+    class RefreshWorkers {
+        public:
+            static RefreshWorkers &instance() {
+                // Never destroyed: its threads are only joined by ShutdownManager
+                static auto *workers = new RefreshWorkers();
+                return *workers;
+            }
+
+            // Calls job(i) for every i below count on at most concurrency workers. Returns once all of
+            // them have run, or once shutdown has left the rest unrun and the running ones returned.
+            void forEach(size_t count, size_t concurrency, const std::function<void(size_t)> &job) {
+                std::lock_guard cycle(m_cycleMutex);
+                std::unique_lock lock(m_mutex);
+                while (m_threads < concurrency) {
+                    ++m_threads;
+                    WorkerThreads::runBackground([this] { work(); });
+                }
+                m_job = &job;
+                m_count = count;
+                m_next = 0;
+                m_unfinished = count;
+                m_limit = concurrency;
+                m_wake.notify_all();
+
+                while (m_busy > 0 || (m_unfinished > 0 && !ShutdownManager::instance().isShuttingDown())) {
+                    m_done.wait_for(lock, IDLE_WAIT);
+                }
+                m_job = nullptr;
+            }
+
+        private:
+            // How often idle workers look for shutdown, which does not notify them
+            static constexpr auto IDLE_WAIT = std::chrono::milliseconds(200);
+
+            void work() {
+                std::unique_lock lock(m_mutex);
+                while (!ShutdownManager::instance().isShuttingDown()) {
+                    if (!m_job || m_next >= m_count || m_busy >= m_limit) {
+                        m_wake.wait_for(lock, IDLE_WAIT);
+                        continue;
+                    }
+                    const auto *job = m_job;
+                    const size_t index = m_next++;
+                    ++m_busy;
+                    lock.unlock();
+                    (*job)(index);
+                    lock.lock();
+                    --m_busy;
+                    --m_unfinished;
+                    m_done.notify_all();
+                }
+            }
+
+            std::mutex m_cycleMutex; // one refresh at a time
+            std::mutex m_mutex;
+            std::condition_variable m_wake;
+            std::condition_variable m_done;
+            const std::function<void(size_t)> *m_job = nullptr;
+            size_t m_threads = 0;
+            size_t m_count = 0;
+            size_t m_next = 0;
+            size_t m_unfinished = 0;
+            size_t m_busy = 0;
+            size_t m_limit = 0;
+    };
+
 } // namespace AccountProcessor
 
 void refreshAccounts() {
@@ -255,85 +331,81 @@ void refreshAccounts() {
         return;
     }
 
-    // Phase 1: fetch per account info in parallel (ban/restriction/user/voice, no presence)
-    const int concurrencyLimit = std::clamp(static_cast<int>(snapshots.size()) / 5, 4, 30);
+    TRACE_SPAN(Accounts, "refresh");
+
+    // No deadline spans the cycle: with a large fleet most of it is spent queued in the RateLimiter,
+    // and a fleet-wide budget would fail the last accounts before they sent anything. A stalled
+    // connection is still cut off by its endpoint's budget, which starts once the request is let go.
+    HttpClient::PriorityScope priority(HttpClient::RequestPriority::Background);
 
-    std::mutex semMutex;
-    std::condition_variable semCv;
-    int semCount = 0;
+    // Phase 1: fetch per account info in parallel (ban/restriction/user/voice, no presence)
+    const auto concurrencyLimit = static_cast<size_t>(AccountProcessor::refreshRateLimit(snapshots.size()) / 5);
 
     using InfoEntry = std::pair<size_t, Roblox::FullAccountInfo>;
     using InfoResult = std::expected<InfoEntry, Roblox::ApiError>;
-    std::vector<std::future<InfoResult>> futures;
-    futures.reserve(snapshots.size());
+    // Accounts shutdown leaves unrefreshed keep this
+    std::vector<InfoResult> infoResults(snapshots.size(), std::unexpected(Roblox::ApiError::Cancelled));
+    std::optional<Console::TraceSpan> phaseSpan(std::in_place, Console::Category::Accounts, "refresh.account_info");
 
-    for (size_t i = 0; i < snapshots.size(); ++i) {
-        futures.push_back(std::async(std::launch::async, [&, i]() -> InfoResult {
-            const auto &snapshot = snapshots[i];
-
-            if (snapshot.cookie.empty())
-                return std::unexpected(Roblox::ApiError::InvalidInput);
-
-            {
-                std::unique_lock lock(semMutex);
-                semCv.wait(lock, [&] { return semCount < concurrencyLimit; });
-                ++semCount;
-            }
+    AccountProcessor::RefreshWorkers::instance().forEach(snapshots.size(), concurrencyLimit, [&](size_t i) {
+        const auto &snapshot = snapshots[i];
 
-            struct SemGuard {
-                std::mutex &m;
-                std::condition_variable &cv;
-                int &count;
-                ~SemGuard() {
-                    std::unique_lock lock(m);
-                    --count;
-                    cv.notify_one();
-                }
-            } guard { semMutex, semCv, semCount };
+        if (snapshot.cookie.empty()) {
+            infoResults[i] = std::unexpected(Roblox::ApiError::InvalidInput);
+            return;
+        }
 
-            auto result = Roblox::fetchFullAccountInfo(snapshot.cookie);
-            if (!result)
-                return std::unexpected(result.error());
-            return InfoEntry { i, std::move(*result) };
-        }));
-    }
+        HttpClient::PriorityScope accountPriority(HttpClient::RequestPriority::Background);
+        HttpClient::AccountScope accountScope(snapshot.id);
+        Console::TraceSpan span(Console::Category::Accounts, "refresh.account");
+        span.Detail(snapshot.username);
 
-    std::vector<InfoResult> infoResults;
-    infoResults.reserve(futures.size());
-    for (auto &f : futures) {
-        infoResults.push_back(f.get());
-    }
+        auto result = Roblox::fetchFullAccountInfo(snapshot.cookie);
+        if (!result) {
+            infoResults[i] = std::unexpected(result.error());
+            return;
+        }
+        infoResults[i] = InfoEntry {i, std::move(*result)};
+    });
+    phaseSpan.reset();
 
     // Phase 2: single batch presence call using first valid cookie
     // Then targeted per account followups only for InGame accounts with empty lastLocation
     std::vector<uint64_t> presenceUserIds;
-    std::string presenceCookie;
-    std::unordered_map<uint64_t, std::string> userCookies; // userId -> own cookie for followups
+    const AccountProcessor::AccountSnapshot *presenceAccount = nullptr;
+    // userId -> own account for followups
+    std::unordered_map<uint64_t, const AccountProcessor::AccountSnapshot *> userAccounts;
 
     for (const auto &entry : infoResults) {
         if (!entry) continue;
         const auto &info = entry->second;
         if (info.userId != 0 && info.banInfo.status == Roblox::BanCheckResult::Unbanned) {
+            const auto &snapshot = snapshots[entry->first];
             presenceUserIds.push_back(info.userId);
-            userCookies[info.userId] = snapshots[entry->first].cookie;
-            if (presenceCookie.empty())
-                presenceCookie = snapshots[entry->first].cookie;
+            userAccounts[info.userId] = &snapshot;
+            // The batch goes out as one account; prefer one without a proxy so it leaves direct
+            if (!presenceAccount || (!presenceAccount->proxy.empty() && snapshot.proxy.empty()))
+                presenceAccount = &snapshot;
         }
     }
 
     std::unordered_map<uint64_t, Roblox::PresenceData> presences;
-    if (!presenceUserIds.empty() && !presenceCookie.empty()) {
-        presences = Roblox::getPresences(presenceUserIds, presenceCookie);
+    if (!presenceUserIds.empty() && presenceAccount) {
+        TRACE_SPAN(Accounts, "refresh.presence");
+        HttpClient::AccountScope accountScope(presenceAccount->id);
+        presences = Roblox::getPresences(presenceUserIds, presenceAccount->cookie);
     }
 
     // Followup: for InGame accounts with empty lastLocation, fetch own presence using own cookie
+    phaseSpan.emplace(Console::Category::Accounts, "refresh.followups");
     for (auto &[userId, presence] : presences) {
         if (presence.presence == "InGame" && presence.lastLocation.empty()) {
-            auto cookieIt = userCookies.find(userId);
-            if (cookieIt != userCookies.end()) {
+            auto accountIt = userAccounts.find(userId);
+            if (accountIt != userAccounts.end()) {
                 // Invalidate cache first so getPresenceData hits the API with own cookie
                 Roblox::invalidatePresenceCache(userId);
-                if (auto own = Roblox::getPresenceData(cookieIt->second, userId)) {
+                HttpClient::AccountScope accountScope(accountIt->second->id);
+                if (auto own = Roblox::getPresenceData(accountIt->second->cookie, userId)) {
                     presence.lastLocation = own->lastLocation;
                     presence.placeId      = own->placeId;
                     presence.jobId        = own->jobId;
@@ -342,7 +414,10 @@ void refreshAccounts() {
         }
     }
 
+    phaseSpan.reset();
+
     // Phase 3: distribute presence into FullAccountInfo, then build ProcessResults
+    phaseSpan.emplace(Console::Category::Accounts, "refresh.process");
     std::vector<AccountProcessor::ProcessResult> results;
     results.reserve(snapshots.size());
 
@@ -396,9 +471,25 @@ void refreshAccounts() {
         results.push_back(std::move(result));
     }
 
+    phaseSpan.reset();
+
+    // Over the most recent requests, so mostly this cycle's: how much connection setup the workers avoided
+    const auto ttfb = HttpClient::ttfbSummary();
+    LOG_EVENT(
+        Accounts,
+        Info,
+        "refresh.connections",
+        {"accounts", snapshots.size()},
+        {"requests", ttfb.samples},
+        {"reused", ttfb.reused},
+        {"ttfb_median_ms", ttfb.medianMs},
+        {"setup_median_ms", ttfb.setupMedianMs}
+    );
+
     WorkerThreads::RunOnMain([results = std::move(results),
                              invalidIds = std::move(invalidIds),
                              invalidNames = std::move(invalidNames)]() mutable {
+        TRACE_SPAN(Accounts, "refresh.apply");
         AccountProcessor::applyResults(results);
         Data::SaveAccounts();
         LOG_INFO("Loaded accounts and refreshed statuses");
@@ -428,6 +519,7 @@ void startAccountRefreshLoop() {
 }
 
 void refreshAccountsCookies() {
+    HttpClient::PriorityScope priority(HttpClient::RequestPriority::Background);
     std::vector<AccountProcessor::AccountSnapshot> snapshots;
     {
         std::shared_lock lock(g_accountsMutex);
@@ -453,7 +545,10 @@ void refreshAccountsCookies() {
             Data::SaveAccounts();
         }
 
-        auto result = Roblox::refreshCookie(snapshot.cookie);
+        auto result = [&] {
+            HttpClient::AccountScope accountScope(snapshot.id);
+            return Roblox::refreshCookie(snapshot.cookie);
+        }();
 
         if (result) {
             std::string newCookie = std::move(*result);
@@ -465,6 +560,9 @@ void refreshAccountsCookies() {
                 if (it != g_accounts.end()) {
                     it->cookie = newCookie;
                     Roblox::invalidateCacheForCookie(it->cookie);
+                    if (!it->proxy.empty()) {
+                        HttpClient::setAccountProxy(it->id, it->proxy, it->cookie);
+                    }
                 }
                 Data::SaveAccounts();
                 LOG_INFO("Cookie refreshed and saved");
@@ -489,7 +587,7 @@ void configureRefreshConcurrency(size_t accountCount) {
     // Target: peak in flight ≈ concurrency × 3 requests (ban → restriction → voice), at ~60% of rate limit budget
     // Formula: rateLimit = clamp(accountCount * 1.8, 30, 150) concurrency = rateLimit / 5 (keeps peak at 60% of budget)
 
-    const int rateLimit = static_cast<int>(std::clamp(static_cast<double>(accountCount) * 1.8, 30.0, 150.0));
+    const int rateLimit = AccountProcessor::refreshRateLimit(accountCount);
     HttpClient::RateLimiter::instance().configure(rateLimit, std::chrono::seconds(g_rateLimitWindow));
     LOG_INFO("Refresh config: {} accounts with rate limit {}/{}s, concurrency {}, refresh interval {}min",
         accountCount, rateLimit, g_rateLimitWindow, rateLimit / 5, g_statusRefreshInterval);
@@ -504,11 +602,31 @@ void initializeAutoUpdater() {
 
 [[nodiscard]]
 bool initializeApp() {
+    Console::StartLogger();
+
     if (auto result = Crypto::initialize(); !result) {
         std::println("Failed to initialize crypto library {}", Crypto::errorToString(result.error()));
         return false;
     }
 
+    // Record or replay API traffic when ALTMAN_HTTP_MODE asks for it; has to come before any request
+    HttpClient::configureTransportFromEnvironment();
+    Console::ConfigureTracingFromEnvironment();
+
+    // Connect to the hosts the first refresh talks to while the JSON files load, instead of having
+    // every refresh thread resolve and handshake at once afterwards
+    const auto started = std::chrono::steady_clock::now();
+    std::optional<Console::TraceSpan> loadSpan(std::in_place, Console::Category::General, "startup.load");
+    auto prewarm = HttpClient::prewarm({
+        "users.roblox.com",
+        "presence.roblox.com",
+        "auth.roblox.com",
+        "friends.roblox.com",
+        "games.roblox.com",
+        "thumbnails.roblox.com",
+        "apis.roblox.com",
+    });
+
     Data::LoadSettings("settings.json");
 
     if (g_checkUpdatesOnStartup) {
@@ -521,6 +639,23 @@ bool initializeApp() {
     Data::LoadPrivateServerHistory("private_server_history.json");
     Data::LoadAccountGroups("account_groups.json");
 
+    for (const auto &account: g_accounts) {
+        if (!account.proxy.empty()) {
+            HttpClient::setAccountProxy(account.id, account.proxy, account.cookie);
+        }
+    }
+
+    const auto loadMs
+        = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started).count();
+    loadSpan.reset();
+
+    // Give handshakes still in flight a moment so the refresh reuses them; never hold startup for long
+    const bool warm = [&prewarm] {
+        TRACE_SPAN(General, "startup.prewarm_wait");
+        return prewarm.wait_for(std::chrono::milliseconds(750)) == std::future_status::ready;
+    }();
+    LOG_EVENT(General, Info, "startup.load", {"ms", loadMs}, {"prewarmed", warm});
+
     configureRefreshConcurrency(g_accounts.size());
     startAccountRefreshLoop();
     checkAndRefreshCookiesOnce();
@@ -18,7 +18,9 @@
 
 #include "components/data.h"
 #include "console/console.h"
+#include "console/trace.h"
 #include "image.h"
+#include "network/http_transport.h"
 #include "network/roblox/auth.h"
 #include "network/roblox/common.h"
 #include "network/roblox/games.h"
@@ -108,6 +108,7 @@ void OpenFileOrFolder(const std::filesystem::path &path) {
     ShutdownManager::instance().requestShutdown();
     ClientUpdateChecker::UpdateChecker::Shutdown();
     ShutdownManager::instance().waitForShutdown();
+    Console::StopLogger();
 }
 @end
 
@@ -421,6 +421,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int nCmdShow) {
 
     ShutdownManager::instance().requestShutdown();
     ShutdownManager::instance().waitForShutdown();
+    Console::StopLogger();
 
     ImGui_ImplDX11_Shutdown();
     ImGui_ImplWin32_Shutdown();
@@ -1,22 +1,607 @@
 #include "http.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <charconv>
 #include <chrono>
+#include <condition_variable>
 #include <filesystem>
 #include <format>
 #include <fstream>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
 #include <sstream>
 #include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
 
 #include <cpr/cpr.h>
+#include <curl/curl.h>
 #include <nlohmann/json.hpp>
 
 #include "console/console.h"
+#include "console/trace.h"
+#include "network/http_transport.h"
+#include "utils/shutdown_manager.h"
+#include "utils/worker_thread.h"
 
 namespace HttpClient {
 
+    namespace {
+        constexpr size_t LATENCY_SAMPLES = 64;
+
+        // The endpoint's most recent answered requests, for hedging decisions. Long-run latency is
+        // in the endpoint's histogram (see http_metrics.h); this only has to track the present.
+        struct RecentLatency {
+                std::array<float, LATENCY_SAMPLES> samplesMs {};
+                size_t count = 0;
+        };
+
+        // Retries and hedges a host may still send, in tenths. Each request earns a tenth of one and
+        // each retry or hedge spends a whole one, so extra traffic stays near 10% of real traffic
+        // during an outage while a burst of failures after a quiet spell can still draw on the cap.
+        constexpr int RETRY_TENTHS_PER_REQUEST = 1;
+        constexpr int RETRY_TENTHS_PER_RETRY = 10;
+        constexpr int RETRY_TENTHS_MAX = 100;
+
+        // One budget per host, found without a lock in the way http_metrics.cpp finds an endpoint's
+        // counters: a slot is claimed by swapping its host's hash in from zero and never given back.
+        // Hosts are told apart by hash alone; two that collide share a budget, which only costs
+        // accuracy. Past MAX_RETRY_HOSTS the rest share the overflow budget.
+        struct RetryBudget {
+                std::atomic<size_t> hash {0};
+                std::atomic<int> tenths {RETRY_TENTHS_MAX};
+        };
+
+        constexpr size_t MAX_RETRY_HOSTS = 64;
+
+        std::array<RetryBudget, MAX_RETRY_HOSTS> g_retryBudgets;
+        RetryBudget g_retryOverflow;
+
+        std::mutex g_transferMutex;
+        std::unordered_map<std::string, RecentLatency> g_recentLatency;
+
+        // host/path with numeric path segments folded, so /v1/games/123/servers/Public is one endpoint
+        std::string endpointKey(std::string_view url) {
+            if (const size_t scheme = url.find("://"); scheme != std::string_view::npos) {
+                url.remove_prefix(scheme + 3);
+            }
+            url = url.substr(0, url.find_first_of("?#"));
+
+            std::string key;
+            key.reserve(url.size());
+            size_t start = 0;
+            while (start <= url.size()) {
+                const size_t slash = url.find('/', start);
+                const std::string_view segment = url.substr(start, slash - start);
+                if (!key.empty()) {
+                    key.push_back('/');
+                }
+                const bool numeric = !segment.empty() && std::ranges::all_of(segment, [](char c) {
+                    return std::isdigit(static_cast<unsigned char>(c));
+                });
+                key.append(numeric ? std::string_view("{id}") : segment);
+                if (slash == std::string_view::npos) {
+                    break;
+                }
+                start = slash + 1;
+            }
+            return key;
+        }
+
+        std::string_view hostOf(std::string_view url) {
+            if (const size_t scheme = url.find("://"); scheme != std::string_view::npos) {
+                url.remove_prefix(scheme + 3);
+            }
+            return url.substr(0, url.find_first_of("/:?#"));
+        }
+
+        // url may also be an endpoint key, which starts with the host too
+        RetryBudget &retryBudget(std::string_view url) {
+            // Zero marks a free slot
+            const size_t hash = std::hash<std::string_view> {}(hostOf(url)) | 1;
+            for (size_t probe = 0; probe < MAX_RETRY_HOSTS; ++probe) {
+                RetryBudget &budget = g_retryBudgets[(hash + probe) % MAX_RETRY_HOSTS];
+                size_t seen = budget.hash.load(std::memory_order_acquire);
+                if (seen == 0 && budget.hash.compare_exchange_strong(seen, hash, std::memory_order_acq_rel)) {
+                    return budget;
+                }
+                // Lost the race or taken before; seen holds the claimant's hash either way
+                if (seen == hash) {
+                    return budget;
+                }
+            }
+            return g_retryOverflow;
+        }
+
+        void recordTransfer(const std::string &key, uint64_t wireBytes, uint64_t decodedBytes) {
+            Metrics::recordTransfer(key, wireBytes, decodedBytes);
+
+            auto &tenths = retryBudget(key).tenths;
+            int current = tenths.load(std::memory_order_relaxed);
+            while (current < RETRY_TENTHS_MAX
+                   && !tenths.compare_exchange_weak(
+                       current,
+                       std::min(RETRY_TENTHS_MAX, current + RETRY_TENTHS_PER_REQUEST),
+                       std::memory_order_relaxed
+                   )) {
+            }
+        }
+
+        void recordLatency(const std::string &key, double ms) {
+            std::lock_guard lock(g_transferMutex);
+            auto &recent = g_recentLatency[key];
+            recent.samplesMs[recent.count++ % LATENCY_SAMPLES] = static_cast<float>(ms);
+        }
+
+        // Spends one of the host's retry tokens; the caller counts the retry or hedge
+        bool takeRetryToken(std::string_view url) {
+            auto &tenths = retryBudget(url).tenths;
+            int current = tenths.load(std::memory_order_relaxed);
+            while (current >= RETRY_TENTHS_PER_RETRY) {
+                const int left = current - RETRY_TENTHS_PER_RETRY;
+                if (tenths.compare_exchange_weak(current, left, std::memory_order_relaxed)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // How long a GET to the endpoint has to be outstanding before a duplicate is worth sending:
+        // its p95 over recent requests, once there are enough of them to say
+        std::optional<std::chrono::milliseconds> hedgeDelay(const std::string &key) {
+            constexpr size_t MIN_SAMPLES = 20;
+
+            std::array<float, LATENCY_SAMPLES> samples {};
+            size_t count = 0;
+            {
+                std::lock_guard lock(g_transferMutex);
+                const auto it = g_recentLatency.find(key);
+                if (it == g_recentLatency.end() || it->second.count < MIN_SAMPLES) {
+                    return std::nullopt;
+                }
+                samples = it->second.samplesMs;
+                count = std::min(it->second.count, LATENCY_SAMPLES);
+            }
+
+            const auto p95 = samples.begin() + static_cast<std::ptrdiff_t>(count * 95 / 100);
+            std::nth_element(samples.begin(), p95, samples.begin() + static_cast<std::ptrdiff_t>(count));
+            return std::chrono::milliseconds(std::max(50L, static_cast<long>(*p95)));
+        }
+
+        int64_t millisecondsSince(std::chrono::steady_clock::time_point start) {
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            return std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+        }
+
+        constexpr size_t TTFB_SAMPLES = 1024;
+
+        struct TtfbSample {
+                double ttfbMs = 0.0;
+                double setupMs = 0.0; // DNS, connect and TLS; 0 when the transfer reused a connection
+                bool reused = false;
+        };
+
+        std::mutex g_ttfbMutex;
+        std::vector<TtfbSample> g_ttfbMs; // ring of the most recent samples
+        size_t g_ttfbNext = 0;
+
+        void recordTtfb(const TtfbSample &sample) {
+            std::lock_guard lock(g_ttfbMutex);
+            if (g_ttfbMs.size() < TTFB_SAMPLES) {
+                g_ttfbMs.push_back(sample);
+            } else {
+                g_ttfbMs[g_ttfbNext] = sample;
+                g_ttfbNext = (g_ttfbNext + 1) % TTFB_SAMPLES;
+            }
+        }
+
+        // One share handle per egress (direct, or one proxy): resolved addresses and TLS session
+        // tickets found by one worker are reused by the others, so a burst of refresh threads after
+        // an idle spell does not resolve and run a full handshake once per thread. Connections are
+        // not shared here: libcurl does not support one connection cache used by concurrent
+        // threads, so each thread keeps its own (see performOnThread). curl calls back into
+        // lock()/unlock() around every access to a shared part, one mutex per kind of data.
+        class CurlShare {
+            public:
+                static CurlShare &instance() { return forEgress({}); }
+
+                static CurlShare &forEgress(const std::string &proxy) {
+                    // Never destroyed: detached workers can still be mid-transfer while statics go away
+                    static auto *mutex = new std::mutex();
+                    static auto *shares = new std::unordered_map<std::string, CurlShare *>();
+                    std::lock_guard lock(*mutex);
+                    auto &share = (*shares)[proxy];
+                    if (!share) {
+                        share = new CurlShare();
+                    }
+                    return *share;
+                }
+
+                void attach(cpr::Session &session) {
+                    CURL *handle = session.GetCurlHolder()->handle;
+                    if (m_handle) {
+                        curl_easy_setopt(handle, CURLOPT_SHARE, m_handle);
+                    }
+                    // Keep resolved hosts across the gap between refresh cycles (curl's default is 60s)
+                    curl_easy_setopt(handle, CURLOPT_DNS_CACHE_TIMEOUT, 600L);
+                    curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+                }
+
+            private:
+                CurlShare() {
+                    m_handle = curl_share_init();
+                    if (!m_handle) {
+                        LOG_CAT_WARN(Network, "curl_share_init failed; requests will not share DNS or TLS state");
+                        return;
+                    }
+                    curl_share_setopt(m_handle, CURLSHOPT_LOCKFUNC, &CurlShare::lock);
+                    curl_share_setopt(m_handle, CURLSHOPT_UNLOCKFUNC, &CurlShare::unlock);
+                    curl_share_setopt(m_handle, CURLSHOPT_USERDATA, this);
+                    curl_share_setopt(m_handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+                    curl_share_setopt(m_handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+                }
+
+                static void lock(CURL *, curl_lock_data data, curl_lock_access, void *user) {
+                    static_cast<CurlShare *>(user)->m_locks[data].lock();
+                }
+
+                static void unlock(CURL *, curl_lock_data data, void *user) {
+                    static_cast<CurlShare *>(user)->m_locks[data].unlock();
+                }
+
+                CURLSH *m_handle = nullptr;
+                std::array<std::mutex, CURL_LOCK_DATA_LAST> m_locks;
+        };
+
+        // Runs the transfer through this thread's own multi handle. Its connection cache outlives the
+        // session, so consecutive requests from one worker reuse a connection, and no other thread
+        // ever touches it. curl only reuses a connection for a request with the same proxy settings.
+        cpr::Response performOnThread(std::shared_ptr<cpr::Session> session, cpr::MultiPerform::HttpMethod method) {
+            thread_local cpr::MultiPerform multi;
+            multi.AddSession(session, method);
+            std::vector<cpr::Response> responses = multi.Perform();
+            multi.RemoveSession(session);
+            return responses.empty() ? cpr::Response {} : std::move(responses.front());
+        }
+
+        void finishTransfer(cpr::Session &session) {
+            CURL *handle = session.GetCurlHolder()->handle;
+            curl_off_t startTransferUs = 0;
+            if (curl_easy_getinfo(handle, CURLINFO_STARTTRANSFER_TIME_T, &startTransferUs) != CURLE_OK
+                || startTransferUs <= 0) {
+                return;
+            }
+            long newConnections = 0;
+            curl_off_t connectUs = 0;
+            curl_off_t appConnectUs = 0;
+            curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &newConnections);
+            curl_easy_getinfo(handle, CURLINFO_CONNECT_TIME_T, &connectUs);
+            curl_easy_getinfo(handle, CURLINFO_APPCONNECT_TIME_T, &appConnectUs);
+
+            TtfbSample sample;
+            sample.ttfbMs = static_cast<double>(startTransferUs) / 1000.0;
+            sample.reused = newConnections == 0;
+            if (!sample.reused) {
+                sample.setupMs = static_cast<double>(std::max(connectUs, appConnectUs)) / 1000.0;
+            }
+            recordTtfb(sample);
+        }
+
+        TransportError transportError(const cpr::Error &error) {
+            switch (error.code) {
+                case cpr::ErrorCode::OK: return TransportError::None;
+                case cpr::ErrorCode::OPERATION_TIMEDOUT: return TransportError::Timeout;
+                case cpr::ErrorCode::ABORTED_BY_CALLBACK:
+                    // Our progress callback aborted it: shutdown, the caller's CancelScope or the deadline
+                    return ShutdownManager::instance().isShuttingDown() || cancellationRequested()
+                               ? TransportError::Cancelled
+                               : TransportError::Timeout;
+                // Also what perform() answers with when the account's proxy is down or its cookie
+                // turned up outside its AccountScope; the request must not leave any other way
+                case cpr::ErrorCode::COULDNT_RESOLVE_PROXY: return TransportError::EgressUnavailable;
+                case cpr::ErrorCode::COULDNT_CONNECT:
+                case cpr::ErrorCode::COULDNT_RESOLVE_HOST:
+                case cpr::ErrorCode::SSL_CONNECT_ERROR: return TransportError::ConnectionFailed;
+                default: return TransportError::Other;
+            }
+        }
+
+        // user:pass@ removed, for logs and the console
+        std::string redactProxy(std::string_view proxy) {
+            const size_t scheme = proxy.find("://");
+            const size_t start = scheme == std::string_view::npos ? 0 : scheme + 3;
+            const size_t at = proxy.find('@', start);
+            if (at == std::string_view::npos) {
+                return std::string(proxy);
+            }
+            return std::string(proxy.substr(0, start)).append(proxy.substr(at + 1));
+        }
+
+        // Which proxy each account's requests leave through, and whether each proxy is usable
+        class EgressTable {
+            public:
+                static EgressTable &instance() {
+                    static auto *table = new EgressTable();
+                    return *table;
+                }
+
+                void assign(int accountId, std::string proxy, std::string_view cookie) {
+                    std::lock_guard lock(m_mutex);
+                    std::erase_if(m_owners, [&](const auto &owner) { return owner.second == accountId; });
+                    if (proxy.empty()) {
+                        m_assigned.erase(accountId);
+                    } else {
+                        m_proxies.try_emplace(proxy);
+                        m_assigned[accountId] = std::move(proxy);
+                        if (!cookie.empty()) {
+                            m_owners[std::hash<std::string_view> {}(cookie)] = accountId;
+                        }
+                    }
+                    std::erase_if(m_proxies, [&](const auto &entry) {
+                        return std::ranges::none_of(m_assigned, [&](const auto &a) { return a.second == entry.first; });
+                    });
+                }
+
+                // The account's proxy, empty for direct. Requests stay on it even while it is down:
+                // sending them anywhere else would show Roblox an address the account never used.
+                std::string route(int accountId) const {
+                    std::lock_guard lock(m_mutex);
+                    const auto assigned = m_assigned.find(accountId);
+                    return assigned == m_assigned.end() ? std::string() : assigned->second;
+                }
+
+                // The proxied account whose .ROBLOSECURITY the headers carry, or 0
+                int ownerOf(const cpr::Header &hdr) const {
+                    const auto header = hdr.find("Cookie");
+                    if (header == hdr.end()) {
+                        return 0;
+                    }
+                    constexpr std::string_view NAME = ".ROBLOSECURITY=";
+                    const std::string_view cookies = header->second;
+                    const size_t start = cookies.find(NAME);
+                    if (start == std::string_view::npos) {
+                        return 0;
+                    }
+                    std::string_view value = cookies.substr(start + NAME.size());
+                    value = value.substr(0, value.find(';'));
+
+                    std::lock_guard lock(m_mutex);
+                    if (m_owners.empty()) {
+                        return 0;
+                    }
+                    const auto owner = m_owners.find(std::hash<std::string_view> {}(value));
+                    return owner == m_owners.end() ? 0 : owner->second;
+                }
+
+                bool healthy(const std::string &proxy) const {
+                    std::lock_guard lock(m_mutex);
+                    const auto it = m_proxies.find(proxy);
+                    return it == m_proxies.end() || it->second.healthy;
+                }
+
+                // connected is false when the proxy itself could not be reached or set up the tunnel
+                void report(const std::string &proxy, bool connected) {
+                    std::lock_guard lock(m_mutex);
+                    const auto it = m_proxies.find(proxy);
+                    if (it == m_proxies.end()) {
+                        return;
+                    }
+                    auto &state = it->second;
+                    ++state.requests;
+                    if (connected) {
+                        state.consecutiveFailures = 0;
+                        return;
+                    }
+                    ++state.failures;
+                    if (++state.consecutiveFailures >= FAILURES_BEFORE_DOWN && state.healthy) {
+                        state.healthy = false;
+                        LOG_EVENT(Network, Warn, "net.proxy_down", {"proxy", redactProxy(proxy)});
+                        WorkerThreads::runBackground([proxy] { EgressTable::instance().probe(proxy); });
+                    }
+                }
+
+                std::vector<ProxyStatus> status() const {
+                    std::lock_guard lock(m_mutex);
+                    std::vector<ProxyStatus> out;
+                    out.reserve(m_proxies.size());
+                    for (const auto &[proxy, state]: m_proxies) {
+                        const auto accounts = std::ranges::count_if(m_assigned, [&](const auto &a) {
+                            return a.second == proxy;
+                        });
+                        out.push_back({
+                            redactProxy(proxy),
+                            static_cast<size_t>(accounts),
+                            state.healthy,
+                            state.requests,
+                            state.failures,
+                        });
+                    }
+                    return out;
+                }
+
+            private:
+                static constexpr int FAILURES_BEFORE_DOWN = 3;
+
+                struct ProxyState {
+                        bool healthy = true;
+                        int consecutiveFailures = 0;
+                        uint64_t requests = 0;
+                        uint64_t failures = 0;
+                };
+
+                // Runs on its own thread while proxy is down: a bodiless request through it every
+                // cooldown, backing off to five minutes, until one gets an answer
+                void probe(const std::string &proxy) {
+                    auto cooldown = std::chrono::seconds(15);
+                    while (!ShutdownManager::instance().sleepFor(cooldown)) {
+                        {
+                            std::lock_guard lock(m_mutex);
+                            if (!m_proxies.contains(proxy)) {
+                                return;
+                            }
+                        }
+
+                        cpr::Session session;
+                        session.SetUrl(cpr::Url {"https://www.roblox.com/"});
+                        session.SetProxies(cpr::Proxies {{"http", proxy}, {"https", proxy}});
+                        session.SetRedirect(cpr::Redirect(0L));
+                        session.SetTimeout(cpr::Timeout {std::chrono::seconds(10)});
+                        CurlShare::forEgress(proxy).attach(session);
+                        const cpr::Response r = session.Head();
+
+                        if (r.status_code > 0) {
+                            std::lock_guard lock(m_mutex);
+                            if (const auto it = m_proxies.find(proxy); it != m_proxies.end()) {
+                                it->second.healthy = true;
+                                it->second.consecutiveFailures = 0;
+                            }
+                            LOG_EVENT(Network, Info, "net.proxy_up", {"proxy", redactProxy(proxy)});
+                            return;
+                        }
+                        cooldown = std::min<std::chrono::seconds>(cooldown * 2, std::chrono::minutes(5));
+                    }
+                }
+
+                mutable std::mutex m_mutex;
+                std::unordered_map<int, std::string> m_assigned; // account id -> proxy
+                std::unordered_map<size_t, int> m_owners;         // hash of a proxied account's cookie -> id
+                std::map<std::string, ProxyState> m_proxies;
+        };
+
+        // The status code, body and header block are moved out of cpr's response rather than copied
+        Response toResponse(cpr::Response &&r, const std::string &key) {
+            recordTransfer(key, static_cast<uint64_t>(r.downloaded_bytes), r.text.size());
+            Response out {
+                static_cast<int>(r.status_code),
+                std::move(r.text),
+                Headers(std::move(r.raw_header)),
+                r.url.str(),
+            };
+            out.transport = transportError(r.error);
+            return out;
+        }
+    } // namespace
+
+    void resetTransferStats() {
+        {
+            std::lock_guard lock(g_transferMutex);
+            g_recentLatency.clear();
+        }
+        for (auto &budget: g_retryBudgets) {
+            budget.tenths.store(RETRY_TENTHS_MAX, std::memory_order_relaxed);
+        }
+        g_retryOverflow.tenths.store(RETRY_TENTHS_MAX, std::memory_order_relaxed);
+        Metrics::reset();
+        std::lock_guard lock(g_ttfbMutex);
+        g_ttfbMs.clear();
+        g_ttfbNext = 0;
+    }
+
+    TtfbSummary ttfbSummary() {
+        std::vector<double> samples;
+        std::vector<double> setups;
+        {
+            std::lock_guard lock(g_ttfbMutex);
+            samples.reserve(g_ttfbMs.size());
+            for (const auto &sample: g_ttfbMs) {
+                samples.push_back(sample.ttfbMs);
+                if (!sample.reused) {
+                    setups.push_back(sample.setupMs);
+                }
+            }
+        }
+
+        TtfbSummary summary;
+        summary.samples = samples.size();
+        summary.reused = samples.size() - setups.size();
+        if (samples.empty()) {
+            return summary;
+        }
+        auto percentile = [](std::vector<double> &values, double p) {
+            const auto rank = static_cast<size_t>(p * static_cast<double>(values.size()));
+            const size_t index = std::min(values.size() - 1, rank);
+            std::ranges::nth_element(values, values.begin() + static_cast<std::ptrdiff_t>(index));
+            return values[index];
+        };
+        summary.medianMs = percentile(samples, 0.5);
+        summary.p99Ms = percentile(samples, 0.99);
+        if (!setups.empty()) {
+            summary.setupMedianMs = percentile(setups, 0.5);
+        }
+        return summary;
+    }
+
+    std::future<void> prewarm(std::vector<std::string> hosts) {
+        // A promise rather than std::async, whose future would block in its destructor
+        auto done = std::make_shared<std::promise<void>>();
+        auto future = done->get_future();
+        if (const Transport *transport = activeTransport(); transport && transport->offline()) {
+            done->set_value();
+            return future;
+        }
+
+        WorkerThreads::runBackground([done, hosts = std::move(hosts)] {
+            TRACE_SPAN(Network, "net.prewarm");
+            const auto started = std::chrono::steady_clock::now();
+            std::atomic<size_t> warmed {0};
+
+            std::vector<std::future<void>> pending;
+            pending.reserve(hosts.size());
+            for (const auto &host: hosts) {
+                pending.push_back(std::async(std::launch::async, [&host, &warmed] {
+                    const auto hostStarted = std::chrono::steady_clock::now();
+
+                    // Only the lookup and the TLS session matter; both stay in the shared cache, so the first
+                    // real request from any thread skips DNS and resumes the session instead of a full handshake
+                    cpr::Session session;
+                    session.SetUrl(cpr::Url {"https://" + host + "/"});
+                    session.SetRedirect(cpr::Redirect(0L));
+                    session.SetTimeout(cpr::Timeout {std::chrono::seconds(5)});
+                    CurlShare::instance().attach(session);
+                    const cpr::Response r = session.Head();
+                    finishTransfer(session);
+
+                    const bool ok = r.error.code == cpr::ErrorCode::OK;
+                    if (ok) {
+                        ++warmed;
+                    }
+                    LOG_EVENT(
+                        Network,
+                        Debug,
+                        "net.prewarm_host",
+                        {"host", host},
+                        {"ok", ok},
+                        {"ms", millisecondsSince(hostStarted)}
+                    );
+                }));
+            }
+            for (auto &p: pending) {
+                p.wait();
+            }
+
+            LOG_EVENT(
+                Network,
+                Info,
+                "net.prewarm",
+                {"hosts", hosts.size()},
+                {"warmed", warmed.load()},
+                {"ms", millisecondsSince(started)}
+            );
+            done->set_value();
+        });
+        return future;
+    }
+
     nlohmann::json decode(const Response &response) {
         if (response.text.empty()) {
-            LOG_ERROR("Cannot decode empty response");
+            LOG_CAT_ERROR(Network, "Cannot decode empty response");
             return nlohmann::json::object();
         }
 
@@ -24,7 +609,7 @@ namespace HttpClient {
         try {
             result = nlohmann::json::parse(response.text);
         } catch (const std::exception &e) {
-            LOG_ERROR("Failed to parse JSON response: {}", e.what());
+            LOG_CAT_ERROR(Network, "Failed to parse JSON response: {}", e.what());
             return nlohmann::json::object();
         }
 
@@ -76,6 +661,424 @@ namespace HttpClient {
     }
 
     namespace {
+        enum class Method {
+            Get,
+            Post,
+            Patch
+        };
+
+        using namespace std::chrono_literals;
+
+        constexpr auto CONNECT_TIMEOUT = 5s;
+        constexpr auto DEFAULT_BUDGET = 20s;
+
+        struct EndpointPolicy {
+                std::string_view host;
+                std::chrono::milliseconds budget;
+                bool hedge = false; // GETs that outlast the endpoint's p95 get a duplicate sent
+        };
+
+        // Whole-request budgets by host. Presence and thumbnails sit on the refresh and render paths
+        // where a late answer is worth little; auth covers ticket and cookie flows that may be slow.
+        // Hedging is limited to the read-heavy hosts behind server lists, avatars and friend lists.
+        constexpr EndpointPolicy ENDPOINT_POLICIES[] = {
+            {"presence.roblox.com",   8s,  false},
+            {"thumbnails.roblox.com", 10s, true },
+            {"users.roblox.com",      10s, true },
+            {"friends.roblox.com",    15s, true },
+            {"games.roblox.com",      15s, true },
+            {"apis.roblox.com",       15s, false},
+            {"auth.roblox.com",       20s, false},
+        };
+
+        EndpointPolicy endpointPolicy(std::string_view url) {
+            const std::string_view host = hostOf(url);
+            for (const auto &entry: ENDPOINT_POLICIES) {
+                if (host == entry.host) {
+                    return entry;
+                }
+            }
+            return {host, DEFAULT_BUDGET};
+        }
+
+        thread_local DeadlineScope::Clock::time_point t_deadline = DeadlineScope::Clock::time_point::max();
+        thread_local RequestPriority t_priority = RequestPriority::Interactive;
+        thread_local int t_account = 0;
+        thread_local const std::atomic<bool> *t_cancel = nullptr;
+        // Set by LimiterWaitScope; perform() takes it once and passes it on from there
+        thread_local std::chrono::microseconds t_limiterWait {0};
+
+        std::string currentEgress() { return EgressTable::instance().route(t_account); }
+
+        std::string_view methodName(Method method) {
+            switch (method) {
+                case Method::Get: return "GET";
+                case Method::Post: return "POST";
+                case Method::Patch: return "PATCH";
+            }
+            return "GET";
+        }
+
+        // The request as the installed transport sees it, built only when one is installed
+        TransportRequest transportRequest(
+            Method method,
+            const std::string &url,
+            const std::string &key,
+            const cpr::Parameters &params,
+            const std::optional<std::string> &body
+        ) {
+            TransportRequest request {std::string(methodName(method)), url, key, body.value_or("")};
+            if (std::string query = params.GetContent(cpr::CurlHolder {}); !query.empty()) {
+                request.url += '?';
+                request.url += query;
+            }
+            return request;
+        }
+
+        // Counts one attempt against its endpoint, whether the network or a transport answered it
+        void recordAttempt(
+            const std::string &key,
+            const cpr::Response &r,
+            uint64_t sentBytes,
+            std::chrono::microseconds limiterWait
+        ) {
+            const auto elapsed = std::chrono::duration<double>(r.elapsed);
+            Metrics::recordRequest(
+                key,
+                static_cast<int>(r.status_code),
+                std::chrono::duration_cast<std::chrono::microseconds>(elapsed),
+                sentBytes,
+                limiterWait
+            );
+            if (r.status_code > 0) {
+                recordLatency(key, r.elapsed * 1000.0);
+            }
+        }
+
+        // Every API request goes through here. It asks for gzip or deflate explicitly, which every curl
+        // built against zlib decodes, so JSON comes back compressed and is inflated transparently.
+        // key is endpointKey(url), worked out once by the caller; limiterWait is charged to this attempt.
+        cpr::Response perform(
+            Method method,
+            const std::string &url,
+            const std::string &key,
+            std::chrono::microseconds limiterWait,
+            const cpr::Header &hdr,
+            const cpr::Parameters &params,
+            std::optional<std::string> body,
+            bool follow_redirects,
+            int max_redirects,
+            const cpr::WriteCallback *write = nullptr,
+            const std::atomic<bool> *abandon = nullptr
+        ) {
+            Console::TraceSpan span(Console::Category::Network, "http.request");
+            span.Detail(url);
+
+            using Clock = DeadlineScope::Clock;
+            const Clock::time_point deadline = t_deadline;
+            const std::atomic<bool> *cancel = t_cancel;
+            if (cancel && cancel->load(std::memory_order_relaxed)) {
+                cpr::Response cancelled;
+                cancelled.url = cpr::Url {url};
+                cancelled.error.code = cpr::ErrorCode::ABORTED_BY_CALLBACK;
+                cancelled.error.message = "cancelled before the request started";
+                return cancelled;
+            }
+            auto budget = endpointPolicy(url).budget;
+            if (deadline != Clock::time_point::max()) {
+                const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now());
+                if (left <= 0ms) {
+                    cpr::Response expired;
+                    expired.url = cpr::Url {url};
+                    expired.error.code = cpr::ErrorCode::OPERATION_TIMEDOUT;
+                    expired.error.message = "deadline exceeded before the request started";
+                    return expired;
+                }
+                budget = std::min(budget, left);
+            }
+
+            Transport *transport = activeTransport();
+            std::optional<TransportRequest> seen;
+            if (transport) {
+                seen = transportRequest(method, url, key, params, body);
+                // The transport sees the same budget curl would get, as its deadline
+                std::optional<cpr::Response> replayed;
+                {
+                    DeadlineScope scope(Clock::now() + budget);
+                    replayed = transport->intercept(*seen);
+                }
+                if (replayed) {
+                    if (write && replayed->status_code > 0) {
+                        (*write)(replayed->text);
+                        replayed->text.clear();
+                    }
+                    recordAttempt(key, *replayed, seen->body.size(), limiterWait);
+                    return std::move(*replayed);
+                }
+            }
+
+            // A proxied account's cookie only leaves through its proxy. A call site that sends it
+            // without the account's AccountScope would route it direct, so it is refused instead.
+            const auto egressRefused = [&](std::string message) {
+                cpr::Response r;
+                r.url = cpr::Url {url};
+                r.error.code = cpr::ErrorCode::COULDNT_RESOLVE_PROXY;
+                r.error.message = std::move(message);
+                recordAttempt(key, r, 0, limiterWait);
+                return r;
+            };
+            if (const int owner = EgressTable::instance().ownerOf(hdr); owner != 0 && owner != t_account) {
+                LOG_EVENT(
+                    Network, Error, "net.egress_unscoped", {"account", owner}, {"scope", t_account}, {"endpoint", key}
+                );
+                return egressRefused(std::format("account {}'s cookie sent outside its AccountScope", owner));
+            }
+
+            // Fail closed while the account's proxy is down, until the probe sees it answer again
+            const std::string proxy = currentEgress();
+            if (!proxy.empty() && !EgressTable::instance().healthy(proxy)) {
+                return egressRefused("proxy " + redactProxy(proxy) + " is down");
+            }
+
+            auto session = std::make_shared<cpr::Session>();
+            session->SetUrl(cpr::Url {url});
+            session->SetHeader(hdr);
+            session->SetParameters(params);
+            session->SetTimeout(cpr::Timeout {budget});
+            const auto connectTimeout = std::min<std::chrono::milliseconds>(CONNECT_TIMEOUT, budget);
+            session->SetConnectTimeout(cpr::ConnectTimeout {connectTimeout});
+            session->SetRedirect(cpr::Redirect(follow_redirects ? max_redirects : 0L));
+            if (body) {
+                session->SetBody(cpr::Body {std::move(*body)});
+            }
+            if (write) {
+                session->SetWriteCallback(*write);
+            }
+            // Polled by curl while the transfer runs; returning false aborts it
+            session->SetProgressCallback(cpr::ProgressCallback {
+                [deadline, abandon, cancel](
+                    cpr::cpr_pf_arg_t, cpr::cpr_pf_arg_t, cpr::cpr_pf_arg_t, cpr::cpr_pf_arg_t, intptr_t
+                ) {
+                    return !ShutdownManager::instance().isShuttingDown() && Clock::now() < deadline
+                           && !(abandon && abandon->load(std::memory_order_relaxed))
+                           && !(cancel && cancel->load(std::memory_order_relaxed));
+                }
+            });
+            session->SetAcceptEncoding(
+                cpr::AcceptEncoding {cpr::AcceptEncodingMethods::gzip, cpr::AcceptEncodingMethods::deflate}
+            );
+            if (!proxy.empty()) {
+                session->SetProxies(cpr::Proxies {{"http", proxy}, {"https", proxy}});
+            }
+            CurlShare::forEgress(proxy).attach(*session);
+
+            using HttpMethod = cpr::MultiPerform::HttpMethod;
+            HttpMethod multiMethod = HttpMethod::GET_REQUEST;
+            switch (method) {
+                case Method::Get: multiMethod = HttpMethod::GET_REQUEST; break;
+                case Method::Post: multiMethod = HttpMethod::POST_REQUEST; break;
+                case Method::Patch: multiMethod = HttpMethod::PATCH_REQUEST; break;
+            }
+            cpr::Response r = performOnThread(session, multiMethod);
+            finishTransfer(*session);
+            // The losing copy of a hedged GET, cut off because the other one answered, or a request its
+            // caller gave up on. Either says nothing about the endpoint or the proxy, so it is not an attempt.
+            if (r.error.code == cpr::ErrorCode::ABORTED_BY_CALLBACK
+                && ((abandon && abandon->load(std::memory_order_relaxed))
+                    || (cancel && cancel->load(std::memory_order_relaxed)))) {
+                return r;
+            }
+            recordAttempt(key, r, static_cast<uint64_t>(r.uploaded_bytes), limiterWait);
+            if (!proxy.empty()) {
+                const TransportError error = transportError(r.error);
+                EgressTable::instance().report(
+                    proxy,
+                    error != TransportError::ConnectionFailed && error != TransportError::EgressUnavailable
+                );
+            }
+            if (transport) {
+                transport->observe(*seen, r);
+            }
+            return r;
+        }
+
+        // A GET raced against a copy of itself. The first attempt runs on the caller's thread; the
+        // copy is only sent if that attempt is still going once the endpoint's usual latency has
+        // passed, and runs on a worker registered with ShutdownManager. Whichever loses is aborted by
+        // the progress callback at its next tick.
+        struct HedgeRace {
+                std::string url;
+                std::string key; // endpointKey(url)
+                cpr::Header hdr;
+                cpr::Parameters params;
+                bool follow_redirects = true;
+                int max_redirects = 10;
+                DeadlineScope::Clock::time_point deadline;
+                int account = 0;
+                std::chrono::milliseconds after {0};
+
+                std::mutex mutex;
+                std::condition_variable cv;
+                bool primaryDone = false;
+                bool hedgeRunning = false;
+                std::optional<cpr::Response> result;
+                bool hedgeWon = false;
+                std::atomic<bool> settled {false};
+        };
+
+        void runHedge(const std::shared_ptr<HedgeRace> &race) {
+            DeadlineScope scope(race->deadline);
+            AccountScope account(race->account);
+            // Never queued in acquire(): fire() took its slot with tryAcquire()
+            cpr::Response r = perform(
+                Method::Get,
+                race->url,
+                race->key,
+                std::chrono::microseconds::zero(),
+                race->hdr,
+                race->params,
+                std::nullopt,
+                race->follow_redirects,
+                race->max_redirects,
+                nullptr,
+                &race->settled
+            );
+
+            std::lock_guard lock(race->mutex);
+            race->hedgeRunning = false;
+            // A failure only settles the race once the first attempt has given up too
+            if (!race->result && (r.error.code == cpr::ErrorCode::OK || race->primaryDone)) {
+                race->result = std::move(r);
+                race->hedgeWon = true;
+                race->settled = true;
+            }
+            race->cv.notify_all();
+        }
+
+        // Sends the copy for races still undecided when their delay runs out. One thread serves
+        // every race, so a GET that finishes in its usual time costs a queue entry, not a thread.
+        class HedgeTimer {
+            public:
+                using Clock = DeadlineScope::Clock;
+
+                static HedgeTimer &instance() {
+                    // Never destroyed: it outlives the requests that may still be scheduling on it
+                    static auto *timer = new HedgeTimer();
+                    return *timer;
+                }
+
+                void schedule(const std::shared_ptr<HedgeRace> &race) {
+                    std::lock_guard lock(m_mutex);
+                    m_due.emplace(Clock::now() + race->after, race);
+                    if (!m_started) {
+                        m_started = true;
+                        WorkerThreads::runBackground([this] { run(); });
+                    }
+                    m_cv.notify_one();
+                }
+
+            private:
+                // Upper bound on a wait, so the thread notices shutdown
+                static constexpr auto POLL = std::chrono::milliseconds(250);
+
+                void run() {
+                    std::unique_lock lock(m_mutex);
+                    while (!ShutdownManager::instance().isShuttingDown()) {
+                        const auto now = Clock::now();
+                        if (m_due.empty() || now < m_due.begin()->first) {
+                            const auto wake = m_due.empty() ? now + POLL : std::min(now + POLL, m_due.begin()->first);
+                            m_cv.wait_until(lock, wake);
+                            continue;
+                        }
+                        std::shared_ptr<HedgeRace> race = m_due.begin()->second.lock();
+                        m_due.erase(m_due.begin());
+                        if (race) {
+                            lock.unlock();
+                            fire(race);
+                            lock.lock();
+                        }
+                    }
+                }
+
+                static void fire(const std::shared_ptr<HedgeRace> &race) {
+                    {
+                        std::lock_guard lock(race->mutex);
+                        if (race->result || race->primaryDone) {
+                            return;
+                        }
+                        // The duplicate has to fit the host's retry budget and the shared limiter like any retry
+                        AccountScope account(race->account);
+                        if (Clock::now() + race->after >= race->deadline || !RateLimiter::current().tryAcquire()
+                            || !takeRetryToken(race->key)) {
+                            return;
+                        }
+                        race->hedgeRunning = true;
+                    }
+                    Metrics::recordHedge(race->key);
+                    WorkerThreads::runBackground([race] { runHedge(race); });
+                }
+
+                std::mutex m_mutex;
+                std::condition_variable m_cv;
+                std::multimap<Clock::time_point, std::weak_ptr<HedgeRace>> m_due;
+                bool m_started = false;
+        };
+
+        cpr::Response hedgedGet(
+            const std::string &url,
+            const std::string &key,
+            std::chrono::microseconds limiterWait,
+            const cpr::Header &hdr,
+            const cpr::Parameters &params,
+            bool follow_redirects,
+            int max_redirects,
+            std::chrono::milliseconds after
+        ) {
+            auto race = std::make_shared<HedgeRace>();
+            race->url = url;
+            race->key = key;
+            race->hdr = hdr;
+            race->params = params;
+            race->follow_redirects = follow_redirects;
+            race->max_redirects = max_redirects;
+            race->deadline = t_deadline;
+            race->account = t_account;
+            race->after = after;
+            HedgeTimer::instance().schedule(race);
+
+            cpr::Response primary = perform(
+                Method::Get,
+                url,
+                key,
+                limiterWait,
+                hdr,
+                params,
+                std::nullopt,
+                follow_redirects,
+                max_redirects,
+                nullptr,
+                &race->settled
+            );
+
+            std::unique_lock lock(race->mutex);
+            race->primaryDone = true;
+            // A failure waits for a copy still in flight; anything else settles the race
+            while (!race->result) {
+                if (primary.error.code == cpr::ErrorCode::OK || !race->hedgeRunning
+                    || ShutdownManager::instance().isShuttingDown() || cancellationRequested()) {
+                    race->result = std::move(primary);
+                    race->settled = true;
+                    break;
+                }
+                race->cv.wait_for(lock, std::chrono::milliseconds(250));
+            }
+
+            if (race->hedgeWon) {
+                Metrics::recordHedgeWin(key);
+            }
+            return std::move(*race->result);
+        }
+
         Response get_impl(
             const std::string &url,
             const cpr::Header &hdr,
@@ -83,14 +1086,105 @@ namespace HttpClient {
             bool follow_redirects,
             int max_redirects
         ) {
-            auto r = cpr::Get(cpr::Url {url}, hdr, params, cpr::Redirect(follow_redirects ? max_redirects : 0L));
-
-            std::map<std::string, std::string> hdrs(r.header.begin(), r.header.end());
+            const std::string key = endpointKey(url);
+            const auto limiterWait = std::exchange(t_limiterWait, 0us);
+            if (endpointPolicy(url).hedge) {
+                if (const auto after = hedgeDelay(key)) {
+                    return toResponse(
+                        hedgedGet(url, key, limiterWait, hdr, params, follow_redirects, max_redirects, *after),
+                        key
+                    );
+                }
+            }
+            return toResponse(
+                perform(Method::Get, url, key, limiterWait, hdr, params, std::nullopt, follow_redirects, max_redirects),
+                key
+            );
+        }
 
-            return {static_cast<int>(r.status_code), r.text, hdrs, r.url.str()};
+        Response post_impl(
+            const std::string &url,
+            cpr::Header &h,
+            const std::string &jsonBody,
+            std::initializer_list<std::pair<const std::string, std::string>> form,
+            bool follow_redirects,
+            int max_redirects
+        ) {
+            std::optional<std::string> body;
+            if (!jsonBody.empty()) {
+                h["Content-Type"] = "application/json";
+                body = jsonBody;
+            } else if (form.size() > 0) {
+                h["Content-Type"] = "application/x-www-form-urlencoded";
+                body = build_kv_string(form);
+            }
+            const std::string key = endpointKey(url);
+            const auto limiterWait = std::exchange(t_limiterWait, 0us);
+            return toResponse(
+                perform(Method::Post, url, key, limiterWait, h, {}, std::move(body), follow_redirects, max_redirects),
+                key
+            );
         }
     } // namespace
 
+    DeadlineScope::DeadlineScope(Clock::duration budget)
+        : DeadlineScope(Clock::now() + budget) {}
+
+    DeadlineScope::DeadlineScope(Clock::time_point deadline)
+        : m_previous(t_deadline) {
+        t_deadline = std::min(t_deadline, deadline);
+    }
+
+    DeadlineScope::~DeadlineScope() { t_deadline = m_previous; }
+
+    DeadlineScope::Clock::time_point currentDeadline() { return t_deadline; }
+
+    CancelScope::CancelScope(const std::atomic<bool> &cancel)
+        : m_previous(std::exchange(t_cancel, &cancel)) {}
+
+    CancelScope::~CancelScope() { t_cancel = m_previous; }
+
+    bool cancellationRequested() { return t_cancel && t_cancel->load(std::memory_order_relaxed); }
+
+    const char *requestPriorityName(RequestPriority priority) {
+        switch (priority) {
+            case RequestPriority::Launch: return "launch";
+            case RequestPriority::Interactive: return "interactive";
+            case RequestPriority::Background: return "background";
+            case RequestPriority::Bulk: return "bulk";
+        }
+        return "unknown";
+    }
+
+    PriorityScope::PriorityScope(RequestPriority priority)
+        : m_previous(t_priority) {
+        t_priority = priority;
+    }
+
+    PriorityScope::~PriorityScope() { t_priority = m_previous; }
+
+    RequestPriority currentPriority() { return t_priority; }
+
+    void setAccountProxy(int accountId, std::string proxyUrl, std::string_view cookie) {
+        EgressTable::instance().assign(accountId, std::move(proxyUrl), cookie);
+    }
+
+    std::vector<ProxyStatus> proxyStatus() { return EgressTable::instance().status(); }
+
+    AccountScope::AccountScope(int accountId)
+        : m_previous(t_account) {
+        t_account = accountId;
+    }
+
+    AccountScope::~AccountScope() { t_account = m_previous; }
+
+    int currentAccount() { return t_account; }
+
+    LimiterWaitScope::LimiterWaitScope(std::chrono::microseconds waited)
+        : m_previous(std::exchange(t_limiterWait, waited)) {}
+
+    LimiterWaitScope::~LimiterWaitScope() { t_limiterWait = m_previous; }
+
     Response
     get(const std::string &url,
         std::initializer_list<std::pair<std::string, std::string>> headers,
@@ -128,18 +1222,37 @@ namespace HttpClient {
         bool follow_redirects,
         int max_redirects
     ) {
-        auto r = cpr::Get(
-            cpr::Url {url},
+        // The body is written straight into the vector that is returned instead of being collected
+        // in cpr's text and copied over afterwards
+        std::vector<uint8_t> data;
+        cpr::WriteCallback write {[&data](const std::string_view &chunk, intptr_t) -> bool {
+            data.insert(data.end(), chunk.begin(), chunk.end());
+            return true;
+        }};
+
+        const std::string key = endpointKey(url);
+        auto r = perform(
+            Method::Get,
+            url,
+            key,
+            std::exchange(t_limiterWait, 0us),
             cpr::Header {headers},
             params,
-            cpr::Redirect(follow_redirects ? max_redirects : 0L)
+            std::nullopt,
+            follow_redirects,
+            max_redirects,
+            &write
         );
+        recordTransfer(key, static_cast<uint64_t>(r.downloaded_bytes), data.size());
 
-        std::map<std::string, std::string> hdrs(r.header.begin(), r.header.end());
-
-        std::vector<uint8_t> data(r.text.begin(), r.text.end());
-
-        return {static_cast<int>(r.status_code), std::move(data), hdrs, r.url.str()};
+        BinaryResponse out {
+            static_cast<int>(r.status_code),
+            std::move(data),
+            Headers(std::move(r.raw_header)),
+            r.url.str(),
+        };
+        out.transport = transportError(r.error);
+        return out;
     }
 
     Response post(
@@ -151,26 +1264,7 @@ namespace HttpClient {
         int max_redirects
     ) {
         cpr::Header h {headers};
-        cpr::Response r;
-
-        if (!jsonBody.empty()) {
-            h["Content-Type"] = "application/json";
-            r = cpr::Post(
-                cpr::Url {url},
-                h,
-                cpr::Body {jsonBody},
-                cpr::Redirect(follow_redirects ? max_redirects : 0L)
-            );
-        } else if (form.size() > 0) {
-            std::string body = build_kv_string(form);
-            h["Content-Type"] = "application/x-www-form-urlencoded";
-            r = cpr::Post(cpr::Url {url}, h, cpr::Body {body}, cpr::Redirect(follow_redirects ? max_redirects : 0L));
-        } else {
-            r = cpr::Post(cpr::Url {url}, h, cpr::Redirect(follow_redirects ? max_redirects : 0L));
-        }
-
-        std::map<std::string, std::string> hdrs(r.header.begin(), r.header.end());
-        return {static_cast<int>(r.status_code), r.text, hdrs, r.url.str()};
+        return post_impl(url, h, jsonBody, form, follow_redirects, max_redirects);
     }
 
     Response post(
@@ -186,26 +1280,7 @@ namespace HttpClient {
             h.emplace(k, v);
         }
 
-        cpr::Response r;
-
-        if (!jsonBody.empty()) {
-            h["Content-Type"] = "application/json";
-            r = cpr::Post(
-                cpr::Url {url},
-                h,
-                cpr::Body {jsonBody},
-                cpr::Redirect(follow_redirects ? max_redirects : 0L)
-            );
-        } else if (form.size() > 0) {
-            std::string body = build_kv_string(form);
-            h["Content-Type"] = "application/x-www-form-urlencoded";
-            r = cpr::Post(cpr::Url {url}, h, cpr::Body {body}, cpr::Redirect(follow_redirects ? max_redirects : 0L));
-        } else {
-            r = cpr::Post(cpr::Url {url}, h, cpr::Redirect(follow_redirects ? max_redirects : 0L));
-        }
-
-        std::map<std::string, std::string> hdrs(r.header.begin(), r.header.end());
-        return {static_cast<int>(r.status_code), r.text, hdrs, r.url.str()};
+        return post_impl(url, h, jsonBody, form, follow_redirects, max_redirects);
     }
 
     Response patch(
@@ -217,9 +1292,9 @@ namespace HttpClient {
         for (const auto &[k, v]: headers) {
             cprHdr.emplace(k, v);
         }
-        auto r = cpr::Patch(cpr::Url {url}, cprHdr, cpr::Body {jsonBody});
-        std::map<std::string, std::string> hdrs(r.header.begin(), r.header.end());
-        return {static_cast<int>(r.status_code), r.text, hdrs, r.url.str()};
+        const std::string key = endpointKey(url);
+        const auto limiterWait = std::exchange(t_limiterWait, 0us);
+        return toResponse(perform(Method::Patch, url, key, limiterWait, cprHdr, {}, jsonBody, true, 10), key);
     }
 
     bool download(
@@ -230,7 +1305,7 @@ namespace HttpClient {
     ) {
         std::ofstream file(output_path, std::ios::binary);
         if (!file) {
-            LOG_ERROR("Failed to create file: {}", output_path);
+            LOG_CAT_ERROR(Network, "Failed to create file: {}", output_path);
             return false;
         }
 
@@ -250,23 +1325,27 @@ namespace HttpClient {
             };
         }
 
-        cpr::Response r;
+        cpr::Session session;
+        session.SetUrl(cpr::Url {url});
+        session.SetHeader(cpr::Header {headers});
+        session.SetConnectTimeout(cpr::ConnectTimeout {CONNECT_TIMEOUT});
         if (progress_cb) {
-            r = cpr::Download(file, cpr::Url {url}, cpr::Header {headers}, cpr_progress);
-        } else {
-            r = cpr::Download(file, cpr::Url {url}, cpr::Header {headers});
+            session.SetProgressCallback(cpr_progress);
         }
+        CurlShare::instance().attach(session);
+
+        cpr::Response r = session.Download(file);
 
         file.close();
 
         if (r.status_code != 200) {
-            LOG_ERROR("Download failed: HTTP {}", r.status_code);
+            LOG_CAT_ERROR(Network, "Download failed: HTTP {}", r.status_code);
             std::filesystem::remove(output_path);
             return false;
         }
 
         if (r.error.code != cpr::ErrorCode::OK) {
-            LOG_ERROR("Download error: {}", r.error.message);
+            LOG_CAT_ERROR(Network, "Download error: {}", r.error.message);
             std::filesystem::remove(output_path);
             return false;
         }
@@ -292,7 +1371,7 @@ namespace HttpClient {
         std::ofstream file(output_path, mode);
         if (!file) {
             result.error = std::format("Failed to open file: {}", output_path);
-            LOG_ERROR("{}", result.error);
+            LOG_CAT_ERROR(Network, "{}", result.error);
             return result;
         }
 
@@ -405,7 +1484,16 @@ namespace HttpClient {
             }
         };
 
-        cpr::Response r = cpr::Get(cpr::Url {url}, cprHeaders, writeCallback, progressCallback, cpr::Redirect(10L));
+        cpr::Session session;
+        session.SetUrl(cpr::Url {url});
+        session.SetHeader(cprHeaders);
+        session.SetWriteCallback(writeCallback);
+        session.SetProgressCallback(progressCallback);
+        session.SetRedirect(cpr::Redirect(10L));
+        session.SetConnectTimeout(cpr::ConnectTimeout {CONNECT_TIMEOUT});
+        CurlShare::instance().attach(session);
+
+        cpr::Response r = session.Get();
 
         file.close();
 
@@ -437,14 +1525,14 @@ namespace HttpClient {
 
         if (r.error.code != cpr::ErrorCode::OK && !state.cancelled) {
             result.error = r.error.message;
-            LOG_ERROR("Download error: {}", result.error);
+            LOG_CAT_ERROR(Network, "Download error: {}", result.error);
         }
 
         if (result.status_code != 200 && result.status_code != 206 && !state.cancelled) {
             if (result.error.empty()) {
                 result.error = std::format("HTTP error: {}", result.status_code);
             }
-            LOG_ERROR("Download failed: HTTP {}", result.status_code);
+            LOG_CAT_ERROR(Network, "Download failed: HTTP {}", result.status_code);
         }
 
         return result;
@@ -478,7 +1566,7 @@ namespace HttpClient {
     bool DownloadSession::download_to_file(const std::string &output_path, ProgressCallback progress_cb) {
         std::ofstream file(output_path, std::ios::binary);
         if (!file) {
-            LOG_ERROR("Failed to create file: {}", output_path);
+            LOG_CAT_ERROR(Network, "Failed to create file: {}", output_path);
             return false;
         }
 
@@ -499,17 +1587,19 @@ namespace HttpClient {
             );
         }
 
+        m_impl->session.SetConnectTimeout(cpr::ConnectTimeout {CONNECT_TIMEOUT});
+        CurlShare::instance().attach(m_impl->session);
         cpr::Response r = m_impl->session.Download(file);
         file.close();
 
         if (r.status_code != 200) {
-            LOG_ERROR("Download failed: HTTP {}", r.status_code);
+            LOG_CAT_ERROR(Network, "Download failed: HTTP {}", r.status_code);
             std::filesystem::remove(output_path);
             return false;
         }
 
         if (r.error.code != cpr::ErrorCode::OK) {
-            LOG_ERROR("Download error: {}", r.error.message);
+            LOG_CAT_ERROR(Network, "Download error: {}", r.error.message);
             std::filesystem::remove(output_path);
             return false;
         }
@@ -527,30 +1617,134 @@ namespace HttpClient {
         return instance;
     }
 
+    namespace {
+        // Limiters for proxied egresses, created on first use; never destroyed, like the direct one's
+        // users they may outlive static destruction on detached threads
+        std::mutex &egressLimitersMutex() {
+            static auto *mutex = new std::mutex();
+            return *mutex;
+        }
+
+        std::unordered_map<std::string, RateLimiter *> &egressLimiters() {
+            static auto *limiters = new std::unordered_map<std::string, RateLimiter *>();
+            return *limiters;
+        }
+    } // namespace
+
+    RateLimiter &RateLimiter::current() { return forEgress(currentEgress()); }
+
+    RateLimiter &RateLimiter::forEgress(const std::string &proxy) {
+        if (proxy.empty()) {
+            return instance();
+        }
+        std::lock_guard lock(egressLimitersMutex());
+        auto &limiter = egressLimiters()[proxy];
+        if (!limiter) {
+            limiter = new RateLimiter();
+            const auto &direct = instance();
+            limiter->configure(direct.maxRequests(), direct.windowSize());
+        }
+        return *limiter;
+    }
+
     void RateLimiter::configure(int maxRequests, Duration windowSize) {
-        std::lock_guard lock(m_mutex);
-        m_maxRequests = maxRequests;
-        m_windowSize = windowSize;
+        {
+            std::lock_guard lock(m_mutex);
+            m_maxRequests = maxRequests;
+            m_windowSize = windowSize;
+        }
+
+        // Every egress gets the same budget, so total throughput grows with the number of proxies
+        if (this == &instance()) {
+            std::lock_guard lock(egressLimitersMutex());
+            for (auto &[proxy, limiter]: egressLimiters()) {
+                limiter->configure(maxRequests, windowSize);
+            }
+        }
     }
 
     void RateLimiter::pruneOldRequests() const {
         auto now = Clock::now();
         auto cutoff = now - m_windowSize;
 
-        while (!m_requestTimestamps.empty() && m_requestTimestamps.front() < cutoff) {
+        while (!m_requestTimestamps.empty() && m_requestTimestamps.front().at < cutoff) {
+            --m_accounts[m_requestTimestamps.front().account].inWindow;
             m_requestTimestamps.pop_front();
         }
     }
 
-    void RateLimiter::acquire() {
+    void RateLimiter::recordGrant(Clock::time_point now, int account) {
+        m_requestTimestamps.push_back({now, account});
+        auto &state = m_accounts[account];
+        ++state.inWindow;
+        ++state.acquired;
+    }
+
+    std::list<RateLimiter::Waiter>::const_iterator RateLimiter::nextWaiter(Clock::time_point now) const {
+        auto rank = [&](const Waiter &w) {
+            const auto levels = static_cast<int>((now - w.since) / AGING_STEP);
+            return std::max(0, static_cast<int>(w.priority) - levels);
+        };
+        auto usage = [&](const Waiter &w) {
+            const auto it = m_accounts.find(w.account);
+            return it == m_accounts.end() ? AccountState {} : it->second;
+        };
+        const int shareLimit = std::max(1, static_cast<int>(m_maxRequests * ACCOUNT_SHARE));
+
+        auto best = m_waiters.end();
+        bool bestOverShare = false;
+        int bestRank = 0;
+        int bestInWindow = 0;
+        for (auto it = m_waiters.begin(); it != m_waiters.end(); ++it) {
+            const AccountState state = usage(*it);
+            if (it->account != 0 && state.inFlight >= MAX_IN_FLIGHT_PER_ACCOUNT) {
+                continue;
+            }
+            const bool overShare = it->account != 0 && state.inWindow >= shareLimit;
+            const int r = rank(*it);
+            // Tickets only grow along the list, so the first of equals is the oldest
+            if (best == m_waiters.end()
+                || std::tie(overShare, r, state.inWindow) < std::tie(bestOverShare, bestRank, bestInWindow)) {
+                best = it;
+                bestOverShare = overShare;
+                bestRank = r;
+                bestInWindow = state.inWindow;
+            }
+        }
+        return best;
+    }
+
+    void RateLimiter::releasePermit(int account) {
+        {
+            std::lock_guard lock(m_mutex);
+            --m_accounts[account].inFlight;
+        }
+        m_cv.notify_all();
+    }
+
+    void RateLimiter::Permit::release() {
+        if (auto *limiter = std::exchange(m_limiter, nullptr)) {
+            limiter->releasePermit(m_account);
+        }
+    }
+
+    RateLimiter::Permit RateLimiter::acquire() { return acquire(currentPriority(), currentAccount()); }
+
+    RateLimiter::Permit RateLimiter::acquire(RequestPriority priority, int accountId) {
+        TRACE_SPAN(Network, "http.limiter_wait");
         std::unique_lock lock(m_mutex);
 
+        const auto self = m_waiters.insert(
+            m_waiters.end(),
+            Waiter {priority, accountId, Clock::now(), m_nextTicket++}
+        );
+
         while (true) {
             auto now = Clock::now();
 
             if (now < m_backoffUntil) {
                 auto waitTime = m_backoffUntil - now;
-                LOG_INFO("Rate limiter: backing off for {}ms",
+                LOG_CAT_INFO(Network, "Rate limiter: backing off for {}ms",
                     std::chrono::duration_cast<std::chrono::milliseconds>(waitTime).count());
                 m_cv.wait_for(lock, waitTime);
                 continue;
@@ -559,11 +1753,28 @@ namespace HttpClient {
             pruneOldRequests();
 
             if (static_cast<int>(m_requestTimestamps.size()) < m_maxRequests) {
-                m_requestTimestamps.push_back(now);
-                return;
+                if (nextWaiter(now) != self) {
+                    // Someone more urgent or less served takes this slot, or this account is at its
+                    // in-flight limit; look again once that changes, or once waiting long enough has
+                    // made this request the more urgent one
+                    m_cv.wait_for(lock, AGING_STEP);
+                    continue;
+                }
+
+                recordGrant(now, accountId);
+                ++m_accounts[accountId].inFlight;
+                auto &totals = m_waitTotals[static_cast<size_t>(priority)];
+                const auto waited = now - self->since;
+                ++totals.acquired;
+                totals.total += waited;
+                totals.max = std::max(totals.max, waited);
+                m_waiters.erase(self);
+                // The next in line may find a slot too
+                m_cv.notify_all();
+                return Permit(this, accountId, std::chrono::duration_cast<std::chrono::microseconds>(waited));
             }
 
-            auto oldestExpiry = m_requestTimestamps.front() + m_windowSize;
+            auto oldestExpiry = m_requestTimestamps.front().at + m_windowSize;
             auto waitTime = oldestExpiry - now;
 
             if (waitTime > std::chrono::milliseconds(0)) {
@@ -577,14 +1788,14 @@ namespace HttpClient {
 
         auto now = Clock::now();
 
-        if (now < m_backoffUntil) {
+        if (now < m_backoffUntil || !m_waiters.empty()) {
             return false;
         }
 
         pruneOldRequests();
 
         if (static_cast<int>(m_requestTimestamps.size()) < m_maxRequests) {
-            m_requestTimestamps.push_back(now);
+            recordGrant(now, currentAccount());
             return true;
         }
 
@@ -603,30 +1814,137 @@ namespace HttpClient {
 
         if (newBackoff > m_backoffUntil) {
             m_backoffUntil = newBackoff;
-            LOG_WARN("Rate limiter: 429 received, backing off for {}ms",
+            LOG_CAT_WARN(Network, "Rate limiter: 429 received, backing off for {}ms",
                 std::chrono::duration_cast<std::chrono::milliseconds>(duration).count());
         }
 
         m_cv.notify_all();
     }
 
+    bool isRetryable(const Response &response, bool idempotent) {
+        switch (response.transport) {
+            case TransportError::ConnectionFailed: return true;
+            case TransportError::Timeout: return idempotent;
+            case TransportError::Cancelled:
+            case TransportError::EgressUnavailable:
+            case TransportError::Other: return false;
+            case TransportError::None: break;
+        }
+        if (response.status_code == 429) {
+            return true;
+        }
+        return idempotent && (response.status_code == 408 || response.status_code >= 500);
+    }
+
+    bool prepareRetry(const Response &response, const RetryPolicy &policy, int attempt) {
+        if (!isRetryable(response, policy.idempotent)) {
+            return false;
+        }
+
+        thread_local std::mt19937 rng {std::random_device {}()};
+        const std::chrono::milliseconds ceiling =
+            std::min<std::chrono::milliseconds>(policy.maxDelay, policy.baseDelay * (1 << std::min(attempt, 16)));
+        std::uniform_int_distribution<std::chrono::milliseconds::rep> jitter(ceiling.count() / 2, ceiling.count());
+        auto delay = std::chrono::milliseconds(jitter(rng));
+
+        // Retry-After in seconds is a floor, within what the policy is willing to wait
+        if (const auto retryAfter = response.headers.find("Retry-After"); retryAfter != response.headers.end()) {
+            std::chrono::milliseconds::rep seconds = 0;
+            const auto &value = retryAfter->second;
+            if (std::from_chars(value.data(), value.data() + value.size(), seconds).ec == std::errc {}) {
+                delay = std::max(delay, std::min(policy.maxDelay, std::chrono::milliseconds(seconds * 1000)));
+            }
+        }
+
+        if (DeadlineScope::Clock::now() + delay >= currentDeadline()) {
+            return false;
+        }
+        if (!takeRetryToken(response.final_url)) {
+            LOG_CAT_DEBUG(Network, "Retry budget for {} spent, not retrying", hostOf(response.final_url));
+            return false;
+        }
+
+        const std::string endpoint = endpointKey(response.final_url);
+        Metrics::recordRetry(endpoint, delay);
+        LOG_EVENT(
+            Network,
+            Debug,
+            "net.retry",
+            {"endpoint", endpoint},
+            {"status", response.status_code},
+            {"attempt", attempt + 1},
+            {"delay_ms", delay.count()}
+        );
+
+        if (response.status_code == 429) {
+            RateLimiter::current().backoff(delay);
+        }
+        TRACE_SPAN(Network, "http.backoff");
+        return !ShutdownManager::instance().sleepFor(delay);
+    }
+
+    std::array<RateLimiter::QueueStat, REQUEST_PRIORITY_COUNT> RateLimiter::queueStats() const {
+        using Ms = std::chrono::duration<double, std::milli>;
+
+        std::lock_guard lock(m_mutex);
+        std::array<QueueStat, REQUEST_PRIORITY_COUNT> out {};
+        for (size_t i = 0; i < out.size(); ++i) {
+            const auto &totals = m_waitTotals[i];
+            out[i].acquired = totals.acquired;
+            if (totals.acquired > 0) {
+                out[i].meanWaitMs = Ms(totals.total).count() / static_cast<double>(totals.acquired);
+                out[i].maxWaitMs = Ms(totals.max).count();
+            }
+        }
+        return out;
+    }
+
+    std::vector<RateLimiter::AccountUsage> RateLimiter::accountUsage() const {
+        std::vector<AccountUsage> out;
+        {
+            std::lock_guard lock(m_mutex);
+            pruneOldRequests();
+            out.reserve(m_accounts.size());
+            for (const auto &[accountId, state]: m_accounts) {
+                out.push_back({accountId, state.acquired, state.inWindow, state.inFlight});
+            }
+        }
+        std::ranges::sort(out, std::greater {}, &AccountUsage::acquired);
+        return out;
+    }
+
+    void RateLimiter::resetQueueStats() {
+        std::lock_guard lock(m_mutex);
+        m_waitTotals = {};
+        for (auto &[accountId, state]: m_accounts) {
+            state.acquired = 0;
+        }
+    }
+
     Response rateLimitedGet(
         const std::string &url,
         const std::vector<std::pair<std::string, std::string>> &headers
     ) {
-        return rateLimitedRequest([&]() {
-            return HttpClient::get(url, headers);
-        });
+        return rateLimitedRequest(
+            [&]() {
+                return HttpClient::get(url, headers);
+            },
+            {.idempotent = true}
+        );
     }
 
     Response rateLimitedPost(
         const std::string &url,
         const std::vector<std::pair<std::string, std::string>> &headers,
-        const std::string &body
+        const std::string &body,
+        RetryPolicy policy
     ) {
-        return rateLimitedRequest([&]() {
-            return HttpClient::post(url, headers, body);
-        });
+        return rateLimitedRequest(
+            [&]() {
+                return HttpClient::post(url, headers, body);
+            },
+            policy
+        );
     }
 
 } // namespace HttpClient
@@ -0,0 +1,70 @@
+#include "http_headers.h"
+
+#include <algorithm>
+
+namespace HttpClient {
+
+    namespace {
+        // Header names are ASCII tokens, so this skips the locale lookups of std::tolower
+        bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+            auto lower = [](char c) { return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c; };
+            return a.size() == b.size()
+                   && std::equal(a.begin(), a.end(), b.begin(), [&](char x, char y) { return lower(x) == lower(y); });
+        }
+    } // namespace
+
+    Headers::const_iterator Headers::find(std::string_view name) const {
+        parse();
+        return std::ranges::find_if(m_entries, [name](const value_type &entry) {
+            return equalsIgnoreCase(entry.first, name);
+        });
+    }
+
+    void Headers::parse() const {
+        if (m_parsed) {
+            return;
+        }
+        m_parsed = true;
+        // One entry per line at most, so the list never grows while it is filled
+        m_entries.reserve(static_cast<size_t>(std::ranges::count(m_raw, '\n')));
+
+        std::string_view rest = m_raw;
+        while (!rest.empty()) {
+            const size_t eol = rest.find('\n');
+            std::string_view line = rest.substr(0, eol);
+            rest = eol == std::string_view::npos ? std::string_view {} : rest.substr(eol + 1);
+            if (!line.empty() && line.back() == '\r') {
+                line.remove_suffix(1);
+            }
+
+            // Every redirect hop adds its own block; only the final response's headers count
+            if (line.starts_with("HTTP/")) {
+                m_entries.clear();
+                continue;
+            }
+
+            const size_t colon = line.find(':');
+            if (colon == std::string_view::npos) {
+                continue;
+            }
+            std::string_view value = line.substr(colon + 1);
+            while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+                value.remove_prefix(1);
+            }
+            const std::string_view name = line.substr(0, colon);
+
+            // Repeated headers (Set-Cookie among them) are folded into one entry, as cpr did
+            const auto existing = std::ranges::find_if(m_entries, [name](const value_type &entry) {
+                return equalsIgnoreCase(entry.first, name);
+            });
+            if (existing != m_entries.end()) {
+                existing->second.append(", ").append(value);
+            } else {
+                m_entries.emplace_back(std::string(name), std::string(value));
+            }
+        }
+
+        m_raw = std::string {};
+    }
+
+} // namespace HttpClient
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace HttpClient {
+
+    // Response headers as a flat list with case-insensitive lookup. The raw header block is adopted
+    // as received and only split into entries on the first lookup, so the many responses whose
+    // headers are never read cost nothing beyond the move.
+    //
+    // Because of that, every accessor here - find(), contains(), begin(), end(), size(), empty() -
+    // may write to the object even though it is const: the first one to run parses the block and
+    // replaces it with the entries. Unlike a standard container, a const Headers is therefore NOT
+    // safe to read from two threads at once. A response belongs to one thread at a time; anything
+    // that shares one across threads must lock around header reads, or call size() once before
+    // handing it over so that later reads no longer write.
+    class Headers {
+        public:
+            using value_type = std::pair<std::string, std::string>;
+            using const_iterator = std::vector<value_type>::const_iterator;
+
+            Headers() = default;
+            explicit Headers(std::string raw)
+                : m_raw(std::move(raw)),
+                  m_parsed(m_raw.empty()) {}
+
+            [[nodiscard]] const_iterator find(std::string_view name) const;
+            [[nodiscard]] bool contains(std::string_view name) const { return find(name) != end(); }
+
+            [[nodiscard]] const_iterator begin() const {
+                parse();
+                return m_entries.begin();
+            }
+
+            [[nodiscard]] const_iterator end() const {
+                parse();
+                return m_entries.end();
+            }
+
+            [[nodiscard]] size_t size() const {
+                parse();
+                return m_entries.size();
+            }
+
+            [[nodiscard]] bool empty() const { return size() == 0; }
+
+        private:
+            // Splits m_raw into m_entries and releases it; runs once, from whichever accessor is first
+            void parse() const;
+
+            mutable std::string m_raw;
+            mutable std::vector<value_type> m_entries;
+            mutable bool m_parsed = true;
+    };
+
+} // namespace HttpClient
@@ -0,0 +1,404 @@
+#include "http_metrics.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <format>
+#include <functional>
+#include <thread>
+
+#include <nlohmann/json.hpp>
+
+namespace HttpClient {
+
+    namespace {
+        constexpr int SUB_BUCKET_BITS = 4;
+        constexpr uint64_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+        // Values below this get a bucket each; above it, each power of two is split in SUB_BUCKETS
+        constexpr uint64_t LINEAR_LIMIT = SUB_BUCKETS * 2;
+        constexpr uint64_t MAX_MICROS = (uint64_t {1} << 31) - 1;
+
+        constexpr int MAX_STATUS = 600;
+
+        struct Counters {
+                std::string endpoint;
+                std::atomic<uint64_t> requests {0};
+                std::atomic<uint64_t> sentBytes {0};
+                std::atomic<uint64_t> wireBytes {0};
+                std::atomic<uint64_t> decodedBytes {0};
+                std::atomic<uint64_t> retries {0};
+                std::atomic<uint64_t> hedges {0};
+                std::atomic<uint64_t> hedgeWins {0};
+                std::atomic<uint64_t> backoffUs {0};
+                std::atomic<uint64_t> limiterWaitUs {0};
+                std::atomic<uint64_t> latencySumUs {0};
+                std::array<std::atomic<uint64_t>, MAX_STATUS> statuses {}; // anything else counts as 0
+                LatencyHistogram latency;
+        };
+
+        // Open addressing over a fixed table. A slot is claimed by swapping its hash in from zero
+        // and published by storing the counters; neither is ever undone, so readers need no lock
+        // and a pointer once found stays valid for the life of the process.
+        struct Slot {
+                std::atomic<size_t> hash {0};
+                std::atomic<Counters *> counters {nullptr};
+        };
+
+        constexpr size_t MAX_ENDPOINTS = 512;
+
+        std::array<Slot, MAX_ENDPOINTS> g_slots;
+
+        Counters &overflow() {
+            static auto *counters = [] {
+                auto *c = new Counters();
+                c->endpoint = "(other)";
+                return c;
+            }();
+            return *counters;
+        }
+
+        Counters &countersFor(std::string_view endpoint) {
+            // Zero marks a free slot
+            const size_t hash = std::hash<std::string_view> {}(endpoint) | 1;
+
+            for (size_t probe = 0; probe < MAX_ENDPOINTS; ++probe) {
+                Slot &slot = g_slots[(hash + probe) % MAX_ENDPOINTS];
+                size_t seen = slot.hash.load(std::memory_order_acquire);
+
+                if (seen == 0) {
+                    if (slot.hash.compare_exchange_strong(seen, hash, std::memory_order_acq_rel)) {
+                        auto *counters = new Counters();
+                        counters->endpoint = std::string(endpoint);
+                        slot.counters.store(counters, std::memory_order_release);
+                        return *counters;
+                    }
+                    // Lost the race; seen now holds the winner's hash
+                }
+                if (seen != hash) {
+                    continue;
+                }
+
+                // The claiming thread publishes the counters right after the hash
+                Counters *counters = slot.counters.load(std::memory_order_acquire);
+                while (!counters) {
+                    std::this_thread::yield();
+                    counters = slot.counters.load(std::memory_order_acquire);
+                }
+                if (counters->endpoint == endpoint) {
+                    return *counters;
+                }
+            }
+            return overflow();
+        }
+
+        void add(std::atomic<uint64_t> &counter, uint64_t amount) {
+            counter.fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        uint64_t toMicros(std::chrono::microseconds duration) {
+            return static_cast<uint64_t>(std::max<std::chrono::microseconds::rep>(0, duration.count()));
+        }
+
+        EndpointMetrics snapshot(const Counters &counters) {
+            auto load = [](const std::atomic<uint64_t> &counter) { return counter.load(std::memory_order_relaxed); };
+
+            EndpointMetrics out;
+            out.endpoint = counters.endpoint;
+            out.requests = load(counters.requests);
+            out.sentBytes = load(counters.sentBytes);
+            out.wireBytes = load(counters.wireBytes);
+            out.decodedBytes = load(counters.decodedBytes);
+            out.retries = load(counters.retries);
+            out.hedges = load(counters.hedges);
+            out.hedgeWins = load(counters.hedgeWins);
+            out.backoffMs = static_cast<double>(load(counters.backoffUs)) / 1000.0;
+            out.limiterWaitMs = static_cast<double>(load(counters.limiterWaitUs)) / 1000.0;
+            out.latencySumMs = static_cast<double>(load(counters.latencySumUs)) / 1000.0;
+            for (int status = 0; status < MAX_STATUS; ++status) {
+                if (const uint64_t count = load(counters.statuses[status]); count > 0) {
+                    out.statuses.emplace_back(status, count);
+                }
+            }
+            out.latency = counters.latency.snapshot();
+            return out;
+        }
+
+        void clear(Counters &counters) {
+            for (auto *counter: {
+                     &counters.requests,
+                     &counters.sentBytes,
+                     &counters.wireBytes,
+                     &counters.decodedBytes,
+                     &counters.retries,
+                     &counters.hedges,
+                     &counters.hedgeWins,
+                     &counters.backoffUs,
+                     &counters.limiterWaitUs,
+                     &counters.latencySumUs,
+                 }) {
+                counter->store(0, std::memory_order_relaxed);
+            }
+            for (auto &status: counters.statuses) {
+                status.store(0, std::memory_order_relaxed);
+            }
+            counters.latency.reset();
+        }
+
+        template<typename Fn>
+        void forEachCounters(Fn &&fn) {
+            for (auto &slot: g_slots) {
+                if (Counters *counters = slot.counters.load(std::memory_order_acquire)) {
+                    fn(*counters);
+                }
+            }
+            fn(overflow());
+        }
+
+        std::string prometheusLabel(std::string_view value) {
+            std::string out;
+            out.reserve(value.size());
+            for (char c: value) {
+                switch (c) {
+                    case '\\': out += "\\\\"; break;
+                    case '"': out += "\\\""; break;
+                    case '\n': out += "\\n"; break;
+                    default: out.push_back(c);
+                }
+            }
+            return out;
+        }
+    } // namespace
+
+    void LatencyHistogram::record(std::chrono::microseconds elapsed) noexcept {
+        m_counts[bucketOf(toMicros(elapsed))].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    LatencyHistogram::Counts LatencyHistogram::snapshot() const noexcept {
+        Counts out {};
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            out[i] = m_counts[i].load(std::memory_order_relaxed);
+        }
+        return out;
+    }
+
+    void LatencyHistogram::reset() noexcept {
+        for (auto &count: m_counts) {
+            count.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    size_t LatencyHistogram::bucketOf(uint64_t micros) noexcept {
+        micros = std::min(micros, MAX_MICROS);
+        if (micros < LINEAR_LIMIT) {
+            return static_cast<size_t>(micros);
+        }
+        // Keep the top SUB_BUCKET_BITS + 1 bits; the leading one picks the power of two
+        const int shift = std::bit_width(micros) - (SUB_BUCKET_BITS + 1);
+        return static_cast<size_t>(LINEAR_LIMIT + (shift - 1) * SUB_BUCKETS + ((micros >> shift) - SUB_BUCKETS));
+    }
+
+    uint64_t LatencyHistogram::upperBound(size_t bucket) noexcept {
+        if (bucket < LINEAR_LIMIT) {
+            return bucket;
+        }
+        const uint64_t shift = (bucket - LINEAR_LIMIT) / SUB_BUCKETS + 1;
+        const uint64_t top = (bucket - LINEAR_LIMIT) % SUB_BUCKETS + SUB_BUCKETS;
+        return ((top + 1) << shift) - 1;
+    }
+
+    double LatencyHistogram::percentileMs(const Counts &counts, double q) noexcept {
+        uint64_t total = 0;
+        for (uint64_t count: counts) {
+            total += count;
+        }
+        if (total == 0) {
+            return 0.0;
+        }
+
+        const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(total))));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                return static_cast<double>(upperBound(i)) / 1000.0;
+            }
+        }
+        return static_cast<double>(upperBound(BUCKETS - 1)) / 1000.0;
+    }
+
+    uint64_t EndpointMetrics::statusCount(int from, int to) const {
+        uint64_t total = 0;
+        for (const auto &[status, count]: statuses) {
+            if (status >= from && status <= to) {
+                total += count;
+            }
+        }
+        return total;
+    }
+
+    namespace Metrics {
+        void recordRequest(
+            std::string_view endpoint,
+            int status,
+            std::chrono::microseconds elapsed,
+            uint64_t sentBytes,
+            std::chrono::microseconds limiterWait
+        ) {
+            Counters &counters = countersFor(endpoint);
+            add(counters.requests, 1);
+            add(counters.sentBytes, sentBytes);
+            add(counters.statuses[status > 0 && status < MAX_STATUS ? status : 0], 1);
+            add(counters.latencySumUs, toMicros(elapsed));
+            add(counters.limiterWaitUs, toMicros(limiterWait));
+            counters.latency.record(elapsed);
+        }
+
+        void recordTransfer(std::string_view endpoint, uint64_t wireBytes, uint64_t decodedBytes) {
+            Counters &counters = countersFor(endpoint);
+            add(counters.wireBytes, wireBytes);
+            add(counters.decodedBytes, decodedBytes);
+        }
+
+        void recordRetry(std::string_view endpoint, std::chrono::milliseconds backoff) {
+            Counters &counters = countersFor(endpoint);
+            add(counters.retries, 1);
+            add(counters.backoffUs, toMicros(backoff));
+        }
+
+        void recordHedge(std::string_view endpoint) { add(countersFor(endpoint).hedges, 1); }
+
+        void recordHedgeWin(std::string_view endpoint) { add(countersFor(endpoint).hedgeWins, 1); }
+
+        void reset() {
+            forEachCounters(clear);
+        }
+    } // namespace Metrics
+
+    std::vector<EndpointMetrics> endpointMetrics() {
+        std::vector<EndpointMetrics> out;
+        forEachCounters([&out](const Counters &counters) {
+            if (counters.requests.load(std::memory_order_relaxed) > 0
+                || counters.wireBytes.load(std::memory_order_relaxed) > 0) {
+                out.push_back(snapshot(counters));
+            }
+        });
+        std::ranges::sort(out, std::greater {}, &EndpointMetrics::requests);
+        return out;
+    }
+
+    std::string endpointMetricsJson() {
+        auto out = nlohmann::json::array();
+        for (const auto &metrics: endpointMetrics()) {
+            auto statuses = nlohmann::json::object();
+            for (const auto &[status, count]: metrics.statuses) {
+                statuses[std::to_string(status)] = count;
+            }
+            out.push_back({
+                {"endpoint", metrics.endpoint},
+                {"requests", metrics.requests},
+                {"sentBytes", metrics.sentBytes},
+                {"wireBytes", metrics.wireBytes},
+                {"decodedBytes", metrics.decodedBytes},
+                {"retries", metrics.retries},
+                {"hedges", metrics.hedges},
+                {"hedgeWins", metrics.hedgeWins},
+                {"backoffMs", metrics.backoffMs},
+                {"limiterWaitMs", metrics.limiterWaitMs},
+                {"statuses", std::move(statuses)},
+                {"latencyMs",
+                 {
+                     {"p50", metrics.percentileMs(0.5)},
+                     {"p90", metrics.percentileMs(0.9)},
+                     {"p99", metrics.percentileMs(0.99)},
+                     {"max", metrics.percentileMs(1.0)},
+                     {"sum", metrics.latencySumMs},
+                 }},
+            });
+        }
+        return out.dump(2);
+    }
+
+    std::string endpointMetricsPrometheus() {
+        // Coarser than the histogram itself; each bound takes every bucket that ends below it
+        constexpr double DURATION_BOUNDS[] = {0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0};
+
+        const auto all = endpointMetrics();
+        std::string out;
+
+        auto counter = [&](std::string_view name, std::string_view help, auto value) {
+            out += std::format("# HELP altman_http_{} {}\n# TYPE altman_http_{} counter\n", name, help, name);
+            for (const auto &metrics: all) {
+                out += std::format(
+                    "altman_http_{}{{endpoint=\"{}\"}} {}\n",
+                    name,
+                    prometheusLabel(metrics.endpoint),
+                    value(metrics)
+                );
+            }
+        };
+
+        out += "# HELP altman_http_responses_total Requests by status code, 0 for transport failures\n"
+               "# TYPE altman_http_responses_total counter\n";
+        for (const auto &metrics: all) {
+            for (const auto &[status, count]: metrics.statuses) {
+                out += std::format(
+                    "altman_http_responses_total{{endpoint=\"{}\",status=\"{}\"}} {}\n",
+                    prometheusLabel(metrics.endpoint),
+                    status,
+                    count
+                );
+            }
+        }
+
+        counter("sent_bytes_total", "Request body bytes", [](const EndpointMetrics &m) { return m.sentBytes; });
+        counter("wire_bytes_total", "Response bytes as received", [](const EndpointMetrics &m) { return m.wireBytes; });
+        counter("decoded_bytes_total", "Response bytes after decoding", [](const EndpointMetrics &m) {
+            return m.decodedBytes;
+        });
+        counter("retries_total", "Retried requests", [](const EndpointMetrics &m) { return m.retries; });
+        counter("hedges_total", "Hedged duplicate requests", [](const EndpointMetrics &m) { return m.hedges; });
+        counter("backoff_seconds_total", "Time slept before retries", [](const EndpointMetrics &m) {
+            return m.backoffMs / 1000.0;
+        });
+        counter("limiter_wait_seconds_total", "Time queued in the rate limiter", [](const EndpointMetrics &m) {
+            return m.limiterWaitMs / 1000.0;
+        });
+
+        out += "# HELP altman_http_request_duration_seconds Request latency\n"
+               "# TYPE altman_http_request_duration_seconds histogram\n";
+        for (const auto &metrics: all) {
+            const std::string label = prometheusLabel(metrics.endpoint);
+            uint64_t cumulative = 0;
+            size_t bucket = 0;
+            for (double bound: DURATION_BOUNDS) {
+                const auto limit = static_cast<uint64_t>(bound * 1'000'000.0);
+                for (; bucket < LatencyHistogram::BUCKETS && LatencyHistogram::upperBound(bucket) < limit; ++bucket) {
+                    cumulative += metrics.latency[bucket];
+                }
+                out += std::format(
+                    "altman_http_request_duration_seconds_bucket{{endpoint=\"{}\",le=\"{}\"}} {}\n",
+                    label,
+                    bound,
+                    cumulative
+                );
+            }
+            uint64_t total = 0;
+            for (uint64_t count: metrics.latency) {
+                total += count;
+            }
+            out += std::format(
+                "altman_http_request_duration_seconds_bucket{{endpoint=\"{}\",le=\"+Inf\"}} {}\n",
+                label,
+                total
+            );
+            out += std::format(
+                "altman_http_request_duration_seconds_sum{{endpoint=\"{}\"}} {}\n",
+                label,
+                metrics.latencySumMs / 1000.0
+            );
+            out += std::format("altman_http_request_duration_seconds_count{{endpoint=\"{}\"}} {}\n", label, total);
+        }
+        return out;
+    }
+
+} // namespace HttpClient
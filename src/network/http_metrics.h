@@ -0,0 +1,82 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace HttpClient {
+
+    // Log-linear latency histogram in the manner of HdrHistogram: 16 sub-buckets per power of two
+    // of microseconds, so any recorded value is within about 6% of its bucket's bound, from 1 us up
+    // to 35 minutes. Recording is a single relaxed atomic increment.
+    class LatencyHistogram {
+        public:
+            static constexpr size_t BUCKETS = 448;
+            using Counts = std::array<uint64_t, BUCKETS>;
+
+            void record(std::chrono::microseconds elapsed) noexcept;
+            [[nodiscard]] Counts snapshot() const noexcept;
+            void reset() noexcept;
+
+            static size_t bucketOf(uint64_t micros) noexcept;
+            // Largest value that lands in bucket, in microseconds
+            static uint64_t upperBound(size_t bucket) noexcept;
+            // Value at quantile q (0..1) of counts in milliseconds, 0 when counts is empty
+            static double percentileMs(const Counts &counts, double q) noexcept;
+
+        private:
+            std::array<std::atomic<uint64_t>, BUCKETS> m_counts {};
+    };
+
+    // Everything measured for one endpoint (host and path, numeric segments folded to {id})
+    struct EndpointMetrics {
+            std::string endpoint;
+            uint64_t requests = 0;     // sent on the wire, retries and hedges included
+            uint64_t sentBytes = 0;    // request bodies
+            uint64_t wireBytes = 0;    // responses as received
+            uint64_t decodedBytes = 0; // responses after content decoding; the gap is what compression saved
+            uint64_t retries = 0;
+            uint64_t hedges = 0;    // duplicate GETs sent because the first was slower than usual
+            uint64_t hedgeWins = 0; // ... that answered first
+            double backoffMs = 0.0;     // slept before retries
+            double limiterWaitMs = 0.0; // queued in the RateLimiter before being sent
+            std::vector<std::pair<int, uint64_t>> statuses; // by status code, 0 for transport failures
+            LatencyHistogram::Counts latency {};
+            double latencySumMs = 0.0;
+
+            [[nodiscard]] uint64_t statusCount(int from, int to) const; // codes in [from, to]
+            [[nodiscard]] double percentileMs(double q) const { return LatencyHistogram::percentileMs(latency, q); }
+    };
+
+    // Recording side, called from the request path. Every call is a lock-free lookup of the
+    // endpoint's counters followed by relaxed atomic adds; nothing allocates once an endpoint has
+    // been seen. Past 512 distinct endpoints new ones are folded into "(other)".
+    namespace Metrics {
+        void recordRequest(
+            std::string_view endpoint,
+            int status,
+            std::chrono::microseconds elapsed,
+            uint64_t sentBytes,
+            std::chrono::microseconds limiterWait
+        );
+        void recordTransfer(std::string_view endpoint, uint64_t wireBytes, uint64_t decodedBytes);
+        void recordRetry(std::string_view endpoint, std::chrono::milliseconds backoff);
+        void recordHedge(std::string_view endpoint);
+        void recordHedgeWin(std::string_view endpoint);
+        void reset();
+    } // namespace Metrics
+
+    // Most requests first
+    std::vector<EndpointMetrics> endpointMetrics();
+
+    // The same numbers for other tools: a JSON array with one object per endpoint, and the
+    // Prometheus text exposition format (altman_http_* counters and a request duration histogram)
+    std::string endpointMetricsJson();
+    std::string endpointMetricsPrometheus();
+
+} // namespace HttpClient
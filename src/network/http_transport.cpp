@@ -0,0 +1,360 @@
+#include "http_transport.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "console/console.h"
+#include "network/http.h"
+#include "utils/paths.h"
+#include "utils/shutdown_manager.h"
+
+namespace HttpClient {
+
+    namespace {
+        // Every .ROBLOSECURITY cookie value starts with this warning
+        constexpr std::string_view COOKIE_MARKER = "_|WARNING:-DO-NOT-SHARE-THIS";
+        constexpr std::string_view REDACTED = "<redacted>";
+
+        // Response headers that carry credentials
+        constexpr std::string_view SECRET_HEADERS[] = {
+            "set-cookie",
+            "x-csrf-token",
+            "rbx-authentication-ticket",
+        };
+
+        bool isCookieChar(char c) {
+            return c != '"' && c != '&' && c != ';' && c != ',' && !std::isspace(static_cast<unsigned char>(c));
+        }
+
+        std::string redactCookies(std::string text) {
+            for (size_t at = text.find(COOKIE_MARKER); at != std::string::npos;
+                 at = text.find(COOKIE_MARKER, at + REDACTED.size())) {
+                size_t end = at;
+                while (end < text.size() && isCookieChar(text[end])) {
+                    ++end;
+                }
+                text.replace(at, end - at, REDACTED);
+            }
+            return text;
+        }
+
+        std::string withoutSecretHeaders(std::string_view raw) {
+            std::string out;
+            out.reserve(raw.size());
+            while (!raw.empty()) {
+                const size_t eol = raw.find('\n');
+                const std::string_view line = raw.substr(0, eol == std::string_view::npos ? raw.size() : eol + 1);
+                raw.remove_prefix(line.size());
+
+                const std::string_view name = line.substr(0, line.find(':'));
+                const bool secret = std::ranges::any_of(SECRET_HEADERS, [name](std::string_view header) {
+                    return name.size() == header.size()
+                           && std::ranges::equal(name, header, [](char a, char b) {
+                                  return std::tolower(static_cast<unsigned char>(a)) == b;
+                              });
+                });
+                if (!secret) {
+                    out.append(line);
+                }
+            }
+            return out;
+        }
+
+        std::string exactKey(const TransportRequest &request) {
+            return request.method + ' ' + request.url + '\n' + request.body;
+        }
+
+        std::string endpointKey(const TransportRequest &request) {
+            return request.method + ' ' + request.endpoint;
+        }
+
+        class RecordingTransport final : public Transport {
+            public:
+                explicit RecordingTransport(const std::filesystem::path &path)
+                    : m_file(path, std::ios::app | std::ios::binary) {
+                    if (!m_file) {
+                        LOG_CAT_ERROR(Network, "Cannot open HTTP cassette for recording: {}", path.string());
+                    }
+                }
+
+                std::optional<cpr::Response> intercept(const TransportRequest &) override { return std::nullopt; }
+
+                void observe(const TransportRequest &request, const cpr::Response &response) override {
+                    // Transport failures say nothing about the API and would only replay as noise
+                    if (response.status_code == 0) {
+                        return;
+                    }
+                    const nlohmann::json entry = {
+                        {"method", request.method},
+                        {"url", redactCookies(request.url)},
+                        {"endpoint", request.endpoint},
+                        {"body", redactCookies(request.body)},
+                        {"status", response.status_code},
+                        {"headers", withoutSecretHeaders(response.raw_header)},
+                        {"response", redactCookies(response.text)},
+                        {"elapsedMs", static_cast<int64_t>(response.elapsed * 1000.0)},
+                    };
+                    const std::string line = entry.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+
+                    std::lock_guard lock(m_mutex);
+                    m_file << line << '\n';
+                    m_file.flush();
+                }
+
+            private:
+                std::mutex m_mutex;
+                std::ofstream m_file;
+        };
+
+        struct Interaction {
+                long status = 0;
+                std::string headers;
+                std::string response;
+                std::chrono::milliseconds elapsed {0};
+        };
+
+        // How often a replayed delay looks at the request's deadline, its CancelScope and shutdown
+        constexpr auto REPLAY_SLICE = std::chrono::milliseconds(50);
+
+        // Recordings sharing a key, handed out in turn
+        struct Track {
+                std::vector<const Interaction *> interactions;
+                size_t next = 0;
+        };
+
+        class ReplayTransport final : public Transport {
+            public:
+                ReplayTransport(const std::filesystem::path &path, FaultProfile faults)
+                    : m_faults(faults) {
+                    std::ifstream file(path, std::ios::binary);
+                    if (!file) {
+                        LOG_CAT_ERROR(Network, "Cannot open HTTP cassette for replay: {}", path.string());
+                        return;
+                    }
+
+                    std::string line;
+                    size_t skipped = 0;
+                    while (std::getline(file, line)) {
+                        if (line.empty()) {
+                            continue;
+                        }
+                        const auto entry = nlohmann::json::parse(line, nullptr, false);
+                        if (entry.is_discarded() || !entry.is_object()) {
+                            ++skipped;
+                            continue;
+                        }
+                        const TransportRequest request {
+                            entry.value("method", ""),
+                            entry.value("url", ""),
+                            entry.value("endpoint", ""),
+                            entry.value("body", ""),
+                        };
+                        m_interactions.push_back(std::make_unique<Interaction>(Interaction {
+                            entry.value("status", 0L),
+                            entry.value("headers", ""),
+                            entry.value("response", ""),
+                            std::chrono::milliseconds(entry.value("elapsedMs", 0)),
+                        }));
+                        m_exact[exactKey(request)].interactions.push_back(m_interactions.back().get());
+                        m_byEndpoint[endpointKey(request)].interactions.push_back(m_interactions.back().get());
+                    }
+                    LOG_CAT_INFO(
+                        Network,
+                        "Replaying {} recorded requests from {} ({} unreadable lines)",
+                        m_interactions.size(),
+                        path.string(),
+                        skipped
+                    );
+                }
+
+                std::optional<cpr::Response> intercept(const TransportRequest &request) override {
+                    cpr::Response r;
+                    r.url = cpr::Url {request.url};
+
+                    const Interaction *interaction = find(request);
+                    if (!interaction) {
+                        LOG_EVENT(Network, Warn, "net.replay_miss", {"method", request.method}, {"url", request.url});
+                        r.error.code = cpr::ErrorCode::UNSUPPORTED_PROTOCOL;
+                        r.error.message = "no recorded response for " + request.method + ' ' + request.url;
+                        return r;
+                    }
+
+                    std::chrono::milliseconds delay = m_faults.latency.value_or(interaction->elapsed);
+                    std::uniform_real_distribution<double> unit(0.0, 1.0);
+                    double fault = 0.0;
+                    {
+                        std::lock_guard lock(m_randomMutex);
+                        if (m_faults.jitter > std::chrono::milliseconds::zero()) {
+                            delay += std::chrono::milliseconds(static_cast<int64_t>(
+                                unit(m_random) * static_cast<double>(m_faults.jitter.count())
+                            ));
+                        }
+                        fault = unit(m_random);
+                    }
+                    // Waited out the way a real transfer would be: cut short by the deadline, a cancel or shutdown
+                    const auto start = DeadlineScope::Clock::now();
+                    const auto deadline = currentDeadline();
+                    for (auto left = delay; left > std::chrono::milliseconds::zero();) {
+                        const auto now = DeadlineScope::Clock::now();
+                        if (now >= deadline) {
+                            r.error.code = cpr::ErrorCode::OPERATION_TIMEDOUT;
+                            r.error.message = "replayed response took longer than the request's deadline";
+                            r.elapsed = std::chrono::duration<double>(now - start).count();
+                            return r;
+                        }
+                        const auto untilDeadline = std::chrono::ceil<std::chrono::milliseconds>(deadline - now);
+                        const auto slice = std::min({left, REPLAY_SLICE, untilDeadline});
+                        if (ShutdownManager::instance().sleepFor(slice)) {
+                            r.error.code = cpr::ErrorCode::ABORTED_BY_CALLBACK;
+                            r.error.message = "shutting down";
+                            return r;
+                        }
+                        if (cancellationRequested()) {
+                            r.error.code = cpr::ErrorCode::ABORTED_BY_CALLBACK;
+                            r.error.message = "cancelled by the caller";
+                            r.elapsed = std::chrono::duration<double>(DeadlineScope::Clock::now() - start).count();
+                            return r;
+                        }
+                        left -= slice;
+                    }
+
+                    r.elapsed = std::chrono::duration<double>(delay).count();
+                    if (fault < m_faults.rateLimited) {
+                        r.status_code = 429;
+                        r.text = R"({"errors":[{"code":0,"message":"TooManyRequests"}]})";
+                    } else if (fault < m_faults.rateLimited + m_faults.serverError) {
+                        r.status_code = 503;
+                    } else {
+                        r.status_code = interaction->status;
+                        r.raw_header = interaction->headers;
+                        r.text = interaction->response;
+                    }
+                    r.downloaded_bytes = static_cast<long>(r.text.size());
+                    return r;
+                }
+
+                void observe(const TransportRequest &, const cpr::Response &) override {}
+
+                [[nodiscard]] bool offline() const override { return true; }
+
+            private:
+                const Interaction *find(const TransportRequest &request) {
+                    std::lock_guard lock(m_mutex);
+                    auto it = m_exact.find(exactKey(request));
+                    if (it == m_exact.end()) {
+                        it = m_byEndpoint.find(endpointKey(request));
+                        if (it == m_byEndpoint.end()) {
+                            return nullptr;
+                        }
+                    }
+                    Track &track = it->second;
+                    const Interaction *interaction = track.interactions[track.next];
+                    track.next = (track.next + 1) % track.interactions.size();
+                    return interaction;
+                }
+
+                FaultProfile m_faults;
+                std::vector<std::unique_ptr<Interaction>> m_interactions;
+
+                std::mutex m_mutex;
+                std::unordered_map<std::string, Track> m_exact;
+                std::unordered_map<std::string, Track> m_byEndpoint;
+
+                std::mutex m_randomMutex;
+                std::mt19937 m_random {std::random_device {}()};
+        };
+
+        FaultProfile parseFaults(std::string_view spec) {
+            FaultProfile faults;
+            while (!spec.empty()) {
+                const size_t comma = spec.find(',');
+                const std::string_view item = spec.substr(0, comma);
+                spec.remove_prefix(comma == std::string_view::npos ? spec.size() : comma + 1);
+
+                const size_t eq = item.find('=');
+                if (eq == std::string_view::npos) {
+                    continue;
+                }
+                const std::string_view name = item.substr(0, eq);
+                const std::string_view value = item.substr(eq + 1);
+                // Floating-point from_chars is missing from the macOS 13.3 runtime. strtod needs a
+                // terminated string and skips leading spaces, so it gets a copy and both ends are checked.
+                const std::string copy(value);
+                char *end = nullptr;
+                const double number = copy.empty() ? 0.0 : std::strtod(copy.c_str(), &end);
+                if (copy.empty() || std::isspace(static_cast<unsigned char>(copy.front()))
+                    || end != copy.c_str() + copy.size()) {
+                    LOG_CAT_WARN(Network, "Ignoring malformed HTTP fault '{}'", item);
+                    continue;
+                }
+
+                if (name == "latency") {
+                    faults.latency = std::chrono::milliseconds(static_cast<int64_t>(number));
+                } else if (name == "jitter") {
+                    faults.jitter = std::chrono::milliseconds(static_cast<int64_t>(number));
+                } else if (name == "429") {
+                    faults.rateLimited = std::clamp(number, 0.0, 1.0);
+                } else if (name == "5xx") {
+                    faults.serverError = std::clamp(number, 0.0, 1.0);
+                } else {
+                    LOG_CAT_WARN(Network, "Ignoring unknown HTTP fault '{}'", name);
+                }
+            }
+            return faults;
+        }
+
+        std::atomic<Transport *> g_transport {nullptr};
+    } // namespace
+
+    std::unique_ptr<Transport> makeRecordingTransport(const std::filesystem::path &path) {
+        return std::make_unique<RecordingTransport>(path);
+    }
+
+    std::unique_ptr<Transport> makeReplayTransport(const std::filesystem::path &path, FaultProfile faults) {
+        return std::make_unique<ReplayTransport>(path, faults);
+    }
+
+    void setTransport(std::unique_ptr<Transport> transport) {
+        // The previous transport is deliberately leaked, see the header
+        g_transport.store(transport.release(), std::memory_order_release);
+    }
+
+    Transport *activeTransport() { return g_transport.load(std::memory_order_acquire); }
+
+    void configureTransportFromEnvironment() {
+        const char *mode = std::getenv("ALTMAN_HTTP_MODE");
+        if (!mode || !*mode) {
+            return;
+        }
+
+        std::filesystem::path cassette;
+        if (const char *path = std::getenv("ALTMAN_HTTP_CASSETTE"); path && *path) {
+            cassette = path;
+        } else {
+            cassette = AltMan::Paths::Config("http_cassette.jsonl");
+        }
+
+        const std::string_view name = mode;
+        if (name == "record") {
+            setTransport(makeRecordingTransport(cassette));
+        } else if (name == "replay") {
+            const char *faults = std::getenv("ALTMAN_HTTP_FAULTS");
+            setTransport(makeReplayTransport(cassette, parseFaults(faults ? faults : "")));
+        } else {
+            LOG_CAT_WARN(Network, "Unknown ALTMAN_HTTP_MODE '{}', using the network", name);
+            return;
+        }
+        LOG_EVENT(Network, Info, "net.transport", {"mode", std::string(name)}, {"cassette", cassette.string()});
+    }
+
+} // namespace HttpClient
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <cpr/cpr.h>
+
+namespace HttpClient {
+
+    // One API request as seen by a Transport. url includes the encoded query parameters; endpoint is
+    // the url's host and path with numeric segments folded to {id}, as in transferStats().
+    struct TransportRequest {
+            std::string method;
+            std::string url;
+            std::string endpoint;
+            std::string body;
+    };
+
+    // Seam between perform() and the network. A transport can answer a request itself, which is how
+    // replay works, or just watch what the network answered, which is how recording works. Only API
+    // requests pass through it; file downloads always go to the network.
+    class Transport {
+        public:
+            virtual ~Transport() = default;
+
+            // A response to use instead of the network, or nullopt to let the request through. Runs
+            // inside a DeadlineScope holding the request's budget; anything that waits should give up
+            // at currentDeadline() and at shutdown.
+            virtual std::optional<cpr::Response> intercept(const TransportRequest &request) = 0;
+            // Called with the network's answer to every request intercept() let through
+            virtual void observe(const TransportRequest &request, const cpr::Response &response) = 0;
+            // True when nothing should reach the network at all, e.g. connection pre-warming
+            [[nodiscard]] virtual bool offline() const { return false; }
+    };
+
+    // Failures and latency added to replayed responses
+    struct FaultProfile {
+            std::optional<std::chrono::milliseconds> latency; // instead of the recorded time
+            std::chrono::milliseconds jitter {0};              // uniformly added on top
+            double rateLimited = 0.0;                          // chance of a 429 instead of the recording
+            double serverError = 0.0;                          // chance of a 503 instead of the recording
+    };
+
+    // Appends every interaction to path as one JSON object per line. Cookies, CSRF tokens and
+    // authentication tickets are stripped from headers, and anything that looks like a
+    // .ROBLOSECURITY value is masked in URLs and bodies, so cassettes can be shared.
+    std::unique_ptr<Transport> makeRecordingTransport(const std::filesystem::path &path);
+
+    // Answers every request from a cassette written by the recording transport and never touches the
+    // network. A request is matched on method, URL and body first, then on method and endpoint alone,
+    // so a cassette made with a few accounts can stand in for any number of them. Repeated matches
+    // cycle through the recordings in order. Unmatched requests fail with a transport error.
+    std::unique_ptr<Transport> makeReplayTransport(const std::filesystem::path &path, FaultProfile faults = {});
+
+    // Installs the process-wide transport, nullptr for the plain network. Meant for startup: a
+    // replaced transport is never freed, since requests on other threads may still hold it.
+    void setTransport(std::unique_ptr<Transport> transport);
+    Transport *activeTransport();
+
+    // Reads ALTMAN_HTTP_MODE ("record" or "replay"), ALTMAN_HTTP_CASSETTE (the cassette file,
+    // http_cassette.jsonl in the config directory by default) and, for replay, ALTMAN_HTTP_FAULTS,
+    // e.g. "latency=120,jitter=40,429=0.05,5xx=0.02" (milliseconds and probabilities). Does nothing
+    // when ALTMAN_HTTP_MODE is unset.
+    void configureTransportFromEnvironment();
+
+} // namespace HttpClient
@@ -0,0 +1,271 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace HttpClient {
+
+    // One scalar handed to a streaming decoder. text points into the parser's buffer and is only valid
+    // during the callback, so take() it to keep it.
+    struct JsonScalar {
+            enum class Kind {
+                Null,
+                Bool,
+                Int,
+                Uint,
+                Float,
+                String
+            };
+
+            Kind kind = Kind::Null;
+            bool boolean = false;
+            int64_t integer = 0;
+            uint64_t unsignedInteger = 0;
+            double number = 0.0;
+            std::string *text = nullptr;
+
+            [[nodiscard]] bool isNull() const { return kind == Kind::Null; }
+            [[nodiscard]] bool isString() const { return kind == Kind::String; }
+            [[nodiscard]] bool isNumber() const {
+                return kind == Kind::Int || kind == Kind::Uint || kind == Kind::Float;
+            }
+
+            [[nodiscard]] bool asBool(bool fallback = false) const {
+                return kind == Kind::Bool ? boolean : fallback;
+            }
+
+            [[nodiscard]] uint64_t asUint(uint64_t fallback = 0) const {
+                switch (kind) {
+                    case Kind::Uint: return unsignedInteger;
+                    case Kind::Int: return integer >= 0 ? static_cast<uint64_t>(integer) : fallback;
+                    case Kind::Float: return number >= 0.0 ? static_cast<uint64_t>(number) : fallback;
+                    default: return fallback;
+                }
+            }
+
+            [[nodiscard]] int64_t asInt64(int64_t fallback = 0) const {
+                switch (kind) {
+                    case Kind::Uint: return static_cast<int64_t>(unsignedInteger);
+                    case Kind::Int: return integer;
+                    case Kind::Float: return static_cast<int64_t>(number);
+                    default: return fallback;
+                }
+            }
+
+            [[nodiscard]] int asInt(int fallback = 0) const { return static_cast<int>(asInt64(fallback)); }
+
+            [[nodiscard]] double asDouble(double fallback = 0.0) const {
+                switch (kind) {
+                    case Kind::Uint: return static_cast<double>(unsignedInteger);
+                    case Kind::Int: return static_cast<double>(integer);
+                    case Kind::Float: return number;
+                    default: return fallback;
+                }
+            }
+
+            // Moves the string out of the parser; non-strings give an empty string
+            [[nodiscard]] std::string take() const { return kind == Kind::String ? std::move(*text) : std::string {}; }
+
+            // Stores the value into a scalar member, converting numbers as needed. Nulls and
+            // non-scalar members are left untouched, as JsonFields::read() leaves them.
+            template<typename M>
+            void into(M &out) const {
+                if (kind == Kind::Null) {
+                    return;
+                }
+                if constexpr (std::is_same_v<M, std::string>) {
+                    out = take();
+                } else if constexpr (std::is_same_v<M, bool>) {
+                    out = asBool(out);
+                } else if constexpr (std::is_floating_point_v<M>) {
+                    out = static_cast<M>(asDouble(out));
+                } else if constexpr (std::is_integral_v<M> && std::is_unsigned_v<M>) {
+                    out = static_cast<M>(asUint(out));
+                } else if constexpr (std::is_integral_v<M>) {
+                    out = static_cast<M>(asInt64(out));
+                }
+            }
+    };
+
+    // Base for typed streaming decoders over nlohmann's SAX interface. No DOM is built: the derived
+    // decoder fills its result struct straight from the token stream, matching where it is with at().
+    //
+    // Derived implements any of
+    //     void value(const JsonScalar &v);  // a scalar at the current path
+    //     void enter();                     // an object or array starts at the current path
+    //     void leave();                     // ... and ends
+    //
+    // Paths are written as the keys leading to a value with "[]" for each array level, so the id of
+    // every server in a page is at({"data", "[]", "id"}). Key buffers are reused between siblings,
+    // so walking a large page allocates little beyond the strings kept in the result.
+    template<typename Derived>
+    class SaxDecoder {
+        public:
+            using json = nlohmann::json;
+
+            bool null() { return scalar({}); }
+
+            bool boolean(bool v) {
+                JsonScalar s;
+                s.kind = JsonScalar::Kind::Bool;
+                s.boolean = v;
+                return scalar(s);
+            }
+
+            bool number_integer(json::number_integer_t v) {
+                JsonScalar s;
+                s.kind = JsonScalar::Kind::Int;
+                s.integer = v;
+                return scalar(s);
+            }
+
+            bool number_unsigned(json::number_unsigned_t v) {
+                JsonScalar s;
+                s.kind = JsonScalar::Kind::Uint;
+                s.unsignedInteger = v;
+                return scalar(s);
+            }
+
+            bool number_float(json::number_float_t v, const json::string_t &) {
+                JsonScalar s;
+                s.kind = JsonScalar::Kind::Float;
+                s.number = v;
+                return scalar(s);
+            }
+
+            bool string(json::string_t &v) {
+                JsonScalar s;
+                s.kind = JsonScalar::Kind::String;
+                s.text = &v;
+                return scalar(s);
+            }
+
+            bool binary(json::binary_t &) { return true; }
+
+            bool start_object(std::size_t) {
+                self().enter();
+                push(false);
+                return true;
+            }
+
+            bool end_object() {
+                pop();
+                self().leave();
+                return true;
+            }
+
+            bool start_array(std::size_t) {
+                self().enter();
+                push(true);
+                return true;
+            }
+
+            bool end_array() {
+                pop();
+                self().leave();
+                return true;
+            }
+
+            bool key(json::string_t &k) {
+                m_frames[m_depth - 1].key.assign(k);
+                return true;
+            }
+
+            bool parse_error(std::size_t, const std::string &, const nlohmann::detail::exception &e) {
+                m_error = e.what();
+                return false;
+            }
+
+            [[nodiscard]] const std::string &error() const { return m_error; }
+            void fail(std::string message) { m_error = std::move(message); }
+
+            // Hooks a decoder does not need
+            void value(const JsonScalar &) {}
+            void enter() {}
+            void leave() {}
+
+        protected:
+            SaxDecoder() { m_frames.resize(8); }
+
+            // Whether the value being reported sits exactly at path
+            [[nodiscard]] bool at(std::initializer_list<std::string_view> path) const {
+                if (path.size() != m_depth) {
+                    return false;
+                }
+                size_t i = 0;
+                for (auto part: path) {
+                    const Frame &frame = m_frames[i++];
+                    if (frame.array ? part != "[]" : part != frame.key) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            [[nodiscard]] size_t depth() const { return m_depth; }
+
+            // Key of the value being reported when it is a direct member of the object at path,
+            // otherwise empty; pairs with JsonFields::visit() to map members by name
+            [[nodiscard]] std::string_view memberOf(std::initializer_list<std::string_view> path) const {
+                if (m_depth != path.size() + 1) {
+                    return {};
+                }
+                size_t i = 0;
+                for (auto part: path) {
+                    const Frame &frame = m_frames[i++];
+                    if (frame.array ? part != "[]" : part != frame.key) {
+                        return {};
+                    }
+                }
+                const Frame &last = m_frames[m_depth - 1];
+                return last.array ? std::string_view {} : std::string_view(last.key);
+            }
+
+        private:
+            struct Frame {
+                    bool array = false;
+                    std::string key;
+            };
+
+            Derived &self() { return static_cast<Derived &>(*this); }
+
+            bool scalar(const JsonScalar &s) {
+                self().value(s);
+                return true;
+            }
+
+            void push(bool array) {
+                if (m_depth == m_frames.size()) {
+                    m_frames.resize(m_frames.size() * 2);
+                }
+                m_frames[m_depth].array = array;
+                m_frames[m_depth].key.clear();
+                ++m_depth;
+            }
+
+            void pop() { --m_depth; }
+
+            std::vector<Frame> m_frames;
+            size_t m_depth = 0;
+            std::string m_error;
+    };
+
+    // Streams text through decoder. On malformed input decoder.error() says why and whatever was
+    // decoded before it is left in place for the caller to discard.
+    template<typename Decoder>
+    bool saxDecode(std::string_view text, Decoder &decoder) {
+        if (text.empty()) {
+            decoder.fail("empty response");
+            return false;
+        }
+        return nlohmann::json::sax_parse(text, &decoder);
+    }
+
+} // namespace HttpClient
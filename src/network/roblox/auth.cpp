@@ -22,7 +22,7 @@ namespace Roblox {
     } // namespace
 
     BanInfo checkBanStatus(const std::string &cookie) {
-        LOG_INFO("Checking moderation status");
+        LOG_EVENT(Auth, Debug, "auth.moderation_check");
 
         HttpClient::Response response = HttpClient::rateLimitedGet(
             "https://usermoderation.roblox.com/v1/not-approved",
@@ -32,7 +32,7 @@ namespace Roblox {
         );
 
         if (response.status_code < 200 || response.status_code >= 300) {
-            LOG_ERROR("Failed moderation check: HTTP {}", response.status_code);
+            LOG_EVENT(Auth, Error, "auth.moderation_failed", {"status", response.status_code});
 
             if (response.status_code == 401 || response.status_code == 403) {
                 return {BanCheckResult::InvalidCookie, 0, 0};
@@ -76,7 +76,7 @@ namespace Roblox {
     }
 
     RestrictionInfo checkRestrictionStatus(const std::string &cookie) {
-        LOG_INFO("Checking restriction status");
+        LOG_EVENT(Auth, Debug, "auth.restriction_check");
 
         HttpClient::Response response = HttpClient::rateLimitedGet(
             "https://usermoderation.roblox.com/v2/not-approved",
@@ -84,7 +84,7 @@ namespace Roblox {
         );
 
         if (response.status_code < 200 || response.status_code >= 300) {
-            LOG_ERROR("Failed restriction check: HTTP {}", response.status_code);
+            LOG_EVENT(Auth, Error, "auth.restriction_failed", {"status", response.status_code});
 
             if (response.status_code == 401 || response.status_code == 403) {
                 return {RestrictionCheckResult::InvalidCookie, 0, 0, 0, 0};
@@ -192,7 +192,7 @@ namespace Roblox {
             };
         }
 
-        LOG_INFO("Fetching profile info");
+        LOG_EVENT(Auth, Debug, "auth.profile_fetch");
 
         HttpClient::Response response = HttpClient::rateLimitedGet(
             "https://users.roblox.com/v1/users/authenticated",
@@ -202,7 +202,7 @@ namespace Roblox {
         );
 
         if (response.status_code < 200 || response.status_code >= 300) {
-            LOG_ERROR("Failed to fetch user info: HTTP {}", response.status_code);
+            LOG_EVENT(Auth, Error, "auth.profile_failed", {"status", response.status_code});
             return nlohmann::json::object();
         }
 
@@ -229,7 +229,7 @@ namespace Roblox {
             return *cached;
         }
 
-        LOG_INFO("Fetching profile info");
+        LOG_EVENT(Auth, Debug, "auth.profile_fetch");
 
         HttpClient::Response response = HttpClient::rateLimitedGet(
             "https://users.roblox.com/v1/users/authenticated",
@@ -239,8 +239,8 @@ namespace Roblox {
         );
 
         if (response.status_code < 200 || response.status_code >= 300) {
-            LOG_ERROR("Failed to fetch user info: HTTP {}", response.status_code);
-            return std::unexpected(httpStatusToError(response.status_code));
+            LOG_EVENT(Auth, Error, "auth.profile_failed", {"status", response.status_code});
+            return std::unexpected(httpStatusToError(response));
         }
 
         auto j = HttpClient::decode(response);
@@ -297,6 +297,16 @@ namespace Roblox {
 
         //result.ageGroup = getAgeGroup(cookie);
 
+        LOG_EVENT(
+            Accounts,
+            Debug,
+            "account.info",
+            {"userId", result.userId},
+            {"ban", static_cast<int>(result.banInfo.status)},
+            {"restriction", static_cast<int>(result.restrictionInfo.status)},
+            {"voice", result.voiceSettings.status}
+        );
+
         return result;
     }
 
@@ -320,18 +330,18 @@ namespace Roblox {
             return "";
         }
 
-        LOG_INFO("Fetching authentication ticket");
+        LOG_CAT_INFO(Auth, "Fetching authentication ticket");
 
         auto response = authenticatedPost("https://auth.roblox.com/v1/authentication-ticket", cookie);
 
         if (response.status_code < 200 || response.status_code >= 300) {
-            LOG_ERROR("Failed to fetch auth ticket: HTTP {}", response.status_code);
+            LOG_CAT_ERROR(Auth, "Failed to fetch auth ticket: HTTP {}", response.status_code);
             return "";
         }
 
         auto ticket = response.headers.find("rbx-authentication-ticket");
         if (ticket == response.headers.end()) {
-            LOG_ERROR("Failed to get authentication ticket from response headers");
+            LOG_CAT_ERROR(Auth, "Failed to get authentication ticket from response headers");
             return "";
         }
 
@@ -345,7 +355,7 @@ namespace Roblox {
 
         auto assertionResult = Hba::fetchClientAssertion(cookie);
         if (!assertionResult) {
-            LOG_ERROR("Failed to fetch client assertion: {}", apiErrorToString(assertionResult.error()));
+            LOG_CAT_ERROR(Auth, "Failed to fetch client assertion: {}", apiErrorToString(assertionResult.error()));
             return "";
         }
 
@@ -354,7 +364,7 @@ namespace Roblox {
 
         auto tokenResult = Hba::buildBoundAuthToken(cookie, url, body);
         if (!tokenResult) {
-            LOG_ERROR("Failed to build bound auth token for auth ticket");
+            LOG_CAT_ERROR(Auth, "Failed to build bound auth token for auth ticket");
             return "";
         }
 
@@ -368,13 +378,13 @@ namespace Roblox {
         );
 
         if (response.status_code < 200 || response.status_code >= 300) {
-            LOG_ERROR("Failed to fetch auth ticket: HTTP {}", response.status_code);
+            LOG_CAT_ERROR(Auth, "Failed to fetch auth ticket: HTTP {}", response.status_code);
             return "";
         }
 
         auto it = response.headers.find("rbx-authentication-ticket");
         if (it == response.headers.end()) {
-            LOG_ERROR("Failed to get authentication ticket from response headers");
+            LOG_CAT_ERROR(Auth, "Failed to get authentication ticket from response headers");
             return "";
         }
 
@@ -401,11 +411,11 @@ namespace Roblox {
             return std::unexpected(validationError);
         }
 
-        LOG_INFO("Refreshing cookie");
+        LOG_CAT_INFO(Auth, "Refreshing cookie");
 
         auto intentResult = Hba::buildSecureAuthIntent(cookie);
         if (!intentResult) {
-            LOG_ERROR("Failed to build secure auth intent");
+            LOG_CAT_ERROR(Auth, "Failed to build secure auth intent");
             return std::unexpected(intentResult.error());
         }
 
@@ -430,8 +440,8 @@ namespace Roblox {
         );
 
         if (response.status_code < 200 || response.status_code >= 300) {
-            LOG_ERROR("Cookie refresh failed: HTTP {}", response.status_code);
-            return std::unexpected(httpStatusToError(response.status_code));
+            LOG_CAT_ERROR(Auth, "Cookie refresh failed: HTTP {}", response.status_code);
+            return std::unexpected(httpStatusToError(response));
         }
 
         auto it = response.headers.find("set-cookie");
@@ -453,7 +463,7 @@ namespace Roblox {
             return std::unexpected(ApiError::InvalidResponse);
         }
 
-        LOG_INFO("Cookie refreshed successfully");
+        LOG_CAT_INFO(Auth, "Cookie refreshed successfully");
         invalidateCacheForCookie(cookie);
         return newCookie;
     }
@@ -14,8 +14,6 @@
 
 #include "network/http.h"
 
-struct ImVec4;
-
 namespace Roblox {
 
     enum class ApiError {
@@ -24,6 +22,8 @@ namespace Roblox {
         NetworkError,
         Timeout,
         ConnectionFailed,
+        ProxyUnavailable,
+        Cancelled,
 
         BadRequest,
         InvalidCookie,
@@ -53,6 +53,10 @@ namespace Roblox {
                 return "Request timed out";
             case ApiError::ConnectionFailed:
                 return "Connection failed";
+            case ApiError::ProxyUnavailable:
+                return "Account's proxy is unavailable";
+            case ApiError::Cancelled:
+                return "Cancelled";
             case ApiError::InvalidCookie:
                 return "Invalid or expired cookie";
             case ApiError::CookieBanned:
@@ -118,6 +122,19 @@ namespace Roblox {
         return ApiError::Unknown;
     }
 
+    // Like httpStatusToError, but a request that never got a status reports why
+    inline ApiError httpStatusToError(const HttpClient::Response &response) {
+        switch (response.transport) {
+            case HttpClient::TransportError::None: break;
+            case HttpClient::TransportError::Timeout: return ApiError::Timeout;
+            case HttpClient::TransportError::Cancelled: return ApiError::Cancelled;
+            case HttpClient::TransportError::ConnectionFailed: return ApiError::ConnectionFailed;
+            case HttpClient::TransportError::EgressUnavailable: return ApiError::ProxyUnavailable;
+            case HttpClient::TransportError::Other: return ApiError::NetworkError;
+        }
+        return httpStatusToError(response.status_code);
+    }
+
     template <typename T>
     using ApiResult = std::expected<T, ApiError>;
 
@@ -286,8 +303,6 @@ namespace Roblox {
 
 } // namespace Roblox
 
-ImVec4 getStatusColor(const std::string& statusCode);
-
 std::string generateSessionId();
 std::string presenceTypeToString(int type);
 std::string urlEncode(const std::string &s);
@@ -324,6 +339,7 @@ struct PublicServerInfo {
         int maximumPlayers = 0;
         double averagePing = 0.0;
         double averageFps = 0.0;
+        std::vector<std::string> playerTokens; // opaque, resolvable to headshots only
 };
 
 struct GameInfo {
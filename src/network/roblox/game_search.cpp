@@ -0,0 +1,238 @@
+#include "game_search.h"
+
+#include <algorithm>
+#include <cctype>
+
+#include "games.h"
+#include "utils/worker_thread.h"
+
+namespace Roblox {
+
+    namespace {
+        constexpr auto DEBOUNCE = std::chrono::milliseconds(300);
+        constexpr size_t MAX_PAGES = 5;
+        constexpr size_t CACHE_CAPACITY = 16;
+
+        std::string normalizeQuery(std::string_view query) {
+            query = trim_view(query);
+            std::string out;
+            out.reserve(query.size());
+            bool space = false;
+            for (unsigned char c: query) {
+                if (std::isspace(c)) {
+                    space = true;
+                    continue;
+                }
+                if (space) {
+                    out.push_back(' ');
+                    space = false;
+                }
+                out.push_back(static_cast<char>(std::tolower(c)));
+            }
+            return out;
+        }
+
+        bool nameContains(const std::string &name, std::string_view key) {
+            const auto it = std::search(name.begin(), name.end(), key.begin(), key.end(), [](char a, char b) {
+                return std::tolower(static_cast<unsigned char>(a)) == b;
+            });
+            return it != name.end();
+        }
+    } // namespace
+
+    GameSearch::GameSearch()
+        : m_shared(std::make_shared<Shared>()) {}
+
+    void GameSearch::setQuery(std::string_view query) {
+        m_typed = normalizeQuery(query);
+        m_typedAt = Clock::now();
+        m_dirty = true;
+    }
+
+    void GameSearch::submit(std::string_view query) {
+        m_typed = normalizeQuery(query);
+        m_dirty = false;
+        start(m_typed);
+    }
+
+    void GameSearch::clear() {
+        m_typed.clear();
+        m_dirty = false;
+        start({});
+    }
+
+    void GameSearch::update() {
+        if (m_dirty && Clock::now() - m_typedAt >= DEBOUNCE) {
+            m_dirty = false;
+            if (m_typed != m_active) {
+                start(m_typed);
+            }
+        }
+    }
+
+    uint64_t GameSearch::version() const {
+        std::lock_guard lock(m_shared->mutex);
+        return m_shared->version;
+    }
+
+    GameSearch::Snapshot GameSearch::snapshot() const {
+        std::lock_guard lock(m_shared->mutex);
+        return m_shared->current;
+    }
+
+    GameSearch::CacheEntry *GameSearch::findEntry(Shared &shared, const std::string &key) {
+        const auto it = std::ranges::find(shared.lru, key, &CacheEntry::key);
+        return it == shared.lru.end() ? nullptr : &*it;
+    }
+
+    GameSearch::CacheEntry &GameSearch::touchEntry(Shared &shared, const std::string &key) {
+        if (const auto it = std::ranges::find(shared.lru, key, &CacheEntry::key); it != shared.lru.end()) {
+            shared.lru.splice(shared.lru.begin(), shared.lru, it);
+            return shared.lru.front();
+        }
+
+        CacheEntry entry;
+        entry.key = key;
+        entry.sessionId = generateSessionId();
+        shared.lru.push_front(std::move(entry));
+        if (shared.lru.size() > CACHE_CAPACITY) {
+            shared.lru.pop_back();
+        }
+        return shared.lru.front();
+    }
+
+    void GameSearch::start(std::string key) {
+        m_active = key;
+
+        {
+            std::lock_guard lock(m_shared->mutex);
+            ++m_shared->version;
+            m_shared->current = Snapshot {};
+            m_shared->current.query = key;
+
+            // Whatever is loading for another query is superseded; abort its transfer now
+            for (auto &other: m_shared->lru) {
+                if (other.fetching && other.key != key) {
+                    other.cancel->store(true, std::memory_order_relaxed);
+                }
+            }
+            if (key.empty()) {
+                return;
+            }
+
+            const bool cached = findEntry(*m_shared, key) != nullptr;
+            CacheEntry &entry = touchEntry(*m_shared, key);
+            if (cached) {
+                m_shared->current.games = entry.games;
+                if (entry.complete) {
+                    return;
+                }
+            } else {
+                // Show what a cached shorter query already knows while this one loads
+                const CacheEntry *best = nullptr;
+                for (const auto &candidate: m_shared->lru) {
+                    if (&candidate != &entry && !candidate.games.empty() && key.starts_with(candidate.key)
+                        && (!best || candidate.key.size() > best->key.size())) {
+                        best = &candidate;
+                    }
+                }
+                if (best) {
+                    for (const auto &game: best->games) {
+                        if (nameContains(game.name, key)) {
+                            m_shared->current.games.push_back(game);
+                        }
+                    }
+                    m_shared->current.provisional = true;
+                }
+            }
+            m_shared->current.loading = true;
+
+            // Back to a query whose fetch has not finished unwinding: that fetch carries on with a
+            // fresh flag rather than a second one racing it over the entry's pages
+            const bool resume = entry.fetching;
+            if (!entry.cancel || entry.cancel->load(std::memory_order_relaxed)) {
+                entry.cancel = std::make_shared<std::atomic<bool>>(false);
+            }
+            entry.fetching = true;
+            if (resume) {
+                return;
+            }
+        }
+
+        WorkerThreads::runBackground(fetchPages, m_shared, std::move(key));
+    }
+
+    void GameSearch::fetchPages(const std::shared_ptr<Shared> &shared, std::string key) {
+        while (!ShutdownManager::instance().isShuttingDown()) {
+            std::string token;
+            std::string sessionId;
+            std::shared_ptr<std::atomic<bool>> cancel;
+            {
+                std::lock_guard lock(shared->mutex);
+                CacheEntry *entry = findEntry(*shared, key);
+                if (!entry) {
+                    return;
+                }
+                if (shared->current.query != key || entry->complete) {
+                    entry->fetching = false;
+                    return;
+                }
+                token = entry->nextPageToken;
+                sessionId = entry->sessionId;
+                cancel = entry->cancel;
+            }
+
+            auto page = [&] {
+                HttpClient::CancelScope scope(*cancel);
+                return searchGamesPage(key, token, sessionId);
+            }();
+
+            std::lock_guard lock(shared->mutex);
+            const bool current = shared->current.query == key;
+            CacheEntry *entry = findEntry(*shared, key);
+
+            if (!page || !entry) {
+                // Cancelled and then searched for again: the loop picks the page up where it left off
+                if (entry && current && page.error() == ApiError::Cancelled) {
+                    continue;
+                }
+                if (entry) {
+                    entry->fetching = false;
+                }
+                if (current) {
+                    shared->current.loading = false;
+                    if (!page && page.error() != ApiError::Cancelled) {
+                        shared->current.error = std::string(apiErrorToString(page.error()));
+                    }
+                    ++shared->version;
+                }
+                return;
+            }
+
+            // A superseded query still fills its cache entry with a page that arrived before the abort
+            for (auto &game: page->games) {
+                if (entry->seen.insert(game.universeId).second) {
+                    entry->games.push_back(std::move(game));
+                }
+            }
+            ++entry->pages;
+            entry->nextPageToken = std::move(page->nextPageToken);
+            entry->complete = entry->nextPageToken.empty() || entry->pages >= MAX_PAGES;
+
+            if (!current) {
+                entry->fetching = false;
+                return;
+            }
+            shared->current.games = entry->games;
+            shared->current.provisional = false;
+            shared->current.loading = !entry->complete;
+            ++shared->version;
+
+            if (entry->complete) {
+                entry->fetching = false;
+                return;
+            }
+        }
+    }
+
+} // namespace Roblox
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "common.h"
+
+namespace Roblox {
+
+    // Search-as-you-type over omni-search. Typing is debounced, a newer query supersedes the one in
+    // flight (its transfer is aborted and its remaining pages are never requested), and recent
+    // queries are kept with their pages in a small LRU. Each entry has at most one fetch running;
+    // going back to a query whose fetch is still winding down picks that fetch up again. The first
+    // page is shown as soon as it lands and later pages are prefetched through pageToken and appended
+    // as they arrive. While a query is still loading, a cached shorter query it extends provides
+    // provisional, locally filtered results.
+    class GameSearch {
+        public:
+            struct Snapshot {
+                    std::string query;
+                    std::vector<GameInfo> games;
+                    bool loading = false;
+                    bool provisional = false; // games come from a cached prefix, not this query
+                    std::string error;
+            };
+
+            GameSearch();
+
+            // Records the text as typed; the search starts once it has been left alone for a moment
+            void setQuery(std::string_view query);
+            // Searches right away, e.g. on Enter or the Search button
+            void submit(std::string_view query);
+            void clear();
+
+            // Call once per frame to start debounced searches
+            void update();
+
+            // Changes whenever the snapshot does, so callers can skip copying unchanged results
+            [[nodiscard]] uint64_t version() const;
+            [[nodiscard]] Snapshot snapshot() const;
+
+        private:
+            using Clock = std::chrono::steady_clock;
+
+            struct CacheEntry {
+                    std::string key;
+                    std::string sessionId;
+                    std::vector<GameInfo> games;
+                    std::unordered_set<uint64_t> seen;
+                    std::string nextPageToken;
+                    size_t pages = 0;
+                    bool complete = false;
+                    bool fetching = false;
+                    // Set to abort the fetch's request in flight; replaced when a cancelled fetch is resumed
+                    std::shared_ptr<std::atomic<bool>> cancel;
+            };
+
+            struct Shared {
+                    mutable std::mutex mutex;
+                    uint64_t version = 0;
+                    Snapshot current;
+                    std::list<CacheEntry> lru; // most recent first
+            };
+
+            void start(std::string key);
+
+            // Caller holds shared.mutex
+            static CacheEntry *findEntry(Shared &shared, const std::string &key);
+            static CacheEntry &touchEntry(Shared &shared, const std::string &key);
+            static void fetchPages(const std::shared_ptr<Shared> &shared, std::string key);
+
+            std::shared_ptr<Shared> m_shared;
+            std::string m_typed;
+            std::string m_active;
+            Clock::time_point m_typedAt {};
+            bool m_dirty = false;
+    };
+
+} // namespace Roblox
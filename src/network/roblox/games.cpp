@@ -10,127 +10,132 @@
 #include "common.h"
 #include "console/console.h"
 #include "network/http.h"
+#include "network/json_sax.h"
+#include "server_page_decoder.h"
 #include "ui/windows/components.h"
+#include "universe_metadata.h"
+#include "utils/json_fields.h"
 
 namespace Roblox {
 
-    GameDetail getGameDetail(uint64_t universeId) {
-        using nlohmann::json;
-        const std::string url = "https://games.roblox.com/v1/games?universeIds=" + std::to_string(universeId);
+    namespace {
+        using JsonFields::field;
+
+        // price is null for games that are not paid access; that keeps the -1 default
+        constexpr auto kGameDetailFields = JsonFields::fields(
+            field("id", &GameDetail::universeId),
+            field("rootPlaceId", &GameDetail::rootPlaceId),
+            field("name", &GameDetail::name),
+            field("genre", &GameDetail::genre),
+            field("genre_l1", &GameDetail::genreL1),
+            field("genre_l2", &GameDetail::genreL2),
+            field("description", &GameDetail::description),
+            field("visits", &GameDetail::visits),
+            field("favoritedCount", &GameDetail::favorites),
+            field("playing", &GameDetail::playing),
+            field("maxPlayers", &GameDetail::maxPlayers),
+            field("price", &GameDetail::priceRobux),
+            field("created", &GameDetail::createdIso),
+            field("updated", &GameDetail::updatedIso),
+            JsonFields::object(
+                "creator",
+                JsonFields::fields(
+                    field("name", &GameDetail::creatorName),
+                    field("id", &GameDetail::creatorId),
+                    field("type", &GameDetail::creatorType),
+                    field("hasVerifiedBadge", &GameDetail::creatorVerified)
+                )
+            )
+        );
+        static_assert(JsonFields::uniqueNames(kGameDetailFields));
 
-        HttpClient::Response resp = HttpClient::get(url);
-        if (resp.status_code < 200 || resp.status_code >= 300) {
-            LOG_ERROR("Game detail fetch failed: HTTP {}", resp.status_code);
-            return GameDetail {};
+        GameDetail parseGameDetail(const nlohmann::json &j) {
+            GameDetail d;
+            JsonFields::read(j, d, kGameDetailFields);
+            return d;
         }
+    } // namespace
 
-        GameDetail d;
-        try {
-            json root = json::parse(resp.text);
-            if (root.contains("data") && root["data"].is_array() && !root["data"].empty()) {
-                const auto &j = root["data"][0];
-                d.name = j.value("name", "");
-                d.genre = j.value("genre", "");
-                d.genreL1 = j.value("genre_l1", "");
-                d.genreL2 = j.value("genre_l2", "");
-                d.description = j.value("description", "");
-                d.visits = j.value("visits", 0ULL);
-                d.favorites = j.value("favoritedCount", 0ULL);
-                d.playing = j.value("playing", 0);
-                d.maxPlayers = j.value("maxPlayers", 0);
-
-                if (j.contains("price") && !j["price"].is_null()) {
-                    d.priceRobux = j["price"].get<int>();
-                } else {
-                    d.priceRobux = -1;
-                }
-
-                d.createdIso = j.value("created", "");
-                d.updatedIso = j.value("updated", "");
+    ApiResult<std::vector<GameDetail>> getGameDetails(std::span<const uint64_t> universeIds) {
+        if (universeIds.empty()) {
+            return std::vector<GameDetail> {};
+        }
 
-                if (j.contains("creator")) {
-                    const auto &c = j["creator"];
-                    d.creatorName = c.value("name", "");
-                    d.creatorId = c.value("id", 0ULL);
-                    d.creatorType = c.value("type", "");
-                    d.creatorVerified = c.value("hasVerifiedBadge", false);
-                }
+        std::string url = "https://games.roblox.com/v1/games?universeIds=";
+        for (size_t i = 0; i < universeIds.size(); ++i) {
+            if (i > 0) {
+                url += ',';
             }
-        } catch (const std::exception &e) {
-            LOG_ERROR("Failed to parse game detail: {}", e.what());
+            url += std::to_string(universeIds[i]);
         }
 
-        return d;
-    }
-
-    ApiResult<GameDetail> getGameDetailResult(uint64_t universeId) {
-        const std::string url = "https://games.roblox.com/v1/games?universeIds=" + std::to_string(universeId);
-
-        HttpClient::Response resp = HttpClient::get(url);
+        HttpClient::Response resp = HttpClient::rateLimitedRequest(
+            [&]() {
+                return HttpClient::get(url);
+            },
+            {.idempotent = true}
+        );
         if (resp.status_code < 200 || resp.status_code >= 300) {
-            LOG_ERROR("Game detail fetch failed: HTTP {}", resp.status_code);
-            return std::unexpected(httpStatusToError(resp.status_code));
+            LOG_CAT_ERROR(Games, "Game detail fetch failed: HTTP {}", resp.status_code);
+            return std::unexpected(httpStatusToError(resp));
         }
 
         try {
             nlohmann::json root = nlohmann::json::parse(resp.text);
-            if (!root.contains("data") || !root["data"].is_array() || root["data"].empty()) {
-                return std::unexpected(ApiError::NotFound);
-            }
-
-            const auto &j = root["data"][0];
-            GameDetail d;
-            d.name = j.value("name", "");
-            d.genre = j.value("genre", "");
-            d.genreL1 = j.value("genre_l1", "");
-            d.genreL2 = j.value("genre_l2", "");
-            d.description = j.value("description", "");
-            d.visits = j.value("visits", 0ULL);
-            d.favorites = j.value("favoritedCount", 0ULL);
-            d.playing = j.value("playing", 0);
-            d.maxPlayers = j.value("maxPlayers", 0);
-
-            if (j.contains("price") && !j["price"].is_null()) {
-                d.priceRobux = j["price"].get<int>();
-            } else {
-                d.priceRobux = -1;
-            }
-
-            d.createdIso = j.value("created", "");
-            d.updatedIso = j.value("updated", "");
-
-            if (j.contains("creator")) {
-                const auto &c = j["creator"];
-                d.creatorName = c.value("name", "");
-                d.creatorId = c.value("id", 0ULL);
-                d.creatorType = c.value("type", "");
-                d.creatorVerified = c.value("hasVerifiedBadge", false);
+            std::vector<GameDetail> out;
+            if (root.contains("data") && root["data"].is_array()) {
+                out.reserve(root["data"].size());
+                for (const auto &j: root["data"]) {
+                    out.push_back(parseGameDetail(j));
+                }
             }
-
-            return d;
+            return out;
         } catch (const std::exception &e) {
-            LOG_ERROR("Failed to parse game detail: {}", e.what());
+            LOG_CAT_ERROR(Games, "Failed to parse game detail: {}", e.what());
             return std::unexpected(ApiError::ParseError);
         }
     }
 
-    std::vector<GameInfo> searchGames(const std::string &query) {
-        const std::string sessionId = generateSessionId();
-        auto resp = HttpClient::get(
-            "https://apis.roblox.com/search-api/omni-search",
-            {
-                {"Accept", "application/json"}
+    GameDetail getGameDetail(uint64_t universeId) {
+        return getGameDetailResult(universeId).value_or(GameDetail {});
+    }
+
+    ApiResult<GameDetail> getGameDetailResult(uint64_t universeId) {
+        return UniverseMetadata::instance().get(universeId);
+    }
+
+    ApiResult<GameSearchPage>
+    searchGamesPage(const std::string &query, const std::string &pageToken, const std::string &sessionId) {
+        auto resp = HttpClient::rateLimitedRequest(
+            [&]() {
+                return HttpClient::get(
+                    "https://apis.roblox.com/search-api/omni-search",
+                    {{"Accept", "application/json"}},
+                    cpr::Parameters {
+                        {"searchQuery", query},
+                        {"pageToken", pageToken},
+                        {"sessionId", sessionId},
+                        {"pageType", "all"}
+                    }
+                );
             },
-            cpr::Parameters {{"searchQuery", query}, {"pageToken", ""}, {"sessionId", sessionId}, {"pageType", "all"}}
+            {.idempotent = true}
         );
 
-        std::vector<GameInfo> out;
         if (resp.status_code < 200 || resp.status_code >= 300) {
-            LOG_ERROR("Game search failed: HTTP {}", resp.status_code);
-            return out;
+            LOG_CAT_ERROR(Games, "Game search failed: HTTP {}", resp.status_code);
+            return std::unexpected(httpStatusToError(resp));
         }
 
         auto j = HttpClient::decode(resp);
+        if (!j.is_object()) {
+            return std::unexpected(ApiError::ParseError);
+        }
+
+        GameSearchPage page;
+        if (j.contains("nextPageToken") && j["nextPageToken"].is_string()) {
+            page.nextPageToken = j["nextPageToken"].get<std::string>();
+        }
 
         if (j.contains("searchResults") && j["searchResults"].is_array()) {
             for (auto &group: j["searchResults"]) {
@@ -152,94 +157,58 @@ namespace Roblox {
                     info.downVotes = g.value("totalDownVotes", 0);
                     info.creatorName = g.value("creatorName", "");
                     info.creatorVerified = g.value("creatorHasVerifiedBadge", false);
-                    out.push_back(std::move(info));
+                    page.games.push_back(std::move(info));
                 }
             }
         }
 
-        return out;
+        UniverseMetadata::instance().rememberSearchResults(page.games);
+        return page;
     }
 
-    ApiResult<std::vector<GameInfo>> searchGamesResult(const std::string &query) {
-        auto games = searchGames(query);
-        return games;
+    std::vector<GameInfo> searchGames(const std::string &query) {
+        auto page = searchGamesPage(query, {}, generateSessionId());
+        return page ? std::move(page->games) : std::vector<GameInfo> {};
     }
 
-    ServerPage getPublicServersPage(uint64_t placeId, const std::string &cursor) {
-        std::string url = "https://games.roblox.com/v1/games/" + std::to_string(placeId)
-                          + "/servers/Public?sortOrder=Asc&limit=100"
-                          + (cursor.empty() ? "" : "&cursor=" + cursor);
-
-        HttpClient::Response resp = HttpClient::get(url);
-        if (resp.status_code < 200 || resp.status_code >= 300) {
-            LOG_ERROR("Failed to fetch servers: HTTP {}", resp.status_code);
-            return ServerPage {};
+    ApiResult<std::vector<GameInfo>> searchGamesResult(const std::string &query) {
+        auto page = searchGamesPage(query, {}, generateSessionId());
+        if (!page) {
+            return std::unexpected(page.error());
         }
+        return std::move(page->games);
+    }
 
-        auto json = HttpClient::decode(resp);
+    std::string publicServersUrl(uint64_t placeId, const std::string &cursor) {
+        return "https://games.roblox.com/v1/games/" + std::to_string(placeId) + "/servers/Public?sortOrder=Asc&limit=100"
+               + (cursor.empty() ? "" : "&cursor=" + cursor);
+    }
 
+    ServerPage parseServerPage(const HttpClient::Response &resp) {
         ServerPage page;
-        if (json.contains("nextPageCursor")) {
-            page.nextCursor
-                = json["nextPageCursor"].is_null() ? std::string {} : json["nextPageCursor"].get<std::string>();
-        }
+        page.data.reserve(100);
 
-        if (json.contains("previousPageCursor")) {
-            page.prevCursor
-                = json["previousPageCursor"].is_null() ? std::string {} : json["previousPageCursor"].get<std::string>();
+        ServerPageDecoder decoder(page);
+        if (!HttpClient::saxDecode(resp.text, decoder)) {
+            LOG_CAT_ERROR(Games, "Failed to parse server page: {}", decoder.error());
+            return ServerPage {};
         }
 
-        if (json.contains("data") && json["data"].is_array()) {
-            for (auto &e: json["data"]) {
-                PublicServerInfo s;
-                s.jobId = e.value("id", "");
-                s.currentPlayers = e.value("playing", 0);
-                s.maximumPlayers = e.value("maxPlayers", 0);
-                s.averagePing = e.value("ping", 0.0);
-                s.averageFps = e.value("fps", 0.0);
-                page.data.push_back(std::move(s));
-            }
-        }
         return page;
     }
 
-    ApiResult<ServerPage> getPublicServersPageResult(uint64_t placeId, const std::string &cursor) {
-        std::string url = "https://games.roblox.com/v1/games/" + std::to_string(placeId)
-                          + "/servers/Public?sortOrder=Asc&limit=100"
-                          + (cursor.empty() ? "" : "&cursor=" + cursor);
+    ServerPage getPublicServersPage(uint64_t placeId, const std::string &cursor) {
+        return getPublicServersPageResult(placeId, cursor).value_or(ServerPage {});
+    }
 
-        HttpClient::Response resp = HttpClient::get(url);
+    ApiResult<ServerPage> getPublicServersPageResult(uint64_t placeId, const std::string &cursor) {
+        HttpClient::Response resp = HttpClient::get(publicServersUrl(placeId, cursor));
         if (resp.status_code < 200 || resp.status_code >= 300) {
-            LOG_ERROR("Failed to fetch servers: HTTP {}", resp.status_code);
-            return std::unexpected(httpStatusToError(resp.status_code));
-        }
-
-        auto json = HttpClient::decode(resp);
-        ServerPage page;
-
-        if (json.contains("nextPageCursor")) {
-            page.nextCursor
-                = json["nextPageCursor"].is_null() ? std::string {} : json["nextPageCursor"].get<std::string>();
-        }
-
-        if (json.contains("previousPageCursor")) {
-            page.prevCursor
-                = json["previousPageCursor"].is_null() ? std::string {} : json["previousPageCursor"].get<std::string>();
-        }
-
-        if (json.contains("data") && json["data"].is_array()) {
-            for (auto &e: json["data"]) {
-                PublicServerInfo s;
-                s.jobId = e.value("id", "");
-                s.currentPlayers = e.value("playing", 0);
-                s.maximumPlayers = e.value("maxPlayers", 0);
-                s.averagePing = e.value("ping", 0.0);
-                s.averageFps = e.value("fps", 0.0);
-                page.data.push_back(std::move(s));
-            }
+            LOG_CAT_ERROR(Games, "Failed to fetch servers: HTTP {}", resp.status_code);
+            return std::unexpected(httpStatusToError(resp));
         }
 
-        return page;
+        return parseServerPage(resp);
     }
 
     GamePrivateServersPage getPrivateServersForGame(uint64_t placeId, const std::string &cookie) {
@@ -258,7 +227,7 @@ namespace Roblox {
         );
 
         if (resp.status_code < 200 || resp.status_code >= 300) {
-            LOG_ERROR("Failed to fetch private servers: HTTP {}", resp.status_code);
+            LOG_CAT_ERROR(Games, "Failed to fetch private servers: HTTP {}", resp.status_code);
             return {};
         }
 
@@ -327,64 +296,76 @@ namespace Roblox {
         return page;
     }
 
-    MyPrivateServersPage getAllPrivateServers(int serverTab, const std::string &cookie, const std::string &cursor) {
-        std::string url = std::format(
-            "https://games.roblox.com/v1/private-servers/my-private-servers"
-            "?privateServersTab={}&itemsPerPage=100{}",
-            serverTab,
-            cursor.empty() ? "" : "&cursor=" + cursor
-        );
-
-        auto resp = HttpClient::get(
-            url,
-            {
-                {"Cookie",     ".ROBLOSECURITY=" + cookie},
-                {"User-Agent", "Mozilla/5.0"             }
+    namespace {
+        ApiResult<MyPrivateServersPage>
+        fetchMyPrivateServersPage(int serverTab, const std::string &cookie, const std::string &cursor) {
+            std::string url = std::format(
+                "https://games.roblox.com/v1/private-servers/my-private-servers"
+                "?privateServersTab={}&itemsPerPage=100{}",
+                serverTab,
+                cursor.empty() ? "" : "&cursor=" + cursor
+            );
+
+            auto resp = HttpClient::rateLimitedRequest(
+                [&]() {
+                    return HttpClient::get(
+                        url,
+                        {
+                            {"Cookie",     ".ROBLOSECURITY=" + cookie},
+                            {"User-Agent", "Mozilla/5.0"             }
+                        }
+                    );
+                },
+                {.idempotent = true}
+            );
+
+            if (resp.status_code < 200 || resp.status_code >= 300) {
+                LOG_CAT_ERROR(Games, "Failed to fetch private servers: HTTP {}", resp.status_code);
+                return std::unexpected(httpStatusToError(resp));
             }
-        );
 
-        if (resp.status_code < 200 || resp.status_code >= 300) {
-            LOG_ERROR("Failed to fetch private servers: HTTP {}", resp.status_code);
-            return {};
-        }
-
-        auto json = HttpClient::decode(resp);
-        MyPrivateServersPage page;
-
-        if (json.contains("nextPageCursor") && !json["nextPageCursor"].is_null()) {
-            page.nextCursor = json["nextPageCursor"].get<std::string>();
-        }
+            auto json = HttpClient::decode(resp);
+            MyPrivateServersPage page;
 
-        if (json.contains("previousPageCursor") && !json["previousPageCursor"].is_null()) {
-            page.prevCursor = json["previousPageCursor"].get<std::string>();
-        }
+            if (json.contains("nextPageCursor") && !json["nextPageCursor"].is_null()) {
+                page.nextCursor = json["nextPageCursor"].get<std::string>();
+            }
 
-        if (!json.contains("data") || !json["data"].is_array()) {
-            return page;
-        }
+            if (json.contains("previousPageCursor") && !json["previousPageCursor"].is_null()) {
+                page.prevCursor = json["previousPageCursor"].get<std::string>();
+            }
 
-        for (const auto &e: json["data"]) {
-            MyPrivateServerInfo s;
+            if (!json.contains("data") || !json["data"].is_array()) {
+                return page;
+            }
 
-            s.privateServerId = e.value("privateServerId", 0ULL);
-            s.universeId = e.value("universeId", 0ULL);
-            s.placeId = e.value("placeId", 0ULL);
-            s.ownerId = e.value("ownerId", 0ULL);
-            s.ownerName = e.value("ownerName", "");
-            s.name = e.value("name", "");
-            s.universeName = e.value("universeName", "");
-            s.expirationDate = e.value("expirationDate", "");
-            s.active = e.value("active", false);
-            s.willRenew = e.value("willRenew", false);
+            for (const auto &e: json["data"]) {
+                MyPrivateServerInfo s;
+
+                s.privateServerId = e.value("privateServerId", 0ULL);
+                s.universeId = e.value("universeId", 0ULL);
+                s.placeId = e.value("placeId", 0ULL);
+                s.ownerId = e.value("ownerId", 0ULL);
+                s.ownerName = e.value("ownerName", "");
+                s.name = e.value("name", "");
+                s.universeName = e.value("universeName", "");
+                s.expirationDate = e.value("expirationDate", "");
+                s.active = e.value("active", false);
+                s.willRenew = e.value("willRenew", false);
+
+                if (e.contains("priceInRobux") && !e["priceInRobux"].is_null()) {
+                    s.priceInRobux = e["priceInRobux"].get<int>();
+                }
 
-            if (e.contains("priceInRobux") && !e["priceInRobux"].is_null()) {
-                s.priceInRobux = e["priceInRobux"].get<int>();
+                page.data.push_back(std::move(s));
             }
 
-            page.data.push_back(std::move(s));
+            return page;
         }
+    } // namespace
 
-        return page;
+    MyPrivateServersPage getAllPrivateServers(int serverTab, const std::string &cookie, const std::string &cursor) {
+        return fetchMyPrivateServersPage(serverTab, cookie, cursor).value_or(MyPrivateServersPage {});
     }
 
     ApiResult<MyPrivateServersPage>
@@ -394,8 +375,7 @@ namespace Roblox {
             return std::unexpected(validationError);
         }
 
-        auto page = getAllPrivateServers(serverTab, cookie, cursor);
-        return page;
+        return fetchMyPrivateServersPage(serverTab, cookie, cursor);
     }
 
     static VipServerInfo parseVipServerInfo(const nlohmann::json &j) {
@@ -420,15 +400,15 @@ namespace Roblox {
         );
 
         if (resp.status_code < 200 || resp.status_code >= 300) {
-            LOG_ERROR("getVipServerInfo failed: HTTP {}", resp.status_code);
-            return std::unexpected(httpStatusToError(resp.status_code));
+            LOG_CAT_ERROR(Games, "getVipServerInfo failed: HTTP {}", resp.status_code);
+            return std::unexpected(httpStatusToError(resp));
         }
 
         try {
             auto j = HttpClient::decode(resp);
             return parseVipServerInfo(j);
         } catch (const std::exception &e) {
-            LOG_ERROR("getVipServerInfo parse error: {}", e.what());
+            LOG_CAT_ERROR(Games, "getVipServerInfo parse error: {}", e.what());
             return std::unexpected(ApiError::ParseError);
         }
     }
@@ -439,15 +419,15 @@ namespace Roblox {
         auto resp = authenticatedPatch(url, cookie, R"({"newJoinCode":true})");
 
         if (resp.status_code < 200 || resp.status_code >= 300) {
-            LOG_ERROR("regenerateVipServerLink failed: HTTP {}", resp.status_code);
-            return std::unexpected(httpStatusToError(resp.status_code));
+            LOG_CAT_ERROR(Games, "regenerateVipServerLink failed: HTTP {}", resp.status_code);
+            return std::unexpected(httpStatusToError(resp));
         }
 
         try {
             auto j = HttpClient::decode(resp);
             return parseVipServerInfo(j);
         } catch (const std::exception &e) {
-            LOG_ERROR("regenerateVipServerLink parse error: {}", e.what());
+            LOG_CAT_ERROR(Games, "regenerateVipServerLink parse error: {}", e.what());
             return std::unexpected(ApiError::ParseError);
         }
     }
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <expected>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -14,6 +15,8 @@ struct GameInfo;
 namespace Roblox {
 
     struct GameDetail {
+            uint64_t universeId = 0;
+            uint64_t rootPlaceId = 0;
             std::string name;
             std::string genre;
             std::string genreL1;
@@ -39,6 +42,11 @@ namespace Roblox {
             std::string prevCursor;
     };
 
+    struct GameSearchPage {
+            std::vector<GameInfo> games;
+            std::string nextPageToken; // empty on the last page
+    };
+
     struct GamePrivateServerPlayer {
             uint64_t id {};
             std::string name;
@@ -99,14 +107,27 @@ namespace Roblox {
             bool active {};
     };
 
+    // Single-universe lookups go through UniverseMetadata, so they are cached and coalesced with
+    // other lookups made around the same time
     GameDetail getGameDetail(uint64_t universeId);
 
     ApiResult<GameDetail> getGameDetailResult(uint64_t universeId);
 
+    // One uncached request for up to UniverseMetadata::MAX_BATCH universes. Unknown ids are left out.
+    ApiResult<std::vector<GameDetail>> getGameDetails(std::span<const uint64_t> universeIds);
+
     std::vector<GameInfo> searchGames(const std::string &query);
 
+    // One omni-search page. Later pages must reuse the first page's sessionId.
+    ApiResult<GameSearchPage>
+    searchGamesPage(const std::string &query, const std::string &pageToken, const std::string &sessionId);
+
     ApiResult<std::vector<GameInfo>> searchGamesResult(const std::string &query);
 
+    std::string publicServersUrl(uint64_t placeId, const std::string &cursor = {});
+
+    ServerPage parseServerPage(const HttpClient::Response &resp);
+
     ServerPage getPublicServersPage(uint64_t placeId, const std::string &cursor = {});
 
     ApiResult<ServerPage> getPublicServersPageResult(uint64_t placeId, const std::string &cursor = {});
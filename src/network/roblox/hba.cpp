@@ -138,7 +138,7 @@ namespace Roblox::Hba {
         uint8_t pubKey[64];
 
         if (!uECC_make_key(pubKey, privKey.data(), curve)) {
-            LOG_ERROR("[HBA] Failed to generate P-256 keypair");
+            LOG_CAT_ERROR(Auth, "[HBA] Failed to generate P-256 keypair");
             return std::unexpected(ApiError::Unknown);
         }
 
@@ -166,8 +166,8 @@ namespace Roblox::Hba {
         );
 
         if (resp.status_code < 200 || resp.status_code >= 300) {
-            LOG_ERROR("[HBA] Failed to fetch server nonce: HTTP {}", resp.status_code);
-            return std::unexpected(httpStatusToError(resp.status_code));
+            LOG_CAT_ERROR(Auth, "[HBA] Failed to fetch server nonce: HTTP {}", resp.status_code);
+            return std::unexpected(httpStatusToError(resp));
         }
 
         try {
@@ -186,7 +186,7 @@ namespace Roblox::Hba {
 
         auto tokenResult = buildBoundAuthToken(cookie, url, "");
         if (!tokenResult) {
-            LOG_ERROR("[HBA] Failed to build bound auth token for client assertion");
+            LOG_CAT_ERROR(Auth, "[HBA] Failed to build bound auth token for client assertion");
             return std::unexpected(tokenResult.error());
         }
 
@@ -202,8 +202,8 @@ namespace Roblox::Hba {
         );
 
         if (resp.status_code < 200 || resp.status_code >= 300) {
-            LOG_ERROR("[HBA] Failed to fetch client assertion: HTTP {}", resp.status_code);
-            return std::unexpected(httpStatusToError(resp.status_code));
+            LOG_CAT_ERROR(Auth, "[HBA] Failed to fetch client assertion: HTTP {}", resp.status_code);
+            return std::unexpected(httpStatusToError(resp));
         }
 
         try {
@@ -245,7 +245,7 @@ namespace Roblox::Hba {
         uint8_t sig[64];
 
         if (!uECC_sign(kp.privateKey.data(), hash, sizeof(hash), sig, curve)) {
-            LOG_ERROR("[HBA] Failed to sign timestamp");
+            LOG_CAT_ERROR(Auth, "[HBA] Failed to sign timestamp");
             return std::unexpected(ApiError::Unknown);
         }
 
@@ -288,7 +288,7 @@ namespace Roblox::Hba {
 
         uint8_t sig1[64];
         if (!uECC_sign(kp.privateKey.data(), hashOfHash, sizeof(hashOfHash), sig1, curve)) {
-            LOG_ERROR("[HBA] Failed to sign body hash");
+            LOG_CAT_ERROR(Auth, "[HBA] Failed to sign body hash");
             return std::unexpected(ApiError::Unknown);
         }
 
@@ -297,7 +297,7 @@ namespace Roblox::Hba {
 
         uint8_t sig2[64];
         if (!uECC_sign(kp.privateKey.data(), tsHash, sizeof(tsHash), sig2, curve)) {
-            LOG_ERROR("[HBA] Failed to sign timestamp");
+            LOG_CAT_ERROR(Auth, "[HBA] Failed to sign timestamp");
             return std::unexpected(ApiError::Unknown);
         }
 
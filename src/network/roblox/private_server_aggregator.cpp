@@ -0,0 +1,210 @@
+#include "private_server_aggregator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <format>
+#include <future>
+#include <unordered_map>
+
+#include "console/console.h"
+#include "network/http.h"
+#include "utils/shutdown_manager.h"
+#include "utils/worker_thread.h"
+
+namespace Roblox {
+
+    namespace {
+        constexpr auto PAGE_TTL = std::chrono::minutes(5);
+        constexpr size_t MAX_PARALLEL_ACCOUNTS = 4;
+        constexpr size_t MAX_PAGES_PER_ACCOUNT = 50;
+    } // namespace
+
+    PrivateServerAggregator::PrivateServerAggregator(int serverTab)
+        : m_serverTab(serverTab),
+          m_shared(std::make_shared<Shared>()) {}
+
+    void PrivateServerAggregator::refresh(std::vector<Account> accounts, bool force) {
+        uint64_t generation = 0;
+        {
+            std::lock_guard lock(m_shared->mutex);
+            generation = ++m_shared->generation;
+
+            std::erase_if(m_shared->pages, [&](const auto &item) {
+                return std::ranges::find(accounts, item.first, &Account::id) == accounts.end();
+            });
+            m_shared->status = Status {};
+            m_shared->status.accountsTotal = accounts.size();
+            m_shared->status.running = !accounts.empty();
+            ++m_shared->version;
+        }
+
+        if (accounts.empty()) {
+            return;
+        }
+
+        WorkerThreads::runBackground(
+            [shared = m_shared, generation, serverTab = m_serverTab, accounts = std::move(accounts), force]() {
+                const auto started = std::chrono::steady_clock::now();
+
+                // A few workers pull accounts off a shared index; each walks its account's pages in order
+                std::atomic<size_t> next {0};
+                auto worker = [&] {
+                    HttpClient::PriorityScope priority(HttpClient::RequestPriority::Bulk);
+                    for (size_t i = next++; i < accounts.size(); i = next++) {
+                        refreshAccount(shared, generation, serverTab, accounts[i], force);
+
+                        std::lock_guard lock(shared->mutex);
+                        if (generation == shared->generation) {
+                            ++shared->status.accountsDone;
+                        }
+                    }
+                };
+
+                std::vector<std::future<void>> workers;
+                const size_t count = std::min(MAX_PARALLEL_ACCOUNTS, accounts.size());
+                workers.reserve(count);
+                for (size_t i = 0; i < count; ++i) {
+                    workers.push_back(std::async(std::launch::async, worker));
+                }
+                for (auto &w: workers) {
+                    w.wait();
+                }
+
+                std::lock_guard lock(shared->mutex);
+                if (generation != shared->generation) {
+                    return;
+                }
+                shared->status.running = false;
+                ++shared->version;
+
+                const auto elapsed = std::chrono::steady_clock::now() - started;
+                const auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+                LOG_EVENT(
+                    Games,
+                    Info,
+                    "private_servers.refresh",
+                    {"accounts", accounts.size()},
+                    {"fetched", shared->status.pagesFetched},
+                    {"reused", shared->status.pagesReused},
+                    {"errors", shared->status.errors.size()},
+                    {"ms", elapsedMs}
+                );
+            }
+        );
+    }
+
+    void PrivateServerAggregator::refreshAccount(
+        const std::shared_ptr<Shared> &shared,
+        uint64_t generation,
+        int serverTab,
+        const Account &account,
+        bool force
+    ) {
+        HttpClient::AccountScope accountScope(account.id);
+        std::string cursor;
+        size_t index = 0;
+
+        while (index < MAX_PAGES_PER_ACCOUNT) {
+            std::optional<std::string> nextCursor;
+            {
+                std::lock_guard lock(shared->mutex);
+                if (generation != shared->generation || ShutdownManager::instance().isShuttingDown()) {
+                    return;
+                }
+
+                // A cached page is reused when it still starts at the same cursor and has not expired
+                const auto &pages = shared->pages[account.id];
+                if (!force && index < pages.size() && pages[index].cursor == cursor
+                    && Clock::now() - pages[index].fetchedAt < PAGE_TTL) {
+                    nextCursor = pages[index].nextCursor;
+                    ++shared->status.pagesReused;
+                    if (!nextCursor || nextCursor->empty()) {
+                        shared->pages[account.id].resize(index + 1);
+                        return;
+                    }
+                    cursor = *nextCursor;
+                    ++index;
+                    continue;
+                }
+            }
+
+            auto page = getAllPrivateServersResult(serverTab, account.cookie, cursor);
+
+            std::lock_guard lock(shared->mutex);
+            if (generation != shared->generation) {
+                return;
+            }
+            if (!page) {
+                shared->status.errors.push_back(
+                    std::format("Account {}: {}", account.id, apiErrorToString(page.error()))
+                );
+                ++shared->version;
+                return;
+            }
+
+            auto &pages = shared->pages[account.id];
+            if (index >= pages.size()) {
+                pages.resize(index + 1);
+            }
+            // If this page now links elsewhere the cached tail belongs to an older listing
+            if (pages[index].nextCursor != page->nextCursor) {
+                pages.resize(index + 1);
+            }
+            pages[index] = CachedPage {
+                .cursor = cursor,
+                .nextCursor = page->nextCursor,
+                .data = std::move(page->data),
+                .fetchedAt = Clock::now(),
+            };
+            ++shared->status.pagesFetched;
+            ++shared->version;
+
+            if (!pages[index].nextCursor || pages[index].nextCursor->empty()) {
+                pages.resize(index + 1);
+                return;
+            }
+            cursor = *pages[index].nextCursor;
+            ++index;
+        }
+    }
+
+    PrivateServerAggregator::Status PrivateServerAggregator::status() const {
+        std::lock_guard lock(m_shared->mutex);
+        return m_shared->status;
+    }
+
+    uint64_t PrivateServerAggregator::version() const {
+        std::lock_guard lock(m_shared->mutex);
+        return m_shared->version;
+    }
+
+    std::vector<PrivateServerAggregator::Entry> PrivateServerAggregator::servers() const {
+        std::vector<Entry> out;
+        std::unordered_map<uint64_t, size_t> byId;
+        {
+            std::lock_guard lock(m_shared->mutex);
+            for (const auto &[accountId, pages]: m_shared->pages) {
+                for (const auto &page: pages) {
+                    for (const auto &info: page.data) {
+                        const auto [it, inserted] = byId.try_emplace(info.privateServerId, out.size());
+                        if (inserted) {
+                            out.push_back(Entry {.info = info, .accountIds = {accountId}});
+                        } else if (std::ranges::find(out[it->second].accountIds, accountId)
+                                   == out[it->second].accountIds.end()) {
+                            out[it->second].accountIds.push_back(accountId);
+                        }
+                    }
+                }
+            }
+        }
+
+        std::ranges::sort(out, [](const Entry &a, const Entry &b) {
+            if (a.info.universeName != b.info.universeName) {
+                return a.info.universeName < b.info.universeName;
+            }
+            return a.info.name < b.info.name;
+        });
+        return out;
+    }
+
+} // namespace Roblox
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "games.h"
+
+namespace Roblox {
+
+    // One view of the private servers of many accounts. Every account's pages are walked in parallel,
+    // a few accounts at a time and all through the shared rate limiter. Pages are cached with the
+    // time they were fetched, so a refresh only re-requests pages that have gone stale and reuses the
+    // rest. A server visible to several accounts appears once, listing every account that sees it.
+    class PrivateServerAggregator {
+        public:
+            struct Account {
+                    int id = 0;
+                    std::string cookie;
+            };
+
+            struct Entry {
+                    MyPrivateServerInfo info;
+                    std::vector<int> accountIds; // first one is used to act on the server
+            };
+
+            struct Status {
+                    size_t accountsTotal = 0;
+                    size_t accountsDone = 0;
+                    size_t pagesFetched = 0;
+                    size_t pagesReused = 0;
+                    bool running = false;
+                    std::vector<std::string> errors;
+            };
+
+            // serverTab as for getAllPrivateServers: 0 = My Servers, 1 = Joinable Servers
+            explicit PrivateServerAggregator(int serverTab);
+
+            PrivateServerAggregator(const PrivateServerAggregator &) = delete;
+            PrivateServerAggregator &operator=(const PrivateServerAggregator &) = delete;
+
+            // Brings every account up to date; accounts no longer listed are dropped. With force,
+            // fresh pages are re-requested as well.
+            void refresh(std::vector<Account> accounts, bool force = false);
+
+            [[nodiscard]] Status status() const;
+            // Changes whenever servers() would return something different
+            [[nodiscard]] uint64_t version() const;
+            // Deduplicated by privateServerId, ordered by game then server name
+            [[nodiscard]] std::vector<Entry> servers() const;
+
+        private:
+            using Clock = std::chrono::steady_clock;
+
+            struct CachedPage {
+                    std::string cursor;
+                    std::optional<std::string> nextCursor;
+                    std::vector<MyPrivateServerInfo> data;
+                    Clock::time_point fetchedAt;
+            };
+
+            struct Shared {
+                    mutable std::mutex mutex;
+                    uint64_t generation = 0;
+                    uint64_t version = 0;
+                    std::map<int, std::vector<CachedPage>> pages; // by account id
+                    Status status;
+            };
+
+            static void refreshAccount(
+                const std::shared_ptr<Shared> &shared,
+                uint64_t generation,
+                int serverTab,
+                const Account &account,
+                bool force
+            );
+
+            int m_serverTab;
+            std::shared_ptr<Shared> m_shared;
+    };
+
+} // namespace Roblox
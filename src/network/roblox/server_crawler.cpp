@@ -0,0 +1,217 @@
+#include "server_crawler.h"
+
+#include <chrono>
+#include <format>
+#include <future>
+
+#include "console/console.h"
+#include "games.h"
+#include "network/http.h"
+#include "utils/shutdown_manager.h"
+#include "utils/worker_thread.h"
+
+namespace Roblox {
+
+    namespace {
+        // 500 pages of 100 is far beyond any real place and keeps a runaway cursor loop bounded
+        constexpr size_t MAX_PAGES = 500;
+
+        std::future<HttpClient::Response> fetchPageAsync(uint64_t placeId, std::string cursor) {
+            return std::async(std::launch::async, [placeId, cursor = std::move(cursor)]() {
+                HttpClient::PriorityScope priority(HttpClient::RequestPriority::Bulk);
+                return HttpClient::rateLimitedRequest(
+                    [&]() {
+                        return HttpClient::get(publicServersUrl(placeId, cursor));
+                    },
+                    {.idempotent = true}
+                );
+            });
+        }
+    } // namespace
+
+    std::optional<std::string> findNextPageCursor(std::string_view body) {
+        constexpr std::string_view KEY = "\"nextPageCursor\"";
+
+        size_t pos = body.find(KEY);
+        if (pos == std::string_view::npos) {
+            return std::string {};
+        }
+        pos += KEY.size();
+
+        auto skipSpace = [&] {
+            while (pos < body.size() && (body[pos] == ' ' || body[pos] == '\n' || body[pos] == '\r' || body[pos] == '\t')) {
+                ++pos;
+            }
+        };
+
+        skipSpace();
+        if (pos >= body.size() || body[pos] != ':') {
+            return std::nullopt;
+        }
+        ++pos;
+        skipSpace();
+
+        if (body.substr(pos, 4) == "null") {
+            return std::string {};
+        }
+        if (pos >= body.size() || body[pos] != '"') {
+            return std::nullopt;
+        }
+
+        const size_t start = pos + 1;
+        const size_t end = body.find('"', start);
+        if (end == std::string_view::npos) {
+            return std::nullopt;
+        }
+
+        const std::string_view value = body.substr(start, end - start);
+        if (value.find('\\') != std::string_view::npos) {
+            return std::nullopt; // escaped content, let the real parser handle it
+        }
+        return std::string(value);
+    }
+
+    ServerPageWalk walkServerPages(
+        uint64_t placeId,
+        const std::function<bool()> &stopRequested,
+        const std::function<bool(ServerPage &)> &onPage
+    ) {
+        ServerPageWalk walk;
+        auto inflight = fetchPageAsync(placeId, {});
+
+        while (true) {
+            HttpClient::Response resp = inflight.get();
+            if (stopRequested()) {
+                break;
+            }
+
+            if (resp.status_code < 200 || resp.status_code >= 300) {
+                walk.error = std::format("HTTP {}", resp.status_code);
+                break;
+            }
+
+            // Start the next request before spending time on this page
+            std::optional<std::string> next = findNextPageCursor(resp.text);
+            bool prefetched = false;
+            if (next && !next->empty() && walk.pages + 1 < MAX_PAGES) {
+                inflight = fetchPageAsync(placeId, *next);
+                prefetched = true;
+            }
+
+            ServerPage page = parseServerPage(resp);
+            ++walk.pages;
+            if (!onPage(page)) {
+                break;
+            }
+
+            if (!prefetched) {
+                if (next || page.nextCursor.empty() || walk.pages >= MAX_PAGES) {
+                    break;
+                }
+                inflight = fetchPageAsync(placeId, page.nextCursor);
+            }
+        }
+
+        // A prefetched page may still be in flight; let it land before the caller's state goes away
+        if (inflight.valid()) {
+            inflight.wait();
+        }
+        return walk;
+    }
+
+    ServerCrawler::~ServerCrawler() {
+        cancel();
+    }
+
+    void ServerCrawler::start(uint64_t placeId) {
+        auto job = std::make_shared<Job>();
+        job->placeId = placeId;
+
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_job) {
+                m_job->cancelled = true;
+            }
+            m_job = job;
+        }
+
+        WorkerThreads::runBackground([job]() {
+            run(job);
+        });
+    }
+
+    void ServerCrawler::cancel() {
+        std::lock_guard lock(m_mutex);
+        if (m_job) {
+            m_job->cancelled = true;
+        }
+    }
+
+    void ServerCrawler::reset() {
+        std::lock_guard lock(m_mutex);
+        if (m_job) {
+            m_job->cancelled = true;
+        }
+        m_job.reset();
+    }
+
+    ServerCrawler::Progress ServerCrawler::progress() const {
+        std::shared_ptr<Job> job;
+        {
+            std::lock_guard lock(m_mutex);
+            job = m_job;
+        }
+        if (!job) {
+            return {};
+        }
+
+        std::lock_guard lock(job->mutex);
+        return {
+            .placeId = job->placeId,
+            .pages = job->pages,
+            .servers = job->store.size(),
+            .running = job->running,
+            .cancelled = job->cancelled.load(),
+            .error = job->error,
+        };
+    }
+
+    bool ServerCrawler::active() const {
+        std::lock_guard lock(m_mutex);
+        return m_job != nullptr;
+    }
+
+    void ServerCrawler::run(const std::shared_ptr<Job> &job) {
+        const auto started = std::chrono::steady_clock::now();
+        auto stopRequested = [&] {
+            return job->cancelled.load() || ShutdownManager::instance().isShuttingDown();
+        };
+
+        const ServerPageWalk walk = walkServerPages(job->placeId, stopRequested, [&](ServerPage &page) {
+            std::lock_guard lock(job->mutex);
+            for (const auto &server: page.data) {
+                job->store.append(server);
+            }
+            ++job->pages;
+            return true;
+        });
+
+        const auto elapsedMs
+            = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started).count();
+
+        std::lock_guard lock(job->mutex);
+        job->running = false;
+        job->error = walk.error;
+        LOG_EVENT(
+            Games,
+            Info,
+            "servers.crawl_done",
+            {"placeId", job->placeId},
+            {"pages", walk.pages},
+            {"servers", job->store.size()},
+            {"ms", elapsedMs},
+            {"cancelled", job->cancelled.load()}
+        );
+    }
+
+} // namespace Roblox
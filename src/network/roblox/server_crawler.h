@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "common.h"
+#include "server_store.h"
+
+namespace Roblox {
+
+    struct ServerPage;
+
+    struct ServerPageWalk {
+            size_t pages = 0;
+            std::string error; // set when a page could not be fetched
+    };
+
+    // Fetches the public server pages of a place in order. The next page is requested as soon as its
+    // cursor has been located in the current response body, so handling one page overlaps the network
+    // round trip of the next. Every request goes through the shared rate limiter at Bulk priority.
+    // stopRequested is checked as each response lands; onPage returns false to stop early.
+    ServerPageWalk walkServerPages(
+        uint64_t placeId,
+        const std::function<bool()> &stopRequested,
+        const std::function<bool(ServerPage &)> &onPage
+    );
+
+    // Walks every public server page of a place in the background with walkServerPages
+    class ServerCrawler {
+        public:
+            struct Progress {
+                    uint64_t placeId = 0;
+                    size_t pages = 0;
+                    size_t servers = 0;
+                    bool running = false;
+                    bool cancelled = false;
+                    std::string error;
+            };
+
+            ServerCrawler() = default;
+            ~ServerCrawler();
+
+            ServerCrawler(const ServerCrawler &) = delete;
+            ServerCrawler &operator=(const ServerCrawler &) = delete;
+
+            // Cancels any crawl in progress and starts over for placeId
+            void start(uint64_t placeId);
+            void cancel();
+            // Cancels and forgets the current crawl
+            void reset();
+
+            [[nodiscard]] Progress progress() const;
+            [[nodiscard]] bool active() const;
+
+            // Runs f(const ServerStore &) under the crawl's lock
+            template<typename F> auto withStore(F &&f) const {
+                std::shared_ptr<Job> job;
+                {
+                    std::lock_guard lock(m_mutex);
+                    job = m_job;
+                }
+                static const ServerStore empty;
+                if (!job) {
+                    return f(empty);
+                }
+                std::lock_guard lock(job->mutex);
+                return f(job->store);
+            }
+
+        private:
+            struct Job {
+                    uint64_t placeId = 0;
+                    std::atomic_bool cancelled {false};
+
+                    mutable std::mutex mutex;
+                    ServerStore store;
+                    size_t pages = 0;
+                    bool running = true;
+                    std::string error;
+            };
+
+            static void run(const std::shared_ptr<Job> &job);
+
+            mutable std::mutex m_mutex;
+            std::shared_ptr<Job> m_job;
+    };
+
+    // Locates "nextPageCursor" in a raw servers response without parsing the whole document.
+    // Returns an empty string for a null cursor and nullopt if the value could not be read cheaply.
+    std::optional<std::string> findNextPageCursor(std::string_view body);
+
+} // namespace Roblox
@@ -0,0 +1,301 @@
+#include "server_finder.h"
+
+#include <charconv>
+#include <chrono>
+#include <deque>
+#include <format>
+#include <functional>
+#include <future>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "console/console.h"
+#include "games.h"
+#include "network/http.h"
+#include "server_crawler.h"
+#include "utils/shutdown_manager.h"
+#include "utils/worker_thread.h"
+
+namespace Roblox {
+
+    namespace {
+        constexpr size_t BATCH_SIZE = 100; // largest request list /v1/batch accepts
+        constexpr size_t MAX_INFLIGHT_BATCHES = 4;
+        constexpr int HEADSHOT_ATTEMPTS = 3;
+        constexpr auto HEADSHOT_RETRY_DELAY = std::chrono::seconds(1);
+        constexpr auto STOP_POLL_INTERVAL = std::chrono::milliseconds(100);
+
+        // Size and format must match between the user and token requests or the URLs never compare equal
+        constexpr const char *HEADSHOT_SIZE = "150x150";
+
+        struct TokenRef {
+                std::string jobId;
+                std::string token;
+        };
+
+        struct BatchResult {
+                std::optional<std::string> jobId;
+                size_t checked = 0;
+                bool failed = false;
+        };
+
+        // Thumbnails that are not generated yet come back "Pending" with no URL, so retry briefly.
+        // Returns an empty string on failure or once stopRequested() turns true.
+        std::string fetchHeadshotUrl(uint64_t userId, const std::function<bool()> &stopRequested) {
+            const std::string url = std::format(
+                "https://thumbnails.roblox.com/v1/users/avatar-headshot?userIds={}&size={}&format=Png&isCircular=false",
+                userId,
+                HEADSHOT_SIZE
+            );
+
+            for (int attempt = 0; attempt < HEADSHOT_ATTEMPTS && !stopRequested(); ++attempt) {
+                auto resp = HttpClient::rateLimitedGet(url);
+                auto json = HttpClient::parseJsonSafe(resp);
+                if (json && json->contains("data") && (*json)["data"].is_array() && !(*json)["data"].empty()) {
+                    const auto &entry = (*json)["data"][0];
+                    if (entry.contains("imageUrl") && entry["imageUrl"].is_string()) {
+                        return entry["imageUrl"].get<std::string>();
+                    }
+                }
+                if (attempt + 1 == HEADSHOT_ATTEMPTS) {
+                    break;
+                }
+                // Short slices so a cancel does not have to wait out the retry delay
+                for (auto waited = std::chrono::milliseconds::zero(); waited < HEADSHOT_RETRY_DELAY;
+                     waited += STOP_POLL_INTERVAL) {
+                    if (stopRequested() || ShutdownManager::instance().sleepFor(STOP_POLL_INTERVAL)) {
+                        return {};
+                    }
+                }
+            }
+            return {};
+        }
+
+        BatchResult resolveBatch(
+            std::vector<TokenRef> batch,
+            std::string targetUrl,
+            std::shared_ptr<std::atomic_bool> stop
+        ) {
+            BatchResult result;
+            if (stop->load()) {
+                return result;
+            }
+            HttpClient::PriorityScope priority(HttpClient::RequestPriority::Bulk);
+
+            nlohmann::json body = nlohmann::json::array();
+            for (size_t i = 0; i < batch.size(); ++i) {
+                body.push_back({
+                    {"requestId",  std::to_string(i)},
+                    {"token",      batch[i].token   },
+                    {"type",       "AvatarHeadShot" },
+                    {"size",       HEADSHOT_SIZE    },
+                    {"format",     "png"            },
+                    {"isCircular", false            }
+                });
+            }
+
+            // Only reads thumbnails, so a timed-out batch is safe to send again
+            auto resp = HttpClient::rateLimitedPost(
+                "https://thumbnails.roblox.com/v1/batch",
+                {{"Content-Type", "application/json"}},
+                body.dump(),
+                {.idempotent = true}
+            );
+
+            auto json = HttpClient::parseJsonSafe(resp);
+            if (!json || !json->contains("data") || !(*json)["data"].is_array()) {
+                result.failed = true;
+                return result;
+            }
+
+            for (const auto &entry: (*json)["data"]) {
+                ++result.checked;
+                if (!entry.contains("imageUrl") || !entry["imageUrl"].is_string()
+                    || entry["imageUrl"].get<std::string>() != targetUrl) {
+                    continue;
+                }
+
+                const std::string requestId = entry.value("requestId", "");
+                size_t index = 0;
+                const auto [ptr, ec] = std::from_chars(requestId.data(), requestId.data() + requestId.size(), index);
+                if (ec == std::errc {} && index < batch.size()) {
+                    result.jobId = batch[index].jobId;
+                    stop->store(true);
+                    break;
+                }
+            }
+            return result;
+        }
+    } // namespace
+
+    ServerFinder::~ServerFinder() {
+        cancel();
+    }
+
+    void ServerFinder::start(uint64_t placeId, uint64_t userId) {
+        auto job = std::make_shared<Job>();
+        job->placeId = placeId;
+        job->userId = userId;
+        job->progress.placeId = placeId;
+        job->progress.userId = userId;
+        job->progress.running = true;
+
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_job) {
+                m_job->cancelled = true;
+            }
+            m_job = job;
+        }
+
+        WorkerThreads::runBackground([job]() {
+            run(job);
+        });
+    }
+
+    void ServerFinder::cancel() {
+        std::lock_guard lock(m_mutex);
+        if (m_job) {
+            m_job->cancelled = true;
+        }
+    }
+
+    void ServerFinder::reset() {
+        std::lock_guard lock(m_mutex);
+        if (m_job) {
+            m_job->cancelled = true;
+        }
+        m_job.reset();
+    }
+
+    ServerFinder::Progress ServerFinder::progress() const {
+        std::shared_ptr<Job> job;
+        {
+            std::lock_guard lock(m_mutex);
+            job = m_job;
+        }
+        if (!job) {
+            return {};
+        }
+
+        std::lock_guard lock(job->mutex);
+        Progress out = job->progress;
+        out.cancelled = job->cancelled.load();
+        return out;
+    }
+
+    bool ServerFinder::active() const {
+        std::lock_guard lock(m_mutex);
+        return m_job != nullptr;
+    }
+
+    void ServerFinder::run(const std::shared_ptr<Job> &job) {
+        const auto started = std::chrono::steady_clock::now();
+        auto stop = std::make_shared<std::atomic_bool>(false);
+        auto stopRequested = [&] {
+            return stop->load() || job->cancelled.load() || ShutdownManager::instance().isShuttingDown();
+        };
+        auto fail = [&](std::string message) {
+            std::lock_guard lock(job->mutex);
+            job->progress.error = std::move(message);
+            job->progress.running = false;
+        };
+
+        const std::string targetUrl = fetchHeadshotUrl(job->userId, stopRequested);
+        if (targetUrl.empty()) {
+            if (stopRequested()) {
+                std::lock_guard lock(job->mutex);
+                job->progress.running = false;
+            } else {
+                fail("Could not load the user's headshot");
+            }
+            return;
+        }
+
+        std::deque<std::future<BatchResult>> inflight;
+        std::vector<TokenRef> pending;
+        pending.reserve(BATCH_SIZE);
+        std::optional<std::string> found;
+        size_t failedBatches = 0;
+
+        auto collect = [&](std::future<BatchResult> &future) {
+            BatchResult result = future.get();
+            failedBatches += result.failed ? 1 : 0;
+            if (result.jobId && !found) {
+                found = std::move(result.jobId);
+            }
+            std::lock_guard lock(job->mutex);
+            job->progress.tokensChecked += result.checked;
+        };
+        auto launch = [&] {
+            inflight.push_back(std::async(std::launch::async, resolveBatch, std::move(pending), targetUrl, stop));
+            pending.clear();
+            pending.reserve(BATCH_SIZE);
+            // Bound the number of outstanding batches, oldest first
+            while (inflight.size() >= MAX_INFLIGHT_BATCHES) {
+                collect(inflight.front());
+                inflight.pop_front();
+            }
+        };
+
+        const ServerPageWalk walk = walkServerPages(job->placeId, stopRequested, [&](ServerPage &page) {
+            {
+                std::lock_guard lock(job->mutex);
+                ++job->progress.pages;
+                job->progress.servers += page.data.size();
+            }
+
+            for (auto &server: page.data) {
+                for (auto &token: server.playerTokens) {
+                    pending.push_back({server.jobId, std::move(token)});
+                    if (pending.size() == BATCH_SIZE) {
+                        launch();
+                    }
+                }
+            }
+            return !stopRequested();
+        });
+        if (!walk.error.empty()) {
+            std::lock_guard lock(job->mutex);
+            job->progress.error = walk.error;
+        }
+
+        if (!pending.empty() && !stopRequested()) {
+            launch();
+        }
+        if (job->cancelled.load()) {
+            stop->store(true);
+        }
+        while (!inflight.empty()) {
+            collect(inflight.front());
+            inflight.pop_front();
+        }
+
+        const auto elapsedMs
+            = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started).count();
+
+        std::lock_guard lock(job->mutex);
+        job->progress.running = false;
+        if (found) {
+            job->progress.foundJobId = *found;
+        } else if (job->progress.error.empty() && failedBatches > 0) {
+            job->progress.error = std::format("{} thumbnail batches failed", failedBatches);
+        }
+
+        LOG_EVENT(
+            Games,
+            Info,
+            "servers.find_done",
+            {"placeId", job->placeId},
+            {"pages", walk.pages},
+            {"servers", job->progress.servers},
+            {"tokens", job->progress.tokensChecked},
+            {"found", found.has_value()},
+            {"ms", elapsedMs}
+        );
+    }
+
+} // namespace Roblox
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace Roblox {
+
+    // Looks for a user among the public servers of a place without relying on their join privacy.
+    // Server pages only expose opaque player tokens, but a token resolves to the same headshot URL as
+    // the user id does, so every token is compared against the target's headshot. Pages come from
+    // walkServerPages like ServerCrawler's, tokens are resolved in full batches with several
+    // batches in flight, and everything stops as soon as one batch reports a match.
+    class ServerFinder {
+        public:
+            struct Progress {
+                    uint64_t placeId = 0;
+                    uint64_t userId = 0;
+                    size_t pages = 0;
+                    size_t servers = 0;
+                    size_t tokensChecked = 0;
+                    bool running = false;
+                    bool cancelled = false;
+                    std::string foundJobId; // empty until the user was found
+                    std::string error;
+            };
+
+            ServerFinder() = default;
+            ~ServerFinder();
+
+            ServerFinder(const ServerFinder &) = delete;
+            ServerFinder &operator=(const ServerFinder &) = delete;
+
+            // Cancels any search in progress and starts looking for userId in placeId
+            void start(uint64_t placeId, uint64_t userId);
+            void cancel();
+            // Cancels and forgets the current search
+            void reset();
+
+            [[nodiscard]] Progress progress() const;
+            [[nodiscard]] bool active() const;
+
+        private:
+            struct Job {
+                    uint64_t placeId = 0;
+                    uint64_t userId = 0;
+                    std::atomic_bool cancelled {false};
+
+                    mutable std::mutex mutex;
+                    Progress progress;
+            };
+
+            static void run(const std::shared_ptr<Job> &job);
+
+            mutable std::mutex m_mutex;
+            std::shared_ptr<Job> m_job;
+    };
+
+} // namespace Roblox
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "common.h"
+#include "games.h"
+#include "network/json_sax.h"
+#include "utils/json_fields.h"
+
+namespace Roblox {
+
+    inline constexpr auto kPublicServerFields = JsonFields::fields(
+        JsonFields::field("id", &PublicServerInfo::jobId),
+        JsonFields::field("playing", &PublicServerInfo::currentPlayers),
+        JsonFields::field("maxPlayers", &PublicServerInfo::maximumPlayers),
+        JsonFields::field("ping", &PublicServerInfo::averagePing),
+        JsonFields::field("fps", &PublicServerInfo::averageFps)
+    );
+    static_assert(JsonFields::uniqueNames(kPublicServerFields));
+
+    // Fills a ServerPage straight from the token stream; pages carry 100 servers with their
+    // player tokens, which made the DOM and the value() walk over it the bulk of the parse cost.
+    // Kept in a header so bench/json_decode_bench.cpp measures this exact decoder.
+    class ServerPageDecoder : public HttpClient::SaxDecoder<ServerPageDecoder> {
+        public:
+            explicit ServerPageDecoder(ServerPage &page)
+                : m_page(page) {}
+
+            void enter() {
+                if (at({"data", "[]"})) {
+                    m_page.data.emplace_back();
+                }
+            }
+
+            void value(const HttpClient::JsonScalar &v) {
+                if (depth() == 1) {
+                    if (at({"nextPageCursor"})) {
+                        m_page.nextCursor = v.take();
+                    } else if (at({"previousPageCursor"})) {
+                        m_page.prevCursor = v.take();
+                    }
+                    return;
+                }
+                if (m_page.data.empty()) {
+                    return;
+                }
+
+                PublicServerInfo &s = m_page.data.back();
+                if (at({"data", "[]", "playerTokens", "[]"})) {
+                    if (v.isString()) {
+                        s.playerTokens.push_back(v.take());
+                    }
+                } else if (const auto key = memberOf({"data", "[]"}); !key.empty()) {
+                    JsonFields::visit(kPublicServerFields, s, key, [&](auto &member) { v.into(member); });
+                }
+            }
+
+        private:
+            ServerPage &m_page;
+    };
+
+} // namespace Roblox
@@ -0,0 +1,335 @@
+#include "server_store.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <format>
+#include <numeric>
+
+namespace Roblox {
+
+    namespace {
+        std::atomic<uint64_t> g_nextVersion {1};
+
+        uint64_t nextVersion() {
+            return g_nextVersion.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        std::string toLower(std::string_view sv) {
+            std::string out(sv);
+            std::ranges::transform(out, out.begin(), [](unsigned char c) {
+                return static_cast<char>(std::tolower(c));
+            });
+            return out;
+        }
+
+        std::optional<ServerQuery::Field> fieldFromName(std::string_view name) {
+            using Field = ServerQuery::Field;
+            if (name == "players" || name == "playing") {
+                return Field::Players;
+            }
+            if (name == "max" || name == "maxplayers") {
+                return Field::MaxPlayers;
+            }
+            if (name == "free" || name == "slots") {
+                return Field::FreeSlots;
+            }
+            if (name == "ping") {
+                return Field::Ping;
+            }
+            if (name == "fps") {
+                return Field::Fps;
+            }
+            return std::nullopt;
+        }
+
+        // "ping<100" -> {Ping, Less, 100}; anything that is not exactly name, operator, number is text
+        std::optional<ServerQuery::Clause> parseClause(std::string_view term) {
+            using Op = ServerQuery::Op;
+
+            const size_t opPos = term.find_first_of("<>=");
+            if (opPos == std::string_view::npos || opPos == 0) {
+                return std::nullopt;
+            }
+
+            const auto field = fieldFromName(term.substr(0, opPos));
+            if (!field) {
+                return std::nullopt;
+            }
+
+            std::string_view rest = term.substr(opPos);
+            Op op;
+            if (rest.starts_with("<=")) {
+                op = Op::LessEqual;
+                rest.remove_prefix(2);
+            } else if (rest.starts_with(">=")) {
+                op = Op::GreaterEqual;
+                rest.remove_prefix(2);
+            } else if (rest.starts_with('<')) {
+                op = Op::Less;
+                rest.remove_prefix(1);
+            } else if (rest.starts_with('>')) {
+                op = Op::Greater;
+                rest.remove_prefix(1);
+            } else {
+                op = Op::Equal;
+                rest.remove_prefix(rest.starts_with("==") ? 2 : 1);
+            }
+
+            // Floating-point from_chars is missing from the libc++ of older macOS deployment targets
+            if (rest.empty() || std::isspace(static_cast<unsigned char>(rest.front()))) {
+                return std::nullopt;
+            }
+            const std::string number(rest);
+            char *end = nullptr;
+            const float value = std::strtof(number.c_str(), &end);
+            if (end != number.c_str() + number.size()) {
+                return std::nullopt;
+            }
+            return ServerQuery::Clause {*field, op, value};
+        }
+
+        // Plain loops over contiguous columns so the compiler can vectorise the comparisons
+        template<typename T>
+        void maskColumn(const std::vector<T> &column, ServerQuery::Op op, float value, std::vector<uint8_t> &mask) {
+            using Op = ServerQuery::Op;
+            const size_t n = column.size();
+            switch (op) {
+                case Op::Less:
+                    for (size_t i = 0; i < n; ++i) {
+                        mask[i] &= static_cast<uint8_t>(static_cast<float>(column[i]) < value);
+                    }
+                    break;
+                case Op::LessEqual:
+                    for (size_t i = 0; i < n; ++i) {
+                        mask[i] &= static_cast<uint8_t>(static_cast<float>(column[i]) <= value);
+                    }
+                    break;
+                case Op::Greater:
+                    for (size_t i = 0; i < n; ++i) {
+                        mask[i] &= static_cast<uint8_t>(static_cast<float>(column[i]) > value);
+                    }
+                    break;
+                case Op::GreaterEqual:
+                    for (size_t i = 0; i < n; ++i) {
+                        mask[i] &= static_cast<uint8_t>(static_cast<float>(column[i]) >= value);
+                    }
+                    break;
+                case Op::Equal:
+                    for (size_t i = 0; i < n; ++i) {
+                        mask[i] &= static_cast<uint8_t>(static_cast<float>(column[i]) == value);
+                    }
+                    break;
+            }
+        }
+    } // namespace
+
+    ServerQuery ServerQuery::parse(std::string_view input) {
+        ServerQuery query;
+        const std::string lower = toLower(input);
+        std::string_view rest = lower;
+
+        while (!rest.empty()) {
+            const size_t start = rest.find_first_not_of(" \t");
+            if (start == std::string_view::npos) {
+                break;
+            }
+            rest.remove_prefix(start);
+            const size_t end = std::min(rest.find_first_of(" \t"), rest.size());
+            const std::string_view term = rest.substr(0, end);
+            rest.remove_prefix(end);
+
+            if (auto clause = parseClause(term)) {
+                query.numeric.push_back(*clause);
+            } else {
+                query.text.emplace_back(term);
+            }
+        }
+        return query;
+    }
+
+    ServerStore::ServerStore()
+        : m_version(nextVersion()) {}
+
+    void ServerStore::clear() {
+        m_jobId.clear();
+        m_playing.clear();
+        m_maxPlayers.clear();
+        m_freeSlots.clear();
+        m_ping.clear();
+        m_fps.clear();
+        m_search.clear();
+        m_seen.clear();
+        m_version = nextVersion();
+    }
+
+    void ServerStore::reserve(size_t count) {
+        m_jobId.reserve(count);
+        m_playing.reserve(count);
+        m_maxPlayers.reserve(count);
+        m_freeSlots.reserve(count);
+        m_ping.reserve(count);
+        m_fps.reserve(count);
+        m_search.reserve(count);
+        m_seen.reserve(count);
+    }
+
+    bool ServerStore::append(const PublicServerInfo &server) {
+        if (server.jobId.empty() || !m_seen.insert(server.jobId).second) {
+            return false;
+        }
+
+        m_jobId.push_back(server.jobId);
+        m_playing.push_back(server.currentPlayers);
+        m_maxPlayers.push_back(server.maximumPlayers);
+        m_freeSlots.push_back(server.maximumPlayers - server.currentPlayers);
+        m_ping.push_back(static_cast<float>(server.averagePing));
+        m_fps.push_back(static_cast<float>(server.averageFps));
+        m_search.push_back(toLower(std::format(
+            "{} {}/{} {}ms {}",
+            server.jobId,
+            server.currentPlayers,
+            server.maximumPlayers,
+            static_cast<int>(server.averagePing + 0.5),
+            static_cast<int>(server.averageFps + 0.5)
+        )));
+        m_version = nextVersion();
+        return true;
+    }
+
+    PublicServerInfo ServerStore::row(uint32_t index) const {
+        PublicServerInfo s;
+        s.jobId = m_jobId[index];
+        s.currentPlayers = m_playing[index];
+        s.maximumPlayers = m_maxPlayers[index];
+        s.averagePing = m_ping[index];
+        s.averageFps = m_fps[index];
+        return s;
+    }
+
+    std::vector<uint32_t> ServerStore::all() const {
+        std::vector<uint32_t> out(m_jobId.size());
+        std::iota(out.begin(), out.end(), 0u);
+        return out;
+    }
+
+    const std::vector<uint32_t> &ServerStore::permutation(Column column, bool descending) const {
+        const size_t slot = static_cast<size_t>(column) * 2 + (descending ? 1 : 0);
+        auto &perm = m_permutations[slot];
+        if (m_permutationVersion[slot] == m_version && perm.size() == m_jobId.size()) {
+            return perm;
+        }
+
+        auto build = [&](const auto &key) {
+            perm = all();
+            // Ties keep store order so the table does not shuffle as rows arrive
+            std::stable_sort(perm.begin(), perm.end(), [&](uint32_t a, uint32_t b) {
+                return descending ? key[a] > key[b] : key[a] < key[b];
+            });
+        };
+
+        switch (column) {
+            case Column::Players:
+                build(m_playing);
+                break;
+            case Column::FreeSlots:
+                build(m_freeSlots);
+                break;
+            case Column::Ping:
+                build(m_ping);
+                break;
+            case Column::Fps:
+                build(m_fps);
+                break;
+        }
+
+        m_permutationVersion[slot] = m_version;
+        return perm;
+    }
+
+    std::vector<uint32_t> ServerStore::sorted(Column column, bool descending) const {
+        return permutation(column, descending);
+    }
+
+    std::vector<uint32_t> ServerStore::topK(Column column, bool descending, size_t k) const {
+        const auto &perm = permutation(column, descending);
+        return {perm.begin(), perm.begin() + static_cast<std::ptrdiff_t>(std::min(k, perm.size()))};
+    }
+
+    void ServerStore::applyClause(const ServerQuery::Clause &clause, std::vector<uint8_t> &mask) const {
+        using Field = ServerQuery::Field;
+        switch (clause.field) {
+            case Field::Players:
+                maskColumn(m_playing, clause.op, clause.value, mask);
+                break;
+            case Field::MaxPlayers:
+                maskColumn(m_maxPlayers, clause.op, clause.value, mask);
+                break;
+            case Field::FreeSlots:
+                maskColumn(m_freeSlots, clause.op, clause.value, mask);
+                break;
+            case Field::Ping:
+                maskColumn(m_ping, clause.op, clause.value, mask);
+                break;
+            case Field::Fps:
+                maskColumn(m_fps, clause.op, clause.value, mask);
+                break;
+        }
+    }
+
+    std::vector<uint32_t> ServerStore::query(const ServerQuery &query, std::optional<Sort> sort, size_t limit) const {
+        if (query.empty()) {
+            if (!sort) {
+                auto out = all();
+                out.resize(std::min(limit, out.size()));
+                return out;
+            }
+            return topK(sort->column, sort->descending, limit);
+        }
+
+        const size_t n = m_jobId.size();
+        std::vector<uint8_t> mask(n, 1);
+        for (const auto &clause: query.numeric) {
+            applyClause(clause, mask);
+        }
+        // Substring checks only run on rows the numeric clauses kept
+        if (!query.text.empty()) {
+            for (size_t i = 0; i < n; ++i) {
+                if (!mask[i]) {
+                    continue;
+                }
+                for (const auto &term: query.text) {
+                    if (m_search[i].find(term) == std::string::npos) {
+                        mask[i] = 0;
+                        break;
+                    }
+                }
+            }
+        }
+
+        std::vector<uint32_t> out;
+        auto collect = [&](uint32_t i) {
+            if (mask[i]) {
+                out.push_back(i);
+            }
+            return out.size() < limit;
+        };
+
+        if (sort) {
+            for (uint32_t i: permutation(sort->column, sort->descending)) {
+                if (!collect(i)) {
+                    break;
+                }
+            }
+        } else {
+            for (uint32_t i = 0; i < n; ++i) {
+                if (!collect(i)) {
+                    break;
+                }
+            }
+        }
+        return out;
+    }
+
+} // namespace Roblox
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "common.h"
+
+namespace Roblox {
+
+    // Parsed server search. Whitespace separated terms are ANDed together; a term such as
+    // "ping<100", "players>=10", "free>0" or "fps>55" compares a numeric column, anything else must
+    // appear in the row's "<jobId> <playing>/<max> <ping>ms <fps>" text.
+    struct ServerQuery {
+            enum class Field {
+                Players,
+                MaxPlayers,
+                FreeSlots,
+                Ping,
+                Fps
+            };
+
+            enum class Op {
+                Less,
+                LessEqual,
+                Greater,
+                GreaterEqual,
+                Equal
+            };
+
+            struct Clause {
+                    Field field;
+                    Op op;
+                    float value;
+            };
+
+            std::vector<Clause> numeric;
+            std::vector<std::string> text; // lowercased
+
+            [[nodiscard]] bool empty() const {
+                return numeric.empty() && text.empty();
+            }
+
+            static ServerQuery parse(std::string_view input);
+    };
+
+    // Public servers of one place stored one array per field, so sorting or filtering thousands of
+    // rows only walks the column it needs. Search text and sort permutations are built once per row
+    // and per change, never per frame. Rows are addressed by index; queries return index lists.
+    class ServerStore {
+        public:
+            enum class Column {
+                Players,
+                FreeSlots,
+                Ping,
+                Fps
+            };
+
+            struct Sort {
+                    Column column;
+                    bool descending;
+            };
+
+            ServerStore();
+
+            void clear();
+            void reserve(size_t count);
+
+            // Servers move between pages while a crawl is running, so a job id is only kept once
+            bool append(const PublicServerInfo &server);
+
+            [[nodiscard]] size_t size() const {
+                return m_jobId.size();
+            }
+
+            // Changes whenever rows are added or removed; unique across all stores
+            [[nodiscard]] uint64_t version() const {
+                return m_version;
+            }
+
+            [[nodiscard]] PublicServerInfo row(uint32_t index) const;
+
+            [[nodiscard]] const std::string &jobId(uint32_t index) const {
+                return m_jobId[index];
+            }
+            [[nodiscard]] int playing(uint32_t index) const {
+                return m_playing[index];
+            }
+            [[nodiscard]] int maxPlayers(uint32_t index) const {
+                return m_maxPlayers[index];
+            }
+            [[nodiscard]] float ping(uint32_t index) const {
+                return m_ping[index];
+            }
+            [[nodiscard]] float fps(uint32_t index) const {
+                return m_fps[index];
+            }
+
+            [[nodiscard]] std::vector<uint32_t> all() const;
+            [[nodiscard]] std::vector<uint32_t> sorted(Column column, bool descending) const;
+            [[nodiscard]] std::vector<uint32_t> topK(Column column, bool descending, size_t k) const;
+
+            // Rows matching query in sort order (store order without one), at most limit of them
+            [[nodiscard]] std::vector<uint32_t>
+            query(const ServerQuery &query, std::optional<Sort> sort, size_t limit = SIZE_MAX) const;
+
+        private:
+            static constexpr size_t COLUMN_COUNT = 4;
+
+            // Sorted order of a column, rebuilt lazily after the store changes
+            const std::vector<uint32_t> &permutation(Column column, bool descending) const;
+            void applyClause(const ServerQuery::Clause &clause, std::vector<uint8_t> &mask) const;
+
+            std::vector<std::string> m_jobId;
+            std::vector<int32_t> m_playing;
+            std::vector<int32_t> m_maxPlayers;
+            std::vector<int32_t> m_freeSlots;
+            std::vector<float> m_ping;
+            std::vector<float> m_fps;
+            std::vector<std::string> m_search; // lowercased row text for substring terms
+            std::unordered_set<std::string> m_seen;
+
+            uint64_t m_version = 0;
+            mutable std::array<std::vector<uint32_t>, COLUMN_COUNT * 2> m_permutations;
+            mutable std::array<uint64_t, COLUMN_COUNT * 2> m_permutationVersion {};
+    };
+
+} // namespace Roblox
@@ -9,6 +9,7 @@
 #include "common.h"
 #include "console/console.h"
 #include "network/http.h"
+#include "network/json_sax.h"
 
 namespace Roblox {
 
@@ -31,6 +32,57 @@ namespace Roblox {
             }
             return translationKey;
         }
+
+        struct DecodedPresence {
+                uint64_t userId = 0;
+                PresenceData data;
+        };
+
+        // Reads {"userPresences":[...]} without a DOM; batches cover every friend of an account
+        class PresenceDecoder : public HttpClient::SaxDecoder<PresenceDecoder> {
+            public:
+                explicit PresenceDecoder(std::vector<DecodedPresence> &out)
+                    : m_out(out) {}
+
+                void enter() {
+                    if (at({"userPresences", "[]"})) {
+                        m_out.emplace_back();
+                        m_out.back().data.presence = presenceTypeToString(0);
+                    }
+                }
+
+                void value(const HttpClient::JsonScalar &v) {
+                    if (depth() != 3 || m_out.empty()) {
+                        return;
+                    }
+                    DecodedPresence &p = m_out.back();
+                    if (at({"userPresences", "[]", "userId"})) {
+                        p.userId = v.asUint();
+                    } else if (at({"userPresences", "[]", "userPresenceType"})) {
+                        p.data.presence = presenceTypeToString(v.asInt());
+                    } else if (at({"userPresences", "[]", "lastLocation"})) {
+                        p.data.lastLocation = v.take();
+                    } else if (at({"userPresences", "[]", "placeId"})) {
+                        p.data.placeId = v.asUint();
+                    } else if (at({"userPresences", "[]", "gameId"})) {
+                        // API uses field name 'gameId' for jobId
+                        p.data.jobId = v.take();
+                    }
+                }
+
+            private:
+                std::vector<DecodedPresence> &m_out;
+        };
+
+        std::vector<DecodedPresence> decodePresences(const HttpClient::Response &response) {
+            std::vector<DecodedPresence> out;
+            PresenceDecoder decoder(out);
+            if (!HttpClient::saxDecode(response.text, decoder)) {
+                LOG_CAT_ERROR(Presence, "Failed to parse presence response: {}", decoder.error());
+                return {};
+            }
+            return out;
+        }
     } // namespace
 
     std::string getPresence(const std::string &cookie, uint64_t userId) {
@@ -41,7 +93,7 @@ namespace Roblox {
             return cached->presence;
         }
 
-        LOG_INFO("Fetching user presence for {}", userId);
+        LOG_EVENT(Presence, Debug, "presence.fetch", {"userId", userId});
 
         nlohmann::json payload = {
             {"userIds", {userId}}
@@ -57,7 +109,7 @@ namespace Roblox {
         );
 
         if (response.status_code < 200 || response.status_code >= 300) {
-            LOG_ERROR("Presence lookup failed: HTTP {}", response.status_code);
+            LOG_EVENT(Presence, Error, "presence.failed", {"userId", userId}, {"status", response.status_code});
 
             if (response.status_code == 403) {
                 return "Banned";
@@ -65,26 +117,15 @@ namespace Roblox {
             return "Offline";
         }
 
-        auto json = HttpClient::decode(response);
+        auto presences = decodePresences(response);
 
-        if (json.contains("userPresences") && json["userPresences"].is_array() && !json["userPresences"].empty()) {
-            const auto &jsonData = json["userPresences"][0];
-            int typeInt = jsonData.value("userPresenceType", 0);
-            std::string presenceStr = presenceTypeToString(typeInt);
-
-            PresenceData data;
-            data.presence = presenceStr;
-            data.lastLocation = jsonData.value("lastLocation", "");
-            if (jsonData.contains("placeId") && jsonData["placeId"].is_number_unsigned()) {
-                data.placeId = jsonData["placeId"].get<uint64_t>();
-            }
-            if (jsonData.contains("gameId") && !jsonData["gameId"].is_null()) {
-                data.jobId = jsonData["gameId"].get<std::string>();
-            }
+        if (!presences.empty()) {
+            PresenceData data = std::move(presences.front().data);
+            const std::string presenceStr = data.presence;
 
             g_presenceCache.set(userId, data);
 
-            LOG_INFO("Got user presence for {}: {}", userId, presenceStr);
+            LOG_EVENT(Presence, Debug, "presence.result", {"userId", userId}, {"presence", presenceStr});
             return presenceStr;
         }
 
@@ -101,7 +142,7 @@ namespace Roblox {
             return *cached;
         }
 
-        LOG_INFO("Fetching user presence for {}", userId);
+        LOG_EVENT(Presence, Debug, "presence.fetch", {"userId", userId});
 
         nlohmann::json payload = {
             {"userIds", {userId}}
@@ -117,28 +158,16 @@ namespace Roblox {
         );
 
         if (response.status_code < 200 || response.status_code >= 300) {
-            LOG_ERROR("Presence lookup failed: HTTP {}", response.status_code);
-            return std::unexpected(httpStatusToError(response.status_code));
+            LOG_EVENT(Presence, Error, "presence.failed", {"userId", userId}, {"status", response.status_code});
+            return std::unexpected(httpStatusToError(response));
         }
 
-        auto json = HttpClient::decode(response);
-
-        if (!json.contains("userPresences") || !json["userPresences"].is_array() || json["userPresences"].empty()) {
+        auto presences = decodePresences(response);
+        if (presences.empty()) {
             return std::unexpected(ApiError::InvalidResponse);
         }
 
-        const auto &jsonData = json["userPresences"][0];
-
-        PresenceData data;
-        data.presence = presenceTypeToString(jsonData.value("userPresenceType", 0));
-        data.lastLocation = jsonData.value("lastLocation", "");
-
-        if (jsonData.contains("placeId") && jsonData["placeId"].is_number_unsigned()) {
-            data.placeId = jsonData["placeId"].get<uint64_t>();
-        }
-        if (jsonData.contains("gameId") && !jsonData["gameId"].is_null()) {
-            data.jobId = jsonData["gameId"].get<std::string>();
-        }
+        PresenceData data = std::move(presences.front().data);
 
         // Cache the result
         g_presenceCache.set(userId, data);
@@ -173,7 +202,7 @@ namespace Roblox {
             return result;
         }
 
-        LOG_INFO("Fetching batch presence for {} users ({} cached)", userIds.size(), result.size());
+        LOG_EVENT(Presence, Info, "presence.batch", {"users", userIds.size()}, {"cached", result.size()});
 
         nlohmann::json payload = {
             {"userIds", uncachedIds}
@@ -189,36 +218,16 @@ namespace Roblox {
         );
 
         if (resp.status_code < 200 || resp.status_code >= 300) {
-            LOG_ERROR("Batch presence failed: HTTP {}", resp.status_code);
+            LOG_CAT_ERROR(Presence, "Batch presence failed: HTTP {}", resp.status_code);
             return result; // Return what we have from cache
         }
 
-        nlohmann::json j = HttpClient::decode(resp);
-
-        if (j.contains("userPresences") && j["userPresences"].is_array()) {
-            for (auto &up: j["userPresences"]) {
-                if (!up.contains("userId")) {
-                    continue;
-                }
-
-                uint64_t userId = up["userId"].get<uint64_t>();
-
-                PresenceData d;
-                d.presence = presenceTypeToString(up.value("userPresenceType", 0));
-                d.lastLocation = up.value("lastLocation", "");
-
-                if (up.contains("placeId") && up["placeId"].is_number_unsigned()) {
-                    d.placeId = up["placeId"].get<uint64_t>();
-                }
-
-                // API uses field name 'gameId' for jobId
-                if (up.contains("gameId") && !up["gameId"].is_null()) {
-                    d.jobId = up["gameId"].get<std::string>();
-                }
-
-                g_presenceCache.set(userId, d);
-                result[userId] = std::move(d);
+        for (auto &p: decodePresences(resp)) {
+            if (p.userId == 0) {
+                continue;
             }
+            g_presenceCache.set(p.userId, p.data);
+            result[p.userId] = std::move(p.data);
         }
 
         return result;
@@ -232,7 +241,7 @@ namespace Roblox {
             return {"N/A", 0};
         }
 
-        LOG_INFO("Fetching voice chat settings");
+        LOG_EVENT(Accounts, Debug, "voice.fetch");
 
         auto resp = HttpClient::get(
             "https://voice.roblox.com/v1/settings",
@@ -242,7 +251,7 @@ namespace Roblox {
         );
 
         if (resp.status_code < 200 || resp.status_code >= 300) {
-            LOG_ERROR("Failed to fetch voice settings: HTTP {}", resp.status_code);
+            LOG_EVENT(Accounts, Error, "voice.failed", {"status", resp.status_code});
             return {"Unknown", 0};
         }
 
@@ -283,7 +292,7 @@ namespace Roblox {
             return *cached;
         }
 
-        LOG_INFO("Fetching account age group");
+        LOG_CAT_INFO(Accounts, "Fetching account age group");
 
         auto resp = HttpClient::get(
             "https://apis.roblox.com/user-settings-api/v1/account-insights/age-group",
@@ -293,8 +302,8 @@ namespace Roblox {
         );
 
         if (resp.status_code < 200 || resp.status_code >= 300) {
-            LOG_ERROR("Age group fetch failed: HTTP {}", resp.status_code);
-            return std::unexpected(httpStatusToError(resp.status_code));
+            LOG_CAT_ERROR(Accounts, "Age group fetch failed: HTTP {}", resp.status_code);
+            return std::unexpected(httpStatusToError(resp));
         }
 
         auto j = HttpClient::decode(resp);
@@ -322,7 +331,7 @@ namespace Roblox {
             return std::unexpected(ApiError::NotFound);
         }
 
-        LOG_INFO("Fetching user settings");
+        LOG_CAT_INFO(Accounts, "Fetching user settings");
 
         auto resp = HttpClient::get(
             "https://apis.roblox.com/user-settings-api/v1/user-settings/settings-and-options",
@@ -332,7 +341,7 @@ namespace Roblox {
         );
 
         if (resp.status_code < 200 || resp.status_code >= 300) {
-            LOG_ERROR("User settings fetch failed: HTTP {}", resp.status_code);
+            LOG_CAT_ERROR(Accounts, "User settings fetch failed: HTTP {}", resp.status_code);
             return std::unexpected(ApiError::NetworkError);
         }
 
@@ -424,8 +433,8 @@ namespace Roblox {
         );
 
         if (resp.status_code < 200 || resp.status_code >= 300) {
-            LOG_ERROR("Failed to set user setting '{}': HTTP {}", key, resp.status_code);
-            return std::unexpected(httpStatusToError(resp.status_code));
+            LOG_CAT_ERROR(Accounts, "Failed to set user setting '{}': HTTP {}", key, resp.status_code);
+            return std::unexpected(httpStatusToError(resp));
         }
 
         g_userSettingsCache.invalidate(cookie);
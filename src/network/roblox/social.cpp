@@ -12,17 +12,97 @@
 #include "auth.h"
 #include "console/console.h"
 #include "network/http.h"
+#include "network/json_sax.h"
 #include "ui/windows/components.h"
 #include "utils/worker_thread.h"
 
 namespace Roblox {
 
+    namespace {
+        // Collects the ids of live entries in {"data":[{"id":..,"isDeleted":..}, ...]}
+        class FriendIdsDecoder : public HttpClient::SaxDecoder<FriendIdsDecoder> {
+            public:
+                explicit FriendIdsDecoder(std::vector<uint64_t> &ids)
+                    : m_ids(ids) {}
+
+                void enter() {
+                    if (at({"data"})) {
+                        m_sawData = true;
+                    } else if (at({"data", "[]"})) {
+                        m_id = 0;
+                        m_deleted = false;
+                    }
+                }
+
+                void leave() {
+                    if (at({"data", "[]"}) && m_id != 0 && !m_deleted) {
+                        m_ids.push_back(m_id);
+                    }
+                }
+
+                void value(const HttpClient::JsonScalar &v) {
+                    if (at({"data", "[]", "id"})) {
+                        m_id = v.asUint();
+                    } else if (at({"data", "[]", "isDeleted"})) {
+                        m_deleted = v.asBool();
+                    }
+                }
+
+                [[nodiscard]] bool sawData() const { return m_sawData; }
+
+            private:
+                std::vector<uint64_t> &m_ids;
+                uint64_t m_id = 0;
+                bool m_deleted = false;
+                bool m_sawData = false;
+        };
+
+        // Appends one FriendInfo per entry of profileDetails; combinedName wins over displayName
+        class FriendProfilesDecoder : public HttpClient::SaxDecoder<FriendProfilesDecoder> {
+            public:
+                explicit FriendProfilesDecoder(std::vector<FriendInfo> &friends)
+                    : m_friends(friends) {}
+
+                void enter() {
+                    if (at({"profileDetails", "[]"})) {
+                        m_friends.emplace_back();
+                        m_hasCombined = false;
+                    }
+                }
+
+                void value(const HttpClient::JsonScalar &v) {
+                    if (!inProfile()) {
+                        return;
+                    }
+                    FriendInfo &f = m_friends.back();
+                    if (at({"profileDetails", "[]", "userId"})) {
+                        f.id = v.asUint();
+                    } else if (at({"profileDetails", "[]", "names", "username"})) {
+                        f.username = v.take();
+                    } else if (at({"profileDetails", "[]", "names", "displayName"})) {
+                        if (!m_hasCombined) {
+                            f.displayName = v.take();
+                        }
+                    } else if (at({"profileDetails", "[]", "names", "combinedName"})) {
+                        f.displayName = v.take();
+                        m_hasCombined = true;
+                    }
+                }
+
+            private:
+                bool inProfile() const { return depth() >= 3 && !m_friends.empty(); }
+
+                std::vector<FriendInfo> &m_friends;
+                bool m_hasCombined = false;
+        };
+    } // namespace
+
     std::vector<FriendInfo> getFriends(const std::string &userId, const std::string &cookie) {
         if (!canUseCookie(cookie)) {
             return {};
         }
 
-        LOG_INFO("Fetching friends list");
+        LOG_EVENT(Friends, Info, "friends.fetch", {"userId", userId});
 
         HttpClient::Response resp = HttpClient::get(
             "https://friends.roblox.com/v1/users/" + userId + "/friends",
@@ -34,24 +114,19 @@ namespace Roblox {
         );
 
         if (resp.status_code < 200 || resp.status_code >= 300) {
-            LOG_ERROR("Failed to fetch friends: HTTP {}", resp.status_code);
+            LOG_EVENT(Friends, Error, "friends.failed", {"userId", userId}, {"status", resp.status_code});
             return {};
         }
 
-        nlohmann::json friendsData = HttpClient::decode(resp);
         std::vector<FriendInfo> friends;
+        std::vector<uint64_t> friendIds;
 
-        if (!friendsData.contains("data") || !friendsData["data"].is_array()) {
-            LOG_ERROR("Invalid response format - missing or invalid 'data' array");
+        FriendIdsDecoder idsDecoder(friendIds);
+        if (!HttpClient::saxDecode(resp.text, idsDecoder) || !idsDecoder.sawData()) {
+            LOG_CAT_ERROR(Friends, "Invalid response format - missing or invalid 'data' array");
             return {};
         }
-
-        std::vector<uint64_t> friendIds;
-        for (const auto &item: friendsData["data"]) {
-            if (item.contains("id") && !item.value("isDeleted", false)) {
-                friendIds.push_back(item["id"].get<uint64_t>());
-            }
-        }
+        friends.reserve(friendIds.size());
 
         if (friendIds.empty()) {
             return friends;
@@ -77,39 +152,22 @@ namespace Roblox {
             );
 
             if (profileResp.status_code < 200 || profileResp.status_code >= 300) {
-                LOG_ERROR("Failed to fetch user profiles: HTTP {}", profileResp.status_code);
+                LOG_EVENT(Friends, Error, "friends.profiles_failed", {"userId", userId}, {"status", profileResp.status_code});
                 continue;
             }
 
-            nlohmann::json profileData = HttpClient::decode(profileResp);
-
-            if (profileData.contains("profileDetails") && profileData["profileDetails"].is_array()) {
-                for (const auto &profile: profileData["profileDetails"]) {
-                    FriendInfo f;
-                    f.id = profile.value("userId", 0ULL);
-
-                    if (profile.contains("names")) {
-                        const auto &names = profile["names"];
-                        if (names.contains("displayName")) {
-                            f.displayName = names["displayName"].get<std::string>();
-                        }
-                        if (names.contains("username")) {
-                            f.username = names["username"].get<std::string>();
-                        }
-                        if (names.contains("combinedName")) {
-                            f.displayName = names["combinedName"].get<std::string>();
-                        }
-                    }
-
-                    friends.push_back(f);
-                }
+            const size_t before = friends.size();
+            FriendProfilesDecoder profilesDecoder(friends);
+            if (!HttpClient::saxDecode(profileResp.text, profilesDecoder)) {
+                LOG_CAT_ERROR(Friends, "Failed to parse friend profiles: {}", profilesDecoder.error());
+                friends.resize(before);
             }
         }
 
-        LOG_INFO("Fetched {} friends", friends.size());
+        LOG_EVENT(Friends, Info, "friends.result", {"userId", userId}, {"count", friends.size()});
 
         if (friends.size() >= 1000) {
-            LOG_WARN("Friend list may be at the 1000 friend limit");
+            LOG_CAT_WARN(Friends, "Friend list may be at the 1000 friend limit");
         }
 
         return friends;
@@ -126,7 +184,7 @@ namespace Roblox {
     }
 
     FriendInfo getUserInfo(const std::string &userId) {
-        LOG_INFO("Fetching user info for {}", userId);
+        LOG_CAT_INFO(Friends, "Fetching user info for {}", userId);
 
         HttpClient::Response resp = HttpClient::get(
             "https://users.roblox.com/v1/users/" + userId,
@@ -136,7 +194,7 @@ namespace Roblox {
         );
 
         if (resp.status_code < 200 || resp.status_code >= 300) {
-            LOG_ERROR("Failed to fetch user info: HTTP {}", resp.status_code);
+            LOG_CAT_ERROR(Friends, "Failed to fetch user info: HTTP {}", resp.status_code);
             return FriendInfo {};
         }
 
@@ -199,7 +257,7 @@ namespace Roblox {
                 try {
                     d.followers = nlohmann::json::parse(resp.text).value("count", 0);
                 } catch (const std::exception &e) {
-                    LOG_ERROR("Failed to parse followers count: {}", e.what());
+                    LOG_CAT_ERROR(Friends, "Failed to parse followers count: {}", e.what());
                 }
             }
             signalDone();
@@ -211,7 +269,7 @@ namespace Roblox {
                 try {
                     d.following = nlohmann::json::parse(resp.text).value("count", 0);
                 } catch (const std::exception &e) {
-                    LOG_ERROR("Failed to parse following count: {}", e.what());
+                    LOG_CAT_ERROR(Friends, "Failed to parse following count: {}", e.what());
                 }
             }
             signalDone();
@@ -223,7 +281,7 @@ namespace Roblox {
                 try {
                     d.friends = nlohmann::json::parse(resp.text).value("count", 0);
                 } catch (const std::exception &e) {
-                    LOG_ERROR("Failed to parse friends count: {}", e.what());
+                    LOG_CAT_ERROR(Friends, "Failed to parse friends count: {}", e.what());
                 }
             }
             signalDone();
@@ -265,13 +323,13 @@ namespace Roblox {
         );
 
         if (resp.status_code < 200 || resp.status_code >= 300) {
-            LOG_ERROR("Username lookup failed: HTTP {}", resp.status_code);
+            LOG_CAT_ERROR(Friends, "Username lookup failed: HTTP {}", resp.status_code);
             return 0;
         }
 
         auto j = HttpClient::decode(resp);
         if (!j.contains("data") || j["data"].empty()) {
-            LOG_ERROR("Username not found: {}", username);
+            LOG_CAT_ERROR(Friends, "Username not found: {}", username);
             return 0;
         }
 
@@ -307,7 +365,7 @@ namespace Roblox {
         );
 
         if (resp.status_code < 200 || resp.status_code >= 300) {
-            LOG_ERROR("Failed to fetch incoming friend requests: HTTP {}", resp.status_code);
+            LOG_CAT_ERROR(Friends, "Failed to fetch incoming friend requests: HTTP {}", resp.status_code);
             return page;
         }
 
@@ -456,13 +514,13 @@ namespace Roblox {
         }
 
         std::string url = "https://friends.roblox.com/v1/users/" + targetUserId + "/accept-friend-request";
-        auto resp = authenticatedPost(url, cookie);
+        auto resp = HttpClient::rateLimitedRequest([&]() { return authenticatedPost(url, cookie); });
 
         if (resp.status_code >= 200 && resp.status_code < 300) {
             return {true, "Friend request accepted", ApiError::Success};
         }
 
-        return {false, resp.text, httpStatusToError(resp.status_code)};
+        return {false, resp.text, httpStatusToError(resp)};
     }
 
     SocialActionResult declineFriendRequest(const std::string &targetUserId, const std::string &cookie) {
@@ -472,13 +530,13 @@ namespace Roblox {
         }
 
         std::string url = "https://friends.roblox.com/v1/users/" + targetUserId + "/decline-friend-request";
-        auto resp = authenticatedPost(url, cookie);
+        auto resp = HttpClient::rateLimitedRequest([&]() { return authenticatedPost(url, cookie); });
 
         if (resp.status_code >= 200 && resp.status_code < 300) {
             return {true, "Friend request declined", ApiError::Success};
         }
 
-        return {false, resp.text, httpStatusToError(resp.status_code)};
+        return {false, resp.text, httpStatusToError(resp)};
     }
 
     SocialActionResult sendFriendRequest(const std::string &targetUserId, const std::string &cookie) {
@@ -490,12 +548,14 @@ namespace Roblox {
         std::string url = "https://friends.roblox.com/v1/users/" + targetUserId + "/request-friendship";
         nlohmann::json body = {{"friendshipOriginSourceType", 0}};
 
-        auto resp = HttpClient::rateLimitedRequest([&]() {
-            return authenticatedPost(url, cookie, body.dump());
-        });
+        // Sending a request twice is not harmless, so only failures that never reached Roblox are retried
+        auto resp = HttpClient::rateLimitedRequest(
+            [&]() { return authenticatedPost(url, cookie, body.dump()); },
+            {.idempotent = false}
+        );
 
         if (resp.status_code < 200 || resp.status_code >= 300) {
-            return {false, resp.text, httpStatusToError(resp.status_code)};
+            return {false, resp.text, httpStatusToError(resp)};
         }
 
         auto j = HttpClient::decode(resp);
@@ -519,7 +579,7 @@ namespace Roblox {
         }
 
         if (resp.status_code < 200 || resp.status_code >= 300) {
-            LOG_ERROR("Unfriend failed HTTP {}: {}", resp.status_code, resp.text);
+            LOG_CAT_ERROR(Friends, "Unfriend failed HTTP {}: {}", resp.status_code, resp.text);
             return false;
         }
 
@@ -533,13 +593,13 @@ namespace Roblox {
         }
 
         std::string url = "https://friends.roblox.com/v1/users/" + targetUserId + "/unfriend";
-        auto resp = authenticatedPost(url, cookie);
+        auto resp = HttpClient::rateLimitedRequest([&]() { return authenticatedPost(url, cookie); });
 
         if (resp.status_code >= 200 && resp.status_code < 300) {
             return {true, "Unfriended successfully", ApiError::Success};
         }
 
-        return {false, resp.text, httpStatusToError(resp.status_code)};
+        return {false, resp.text, httpStatusToError(resp)};
     }
 
     /*bool followUser(const std::string &targetUserId, const std::string &cookie, std::string *outResponse) {
@@ -566,13 +626,13 @@ namespace Roblox {
         }
 
         std::string url = "https://friends.roblox.com/v1/users/" + targetUserId + "/follow";
-        auto resp = authenticatedPost(url, cookie);
+        auto resp = HttpClient::rateLimitedRequest([&]() { return authenticatedPost(url, cookie); });
 
         if (resp.status_code >= 200 && resp.status_code < 300) {
             return {true, "Followed successfully", ApiError::Success};
         }
 
-        return {false, resp.text, httpStatusToError(resp.status_code)};
+        return {false, resp.text, httpStatusToError(resp)};
     }
 
     /*bool unfollowUser(const std::string &targetUserId, const std::string &cookie, std::string *outResponse) {
@@ -599,13 +659,13 @@ namespace Roblox {
         }
 
         std::string url = "https://friends.roblox.com/v1/users/" + targetUserId + "/unfollow";
-        auto resp = authenticatedPost(url, cookie);
+        auto resp = HttpClient::rateLimitedRequest([&]() { return authenticatedPost(url, cookie); });
 
         if (resp.status_code >= 200 && resp.status_code < 300) {
             return {true, "Unfollowed successfully", ApiError::Success};
         }
 
-        return {false, resp.text, httpStatusToError(resp.status_code)};
+        return {false, resp.text, httpStatusToError(resp)};
     }
 
     /*bool blockUser(const std::string &targetUserId, const std::string &cookie, std::string *outResponse) {
@@ -632,13 +692,13 @@ namespace Roblox {
         }
 
         std::string url = "https://www.roblox.com/users/" + targetUserId + "/block";
-        auto resp = authenticatedPost(url, cookie);
+        auto resp = HttpClient::rateLimitedRequest([&]() { return authenticatedPost(url, cookie); });
 
         if (resp.status_code >= 200 && resp.status_code < 300) {
             return {true, "Blocked successfully", ApiError::Success};
         }
 
-        return {false, resp.text, httpStatusToError(resp.status_code)};
+        return {false, resp.text, httpStatusToError(resp)};
     }
 
 } // namespace Roblox
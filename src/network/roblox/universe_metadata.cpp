@@ -0,0 +1,182 @@
+#include "universe_metadata.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <unordered_set>
+
+#include "console/console.h"
+#include "utils/shutdown_manager.h"
+#include "utils/worker_thread.h"
+
+namespace Roblox {
+
+    namespace {
+        // Long enough for a UI frame's worth of lookups to share a request
+        constexpr auto COALESCE_WINDOW = std::chrono::milliseconds(30);
+        constexpr auto METADATA_TTL = std::chrono::minutes(10);
+        // A universe the API did not return stays gone for a while; other failures clear up sooner
+        constexpr auto NOT_FOUND_TTL = std::chrono::minutes(5);
+        constexpr auto FAILURE_TTL = std::chrono::seconds(30);
+        constexpr auto WAIT_SLICE = std::chrono::milliseconds(250);
+    } // namespace
+
+    UniverseMetadata &UniverseMetadata::instance() {
+        static UniverseMetadata metadata;
+        return metadata;
+    }
+
+    UniverseMetadata::UniverseMetadata()
+        : m_details(std::chrono::duration_cast<std::chrono::seconds>(METADATA_TTL)),
+          m_summaries(std::chrono::duration_cast<std::chrono::seconds>(METADATA_TTL)),
+          m_failures(FAILURE_TTL) {}
+
+    std::optional<GameDetail> UniverseMetadata::cached(uint64_t universeId) const {
+        return m_details.get(universeId);
+    }
+
+    std::optional<GameInfo> UniverseMetadata::summary(uint64_t universeId) const {
+        if (auto info = m_summaries.get(universeId)) {
+            return info;
+        }
+        auto detail = m_details.get(universeId);
+        if (!detail) {
+            return std::nullopt;
+        }
+
+        GameInfo info;
+        info.name = detail->name;
+        info.universeId = universeId;
+        info.placeId = detail->rootPlaceId;
+        info.playerCount = detail->playing;
+        info.creatorName = detail->creatorName;
+        info.creatorVerified = detail->creatorVerified;
+        return info;
+    }
+
+    void UniverseMetadata::prefetch(std::span<const uint64_t> universeIds) {
+        std::lock_guard lock(m_mutex);
+        for (uint64_t id: universeIds) {
+            if (id != 0 && !m_pending.contains(id) && !m_details.get(id) && !m_failures.get(id)) {
+                enqueue(id);
+            }
+        }
+    }
+
+    ApiResult<GameDetail> UniverseMetadata::get(uint64_t universeId) {
+        if (universeId == 0) {
+            return std::unexpected(ApiError::InvalidInput);
+        }
+
+        std::shared_future<Result> future;
+        {
+            std::lock_guard lock(m_mutex);
+            if (auto detail = m_details.get(universeId)) {
+                return *detail;
+            }
+            if (auto error = m_failures.get(universeId)) {
+                return std::unexpected(*error);
+            }
+            if (auto it = m_pending.find(universeId); it != m_pending.end()) {
+                future = it->second.future;
+            } else {
+                future = enqueue(universeId);
+            }
+        }
+
+        // The flush never runs once shutdown has begun, so do not wait on it forever
+        while (future.wait_for(WAIT_SLICE) != std::future_status::ready) {
+            if (ShutdownManager::instance().isShuttingDown()) {
+                return std::unexpected(ApiError::NetworkError);
+            }
+        }
+        return future.get();
+    }
+
+    void UniverseMetadata::rememberSearchResults(const std::vector<GameInfo> &games) {
+        for (const auto &game: games) {
+            if (game.universeId != 0) {
+                m_summaries.set(game.universeId, game);
+            }
+        }
+    }
+
+    void UniverseMetadata::clear() {
+        m_details.clear();
+        m_summaries.clear();
+        m_failures.clear();
+    }
+
+    std::shared_future<UniverseMetadata::Result> UniverseMetadata::enqueue(uint64_t universeId) {
+        auto &pending = m_pending[universeId];
+        pending.future = pending.promise.get_future().share();
+        m_queue.push_back(universeId);
+
+        if (!m_flushScheduled) {
+            m_flushScheduled = true;
+            WorkerThreads::runBackground([this] {
+                std::this_thread::sleep_for(COALESCE_WINDOW);
+                flush();
+            });
+        }
+        return pending.future;
+    }
+
+    void UniverseMetadata::flush() {
+        std::vector<uint64_t> ids;
+        {
+            std::lock_guard lock(m_mutex);
+            ids.swap(m_queue);
+            m_flushScheduled = false;
+        }
+
+        for (size_t start = 0; start < ids.size(); start += MAX_BATCH) {
+            const std::span<const uint64_t> chunk(ids.data() + start, std::min(MAX_BATCH, ids.size() - start));
+            auto details = getGameDetails(chunk);
+
+            if (!details) {
+                for (uint64_t id: chunk) {
+                    m_failures.set(id, details.error());
+                    settle(id, std::unexpected(details.error()));
+                }
+                continue;
+            }
+
+            std::unordered_set<uint64_t> missing(chunk.begin(), chunk.end());
+            for (auto &detail: *details) {
+                const uint64_t id = detail.universeId;
+                if (missing.erase(id) == 0) {
+                    continue;
+                }
+                m_details.set(id, detail);
+                settle(id, std::move(detail));
+            }
+            for (uint64_t id: missing) {
+                m_failures.set(id, ApiError::NotFound, std::chrono::duration_cast<std::chrono::seconds>(NOT_FOUND_TTL));
+                settle(id, std::unexpected(ApiError::NotFound));
+            }
+
+            LOG_CAT_DEBUG(
+                Games,
+                "Fetched {} of {} universes in one request",
+                chunk.size() - missing.size(),
+                chunk.size()
+            );
+        }
+    }
+
+    void UniverseMetadata::settle(uint64_t universeId, Result result) {
+        std::promise<Result> promise;
+        {
+            std::lock_guard lock(m_mutex);
+            auto it = m_pending.find(universeId);
+            if (it == m_pending.end()) {
+                return;
+            }
+            promise = std::move(it->second.promise);
+            m_pending.erase(it);
+        }
+        promise.set_value(std::move(result));
+    }
+
+} // namespace Roblox
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "common.h"
+#include "games.h"
+
+namespace Roblox {
+
+    // Shared universe metadata. Lookups are queued and, after a short window, sent as multi-id
+    // /v1/games requests, so a list of favorites or history entries costs a handful of requests
+    // rather than one per universe. Results live in a TTL cache that search results also feed.
+    class UniverseMetadata {
+        public:
+            static constexpr size_t MAX_BATCH = 50; // universeIds limit of /v1/games
+
+            static UniverseMetadata &instance();
+
+            UniverseMetadata(const UniverseMetadata &) = delete;
+            UniverseMetadata &operator=(const UniverseMetadata &) = delete;
+
+            // Cached detail only, never fetches
+            [[nodiscard]] std::optional<GameDetail> cached(uint64_t universeId) const;
+            // Summary from a recent search, or derived from a cached detail
+            [[nodiscard]] std::optional<GameInfo> summary(uint64_t universeId) const;
+
+            // Queues every id that is neither cached, recently failed nor already requested; returns immediately
+            void prefetch(std::span<const uint64_t> universeIds);
+            // Blocks until the batch carrying universeId has landed
+            ApiResult<GameDetail> get(uint64_t universeId);
+
+            void rememberSearchResults(const std::vector<GameInfo> &games);
+            void clear();
+
+        private:
+            using Result = ApiResult<GameDetail>;
+
+            struct Pending {
+                    std::promise<Result> promise;
+                    std::shared_future<Result> future;
+            };
+
+            UniverseMetadata();
+
+            // Caller holds m_mutex
+            std::shared_future<Result> enqueue(uint64_t universeId);
+            void flush();
+            void settle(uint64_t universeId, Result result);
+
+            TtlCache<uint64_t, GameDetail> m_details;
+            TtlCache<uint64_t, GameInfo> m_summaries;
+            // Ids whose last lookup failed, so per-frame prefetches do not ask again every flush
+            TtlCache<uint64_t, ApiError> m_failures;
+
+            std::mutex m_mutex;
+            std::vector<uint64_t> m_queue;
+            std::unordered_map<uint64_t, Pending> m_pending;
+            bool m_flushScheduled = false;
+    };
+
+} // namespace Roblox
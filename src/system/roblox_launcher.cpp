@@ -12,6 +12,7 @@
 
 #include "components/data.h"
 #include "console/console.h"
+#include "console/trace.h"
 #include "multi_instance.h"
 #include "network/http.h"
 #include "network/roblox/auth.h"
@@ -24,6 +25,10 @@
 #include "utils/worker_thread.h"
 #include "system/system_info.h"
 
+// Everything a launch needs from the network (ticket, place and server lookups) must land in this
+// window, or the launch is reported as failed instead of hanging
+constexpr auto LAUNCH_DEADLINE = std::chrono::seconds(10);
+
 LaunchParams LaunchParams::standard(uint64_t placeId) {
     return {LaunchMode::Job, placeId, ""};
 }
@@ -66,7 +71,7 @@ bool resolvePrivateServer(
     bool isDirectLink = !isShareLink && std::regex_search(link, match, directLinkRegex);
 
     if (!isShareLink && !isDirectLink) {
-        LOG_ERROR("Invalid private server link.");
+        LOG_CAT_ERROR(Launcher, "Invalid private server link.");
         return false;
     }
 
@@ -84,7 +89,7 @@ bool resolvePrivateServer(
         );
 
         if (apiResponse.status_code != 200) {
-            LOG_ERROR("Share resolve failed: HTTP {}", apiResponse.status_code);
+            LOG_CAT_ERROR(Launcher, "Share resolve failed: HTTP {}", apiResponse.status_code);
             return false;
         }
 
@@ -94,13 +99,13 @@ bool resolvePrivateServer(
             if (jsonResponse.contains("status") && jsonResponse["status"].is_string()) {
                 const auto &status = jsonResponse["status"].get<std::string>();
                 if (status == "Expired") {
-                    LOG_ERROR("This private server link is no longer valid.");
+                    LOG_CAT_ERROR(Launcher, "This private server link is no longer valid.");
                     return false;
                 }
             }
 
             if (!jsonResponse.contains("privateServerInviteData")) {
-                LOG_ERROR("Missing invite data.");
+                LOG_CAT_ERROR(Launcher, "Missing invite data.");
                 return false;
             }
 
@@ -109,7 +114,7 @@ bool resolvePrivateServer(
             linkCode = invite["linkCode"].get<std::string>();
 
         } catch (std::exception &e) {
-            LOG_ERROR("JSON parse error: {}", e.what());
+            LOG_CAT_ERROR(Launcher, "JSON parse error: {}", e.what());
             return false;
         }
     }
@@ -135,7 +140,7 @@ bool resolvePrivateServer(
     if (std::regex_search(pageResponse.text, accessMatch, accessCodeRegex) && accessMatch.size() == 3) {
         accessCode = accessMatch[1].str();
     } else {
-        LOG_ERROR("This private server link is no longer valid.");
+        LOG_CAT_ERROR(Launcher, "This private server link is no longer valid.");
         return false;
     }
 
@@ -250,51 +255,82 @@ std::string buildProtocolCommand(
 #ifdef _WIN32
 
 bool startRoblox(const LaunchParams &params, AccountData acc) {
-    auto ticket = Roblox::fetchAuthTicket(acc.cookie);
+    HttpClient::DeadlineScope deadline(LAUNCH_DEADLINE);
+    HttpClient::PriorityScope priority(HttpClient::RequestPriority::Launch);
+    HttpClient::AccountScope account(acc.id);
+    Console::TraceSpan span(Console::Category::Launcher, "launch.account");
+    span.Detail(acc.username);
+
+    std::string ticket;
+    {
+        TRACE_SPAN(Launcher, "launch.ticket");
+        ticket = Roblox::fetchAuthTicket(acc.cookie);
+    }
     if (ticket.empty()) {
-        LOG_ERROR("Failed to get authentication ticket");
+        LOG_CAT_ERROR(Launcher, "Failed to get authentication ticket");
         return false;
     }
 
     const auto browserTrackerId = generateBrowserTrackerId();
     const auto timestamp = getCurrentTimestampMs();
 
-    auto urls = buildLaunchUrls(params, browserTrackerId, acc.cookie);
+    auto urls = [&] {
+        TRACE_SPAN(Launcher, "launch.resolve");
+        return buildLaunchUrls(params, browserTrackerId, acc.cookie);
+    }();
     if (!urls) {
         return false;
     }
 
     if (acc.username.empty()) {
-        LOG_ERROR("Username is empty or invalid");
+        LOG_CAT_ERROR(Launcher, "Username is empty or invalid");
         return false;
     }
 
     const auto &launchUrl = urls->desktop;
     const auto protocolCommand = buildProtocolCommand(false, ticket, timestamp, launchUrl, browserTrackerId);
 
-    if (!SystemInfo::LaunchProcess(protocolCommand)) {
-        LOG_ERROR("failed for Roblox launch.");
+    bool launched = false;
+    {
+        TRACE_SPAN(Launcher, "launch.spawn");
+        launched = SystemInfo::LaunchProcess(protocolCommand);
+    }
+    if (!launched) {
+        LOG_CAT_ERROR(Launcher, "failed for Roblox launch.");
         return false;
     }
 
     std::this_thread::sleep_for(std::chrono::milliseconds(1000));
-    LOG_INFO("Roblox launched for account: {}", acc.username);
+    LOG_CAT_INFO(Launcher, "Roblox launched for account: {}", acc.username);
     return true;
 }
 
 #elif __APPLE__
 
 bool startRoblox(const LaunchParams &params, AccountData acc) {
-    auto ticket = Roblox::fetchAuthTicket(acc.cookie);
+    HttpClient::DeadlineScope deadline(LAUNCH_DEADLINE);
+    HttpClient::PriorityScope priority(HttpClient::RequestPriority::Launch);
+    HttpClient::AccountScope account(acc.id);
+    Console::TraceSpan span(Console::Category::Launcher, "launch.account");
+    span.Detail(acc.username);
+
+    std::string ticket;
+    {
+        TRACE_SPAN(Launcher, "launch.ticket");
+        ticket = Roblox::fetchAuthTicket(acc.cookie);
+    }
     if (ticket.empty()) {
-        LOG_ERROR("Failed to get authentication ticket");
+        LOG_CAT_ERROR(Launcher, "Failed to get authentication ticket");
         return false;
     }
 
     const auto browserTrackerId = generateBrowserTrackerId();
     const auto timestamp = getCurrentTimestampMs();
 
-    auto urls = buildLaunchUrls(params, browserTrackerId, acc.cookie);
+    auto urls = [&] {
+        TRACE_SPAN(Launcher, "launch.resolve");
+        return buildLaunchUrls(params, browserTrackerId, acc.cookie);
+    }();
     if (!urls) {
         return false;
     }
@@ -304,7 +340,7 @@ bool startRoblox(const LaunchParams &params, AccountData acc) {
     const auto protocolCommand = buildProtocolCommand(isMobile, ticket, timestamp, launchUrl, browserTrackerId);
 
     if (acc.username.empty()) {
-        LOG_ERROR("Username is empty or invalid");
+        LOG_CAT_ERROR(Launcher, "Username is empty or invalid");
         return false;
     }
 
@@ -315,8 +351,13 @@ bool startRoblox(const LaunchParams &params, AccountData acc) {
         Data::SaveAccounts();
     }*/
 
-    if (!MultiInstance::createSandboxedRoblox(acc, protocolCommand)) {
-        LOG_ERROR("Failed to create sandboxed client instance");
+    bool launched = false;
+    {
+        TRACE_SPAN(Launcher, "launch.spawn");
+        launched = MultiInstance::createSandboxedRoblox(acc, protocolCommand);
+    }
+    if (!launched) {
+        LOG_CAT_ERROR(Launcher, "Failed to create sandboxed client instance");
         return false;
     }
 
@@ -327,6 +368,8 @@ bool startRoblox(const LaunchParams &params, AccountData acc) {
 #endif // APPLE
 
 void launchWithAccounts(const LaunchParams &params, const std::vector<AccountData> &accounts) {
+    TRACE_SPAN(Launcher, "launch");
+
     if (g_killRobloxOnLaunch) {
         RobloxControl::KillRobloxProcesses();
     }
@@ -338,9 +381,9 @@ void launchWithAccounts(const LaunchParams &params, const std::vector<AccountDat
         const bool success = startRoblox(params, acc);
 
         if (success) {
-            LOG_INFO("Roblox launched for account ID: {}", acc.id);
+            LOG_CAT_INFO(Launcher, "Roblox launched for account ID: {}", acc.id);
         } else {
-            LOG_ERROR("Failed to start Roblox for account ID: {}", acc.id);
+            LOG_CAT_ERROR(Launcher, "Failed to start Roblox for account ID: {}", acc.id);
         }
     }
 }
@@ -2,9 +2,15 @@
 #define UI_H
 
 #include <cstdint>
+#include <string>
+
+struct ImVec4;
 
 bool RenderUI();
 
+// Text colour for an account status or a presence
+ImVec4 getStatusColor(const std::string &statusCode);
+
 constexpr int JOIN_VALUE_BUF_SIZE = 256;
 constexpr int JOIN_JOBID_BUF_SIZE = 256;
 
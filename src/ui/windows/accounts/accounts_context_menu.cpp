@@ -2,8 +2,10 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cctype>
 #include <chrono>
 #include <cstring>
+#include <expected>
 #include <format>
 #include <memory>
 #include <random>
@@ -21,6 +23,7 @@
 #include "accounts_join_ui.h"
 #include "components/data.h"
 #include "console/console.h"
+#include "network/http.h"
 #include "network/roblox/auth.h"
 #include "network/roblox/common.h"
 #include "network/roblox/games.h"
@@ -77,6 +80,8 @@ namespace {
     };
 
     EditNoteState g_editNote;
+    EditNoteState g_editProxy;
+    std::string g_editProxyError;
     UrlPopupState g_customUrl;
     MultiUrlPopupState g_multiUrl;
     std::unordered_set<int> g_presenceFetchInFlight;
@@ -137,6 +142,7 @@ namespace {
         g_presenceFetchInFlight.insert(accountId);
         WorkerThreads::runBackground([accountId, userIdStr = std::string(userId), cookieCopy = std::string(cookie)]() {
             try {
+                HttpClient::AccountScope accountScope(accountId);
                 const uint64_t uid = std::stoull(userIdStr);
                 const auto presenceMap = Roblox::getPresences({uid}, cookieCopy);
 
@@ -187,9 +193,11 @@ namespace {
 
         ImGui::PushStyleColor(ImGuiCol_Text, getStatusColor("Warned"));
         if (ImGui::MenuItem("Launch Link", nullptr, false, hasCookie)) {
-            WorkerThreads::runBackground([cookie = account.cookie,
+            WorkerThreads::runBackground([accountId = account.id,
+                                          cookie = account.cookie,
                                           placeId = std::string(join_value_buf),
                                           jobId = std::string(join_jobid_buf)]() {
+                HttpClient::AccountScope accountScope(accountId);
                 const auto ticket = Roblox::fetchAuthTicket(cookie);
                 if (ticket.empty()) {
                     return;
@@ -260,6 +268,7 @@ namespace {
                 [accounts, placeId = std::string(join_value_buf), jobId = std::string(join_jobid_buf)]() {
                     std::string result;
                     for (const auto &[id, cookie]: accounts) {
+                        HttpClient::AccountScope accountScope(id);
                         const auto ticket = Roblox::fetchAuthTicket(cookie);
                         if (ticket.empty()) {
                             continue;
@@ -374,6 +383,102 @@ namespace {
         ImGui::PopStyleColor();
     }
 
+    constexpr std::string_view PROXY_SCHEMES[] = {"http", "https", "socks5", "socks5h"};
+
+    // The proxy URL as it will be stored, empty for direct, or why it cannot be used. Without a
+    // scheme curl would guess one, so it has to be spelled out.
+    std::expected<std::string, std::string> normalizeProxy(std::string_view input) {
+        const auto isSpace = [](char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; };
+        while (!input.empty() && isSpace(input.front())) {
+            input.remove_prefix(1);
+        }
+        while (!input.empty() && isSpace(input.back())) {
+            input.remove_suffix(1);
+        }
+        if (input.empty()) {
+            return std::string();
+        }
+        if (std::ranges::any_of(input, isSpace)) {
+            return std::unexpected("The proxy URL cannot contain spaces");
+        }
+
+        const size_t separator = input.find("://");
+        if (separator == std::string_view::npos) {
+            return std::unexpected("Start the proxy URL with http://, https://, socks5:// or socks5h://");
+        }
+        std::string scheme(input.substr(0, separator));
+        std::ranges::transform(scheme, scheme.begin(), [](unsigned char c) { return std::tolower(c); });
+        if (std::ranges::find(PROXY_SCHEMES, std::string_view(scheme)) == std::end(PROXY_SCHEMES)) {
+            return std::unexpected(std::format("Unsupported proxy scheme '{}'", scheme));
+        }
+
+        std::string_view authority = input.substr(separator + 3);
+        authority = authority.substr(0, authority.find('/'));
+        if (const size_t at = authority.rfind('@'); at != std::string_view::npos) {
+            authority.remove_prefix(at + 1);
+        }
+        if (authority.empty() || authority.front() == ':') {
+            return std::unexpected("The proxy URL has no host");
+        }
+        return scheme + std::string(input.substr(separator));
+    }
+
+    void applyProxy(const std::vector<AccountData *> &accounts, const std::string &proxy) {
+        for (auto *acc: accounts) {
+            acc->proxy = proxy;
+            HttpClient::setAccountProxy(acc->id, acc->proxy, acc->cookie);
+        }
+        Data::SaveAccounts();
+    }
+
+    // One menu for one or many accounts: giving a group of accounts the same proxy is the usual case
+    void renderProxyMenu(const std::vector<AccountData *> &accounts) {
+        if (accounts.empty()) {
+            return;
+        }
+
+        const int editKey = accounts.size() == 1 ? accounts.front()->id : MULTI_EDIT_SENTINEL;
+        if (g_editProxy.accountId != editKey) {
+            const auto &first = accounts.front()->proxy;
+            const bool allSame = std::ranges::all_of(accounts, [&first](const auto *acc) {
+                return acc->proxy == first;
+            });
+            copyInto(g_editProxy.buffer, allSame ? std::string_view(first) : std::string_view());
+            g_editProxy.accountId = editKey;
+            g_editProxyError.clear();
+        }
+
+        ImGui::TextDisabled("http://, https://, socks5:// or socks5h://, user:pass@ allowed");
+        ImGui::PushItemWidth(ImGui::GetFontSize() * 15.625f);
+        if (ImGui::InputTextWithHint("##EditProxyInput", "Direct", g_editProxy.buffer, sizeof(g_editProxy.buffer))) {
+            g_editProxyError.clear();
+        }
+        ImGui::PopItemWidth();
+        if (!g_editProxyError.empty()) {
+            ImGui::PushStyleColor(ImGuiCol_Text, getStatusColor("Banned"));
+            ImGui::TextUnformatted(g_editProxyError.c_str());
+            ImGui::PopStyleColor();
+        }
+
+        if (ImGui::Button("Save##Proxy")) {
+            if (const auto proxy = normalizeProxy(g_editProxy.buffer)) {
+                applyProxy(accounts, *proxy);
+                g_editProxy.accountId = -1;
+                ImGui::CloseCurrentPopup();
+            } else {
+                g_editProxyError = proxy.error();
+            }
+        }
+
+        ImGui::Separator();
+        ImGui::PushStyleColor(ImGuiCol_Text, getStatusColor("Banned"));
+        if (ImGui::MenuItem("Use Direct Connection")) {
+            applyProxy(accounts, {});
+            g_editProxy.accountId = -1;
+        }
+        ImGui::PopStyleColor();
+    }
+
     void renderBrowserMenuSingle(const AccountData &account) {
         const auto open = [&account](std::string_view url) {
             if (!account.cookie.empty()) {
@@ -766,6 +871,7 @@ namespace {
         state.visibilityErrorMessage.clear();
 
         WorkerThreads::runBackground([accountId, cookieCopy = cookie]() {
+            HttpClient::AccountScope accountScope(accountId);
             auto result = Roblox::getOnlineStatusVisibility(cookieCopy);
 
             auto& state = g_visibilityStates[accountId];
@@ -790,6 +896,7 @@ namespace {
         state.joinRestrictionErrorMessage.clear();
 
         WorkerThreads::runBackground([accountId, cookieCopy = cookie]() {
+            HttpClient::AccountScope accountScope(accountId);
             auto result = Roblox::getJoinRestriction(cookieCopy);
 
             auto& state = g_visibilityStates[accountId];
@@ -809,6 +916,7 @@ namespace {
         state.isLoadingVisibility = true;
 
         WorkerThreads::runBackground([accountId, cookieCopy = cookie, visibility]() {
+            HttpClient::AccountScope accountScope(accountId);
             auto result = Roblox::setOnlineStatusVisibility(cookieCopy, visibility);
 
             auto& state = g_visibilityStates[accountId];
@@ -829,6 +937,7 @@ namespace {
         state.isLoadingJoinRestriction = true;
 
         WorkerThreads::runBackground([accountId, cookieCopy = cookie, restriction]() {
+            HttpClient::AccountScope accountScope(accountId);
             auto result = Roblox::setJoinRestriction(cookieCopy, restriction);
 
             auto& state = g_visibilityStates[accountId];
@@ -1015,6 +1124,15 @@ void RenderAccountContextMenu(AccountData &account, const std::string &uniqueCon
         ImGui::EndMenu();
     }
 
+    if (ImGui::BeginMenu("Proxy")) {
+        if (isMultiSelection) {
+            renderProxyMenu(getSelectedAccountsOrderedMutable());
+        } else {
+            renderProxyMenu({&account});
+        }
+        ImGui::EndMenu();
+    }
+
     if (!g_accountGroups.empty() && ImGui::BeginMenu("Groups")) {
         std::vector<int> targetIds;
         if (isMultiSelection) {
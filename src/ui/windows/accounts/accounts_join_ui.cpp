@@ -316,6 +316,7 @@ namespace {
                     return;
                 }
 
+                HttpClient::AccountScope accountScope(accounts.front().id);
                 const uint64_t uid = spec.isId ? spec.id : Roblox::getUserIdFromUsername(spec.username);
                 const auto presenceMap = Roblox::getPresences({uid}, accounts.front().cookie);
 
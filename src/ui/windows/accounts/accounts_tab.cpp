@@ -135,6 +135,7 @@ namespace {
         const std::string cookie = account.cookie;
 
         WorkerThreads::runBackground([accountId, cookie]() {
+            HttpClient::AccountScope accountScope(accountId);
             const auto voiceStatus = Roblox::getVoiceChatStatus(cookie);
             WorkerThreads::RunOnMain([accountId, voiceStatus]() {
                 if (AccountData *acc = getAccountById(accountId)) {
@@ -11,6 +11,7 @@
 #include <expected>
 #include <format>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -135,7 +136,8 @@ namespace {
     }
 
     [[nodiscard]]
-    std::pair<uint64_t, std::string> GetCurrentUserInfo() {
+    std::tuple<int, uint64_t, std::string> GetCurrentUserInfo() {
+        int ownerId = 0;
         uint64_t userId = 0;
         std::string cookie;
 
@@ -144,6 +146,7 @@ namespace {
                 if (!acc->userId.empty()) {
                     auto result = parseUserId(acc->userId);
                     if (result) {
+                        ownerId = acc->id;
                         userId = *result;
                         cookie = acc->cookie;
                         return true;
@@ -159,7 +162,7 @@ namespace {
             tryGetUserInfo(g_defaultAccountId);
         }
 
-        return {userId, cookie};
+        return {ownerId, userId, cookie};
     }
 
     void FetchAvatarImage(uint64_t userId) {
@@ -223,10 +226,11 @@ namespace {
         });
     }
 
-    void FetchCategories(uint64_t userId, std::string cookie) {
+    void FetchCategories(int accountId, uint64_t userId, std::string cookie) {
         g_categoryState.loading = true;
 
-        WorkerThreads::runBackground([userId, cookie = std::move(cookie)] {
+        WorkerThreads::runBackground([accountId, userId, cookie = std::move(cookie)] {
+            HttpClient::AccountScope accountScope(accountId);
             const std::string url = std::format("https://inventory.roblox.com/v1/users/{}/categories", userId);
 
             auto resp = HttpClient::rateLimitedGet(
@@ -466,11 +470,12 @@ namespace {
         QueueThumbnailForBatch(assetId);
     }
 
-    void FetchInventory(uint64_t userId, std::string cookie, int assetTypeId) {
+    void FetchInventory(int accountId, uint64_t userId, std::string cookie, int assetTypeId) {
         g_inventoryState.loading = true;
         g_inventoryState.failed = false;
 
-        WorkerThreads::runBackground([userId, cookie = std::move(cookie), assetTypeId] {
+        WorkerThreads::runBackground([accountId, userId, cookie = std::move(cookie), assetTypeId] {
+            HttpClient::AccountScope accountScope(accountId);
             std::vector<InventoryItem> items;
             std::string cursor;
             bool anyError = false;
@@ -804,7 +809,7 @@ namespace {
         }
     }
 
-    void RenderInventoryPane(uint64_t userId, std::string cookie) {
+    void RenderInventoryPane(int accountId, uint64_t userId, std::string cookie) {
         ImGui::BeginChild("AvatarInventoryPane", ImVec2(0, 0), true);
 
         if (g_categoryState.loading) {
@@ -851,7 +856,7 @@ namespace {
 
         auto itInv = g_inventoryState.cachedInventories.find(assetTypeId);
         if (itInv == g_inventoryState.cachedInventories.end() && !g_inventoryState.loading) {
-            FetchInventory(userId, std::move(cookie), assetTypeId);
+            FetchInventory(accountId, userId, std::move(cookie), assetTypeId);
         }
 
         if (g_inventoryState.loading) {
@@ -876,7 +881,7 @@ namespace {
 } // namespace
 
 void RenderInventoryTab() {
-    auto [currentUserId, currentCookie] = GetCurrentUserInfo();
+    auto [currentAccountId, currentUserId, currentCookie] = GetCurrentUserInfo();
 
     if (currentUserId != g_avatarState.loadedUserId) {
         g_avatarState.started = false;
@@ -902,7 +907,7 @@ void RenderInventoryTab() {
 
     if (g_categoryState.userId != 0 && !g_categoryState.loading && g_categoryState.categories.empty()
         && !g_categoryState.failed) {
-        FetchCategories(currentUserId, currentCookie);
+        FetchCategories(currentAccountId, currentUserId, currentCookie);
     }
 
     const float availWidth = ImGui::GetContentRegionAvail().x;
@@ -910,5 +915,5 @@ void RenderInventoryTab() {
 
     RenderAvatarPane(leftWidth, currentUserId);
     ImGui::SameLine();
-    RenderInventoryPane(currentUserId, currentCookie);
+    RenderInventoryPane(currentAccountId, currentUserId, currentCookie);
 }
@@ -1,42 +1,91 @@
 #include "console/console.h"
+#include "console/log_file_sink.h"
+#include "console/log_ring_buffer.h"
+#include "console/trace.h"
+#include "components/data.h"
+#include "network/http.h"
+#include "utils/paths.h"
 
 #include <imgui.h>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cctype>
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <deque>
 #include <format>
-#include <iomanip>
+#include <iterator>
+#include <memory>
 #include <mutex>
-#include <sstream>
+#include <shared_mutex>
 #include <string>
 #include <thread>
+#include <type_traits>
+#include <variant>
 #include <vector>
 
 struct LogEntry {
-        Console::Level level;
-        std::string text;
+        Console::Level level = Console::Level::Info;
+        Console::Category category = Console::Category::General;
+        std::chrono::system_clock::time_point time;
+        std::string message;
+        std::vector<Console::Field> fields;
+        std::string searchText {}; // formatEntry() lowercased, filled and kept only while a search is active
 };
 
-static std::vector<LogEntry> g_logMessages;
+namespace {
+    constexpr size_t QUEUE_CAPACITY = 8192;
+    constexpr auto LOGGER_IDLE_WAIT = std::chrono::milliseconds(50);
+    constexpr auto SUPPRESSED_SUMMARY_INTERVAL = std::chrono::seconds(30);
+
+    Console::RingBuffer<LogEntry> &pendingLogs() {
+        static Console::RingBuffer<LogEntry> queue(QUEUE_CAPACITY);
+        return queue;
+    }
+} // namespace
+
+static std::deque<LogEntry> g_logMessages;
 static std::mutex g_logMutex;
+static std::atomic<size_t> g_logRetention {Console::DEFAULT_RETENTION};
 
-static std::string g_latestStatusMessage = "Ready.";
+static LogEntry g_latestStatusEntry {Console::Level::Info, Console::Category::General, {}, "Ready.", {}};
 static std::mutex g_statusMessageMutex;
 
-static std::vector<LogEntry> g_pendingLogs;
-static std::mutex g_queueMutex;
+static std::atomic<uint64_t> g_droppedQueueFull {0};
+static std::atomic<uint64_t> g_droppedRetention {0};
+
+struct VolumeCounter {
+        std::atomic<uint64_t> messages {0};
+        std::atomic<uint64_t> bytes {0};
+};
+
+static std::array<VolumeCounter, static_cast<size_t>(Console::Category::Count)> g_categoryVolume;
+
+static std::mutex g_wakeMutex;
 static std::condition_variable g_logCv;
 
-static bool g_loggerRunning = true;
+static std::atomic_bool g_loggerRunning {false};
 static std::thread g_loggerThread;
 
 static char g_searchBuffer[256] = "";
+static bool g_searchCached = false; // some entries hold a searchText; guarded by g_logMutex
 
-static std::string getCurrentTimestamp() {
-    auto now = std::chrono::system_clock::now();
-    auto in_time_t = std::chrono::system_clock::to_time_t(now);
+static std::string formatBytes(uint64_t bytes) {
+    if (bytes >= 1024 * 1024) {
+        return std::format("{:.1f} MB", static_cast<double>(bytes) / (1024.0 * 1024.0));
+    }
+    if (bytes >= 1024) {
+        return std::format("{:.1f} KB", static_cast<double>(bytes) / 1024.0);
+    }
+    return std::format("{} B", bytes);
+}
+
+static std::string formatClock(std::chrono::system_clock::time_point time) {
+    auto in_time_t = std::chrono::system_clock::to_time_t(time);
     std::tm buf {};
 
 #ifdef _WIN32
@@ -45,9 +94,7 @@ static std::string getCurrentTimestamp() {
     localtime_r(&in_time_t, &buf);
 #endif
 
-    std::ostringstream ss;
-    ss << std::put_time(&buf, "%H:%M:%S");
-    return ss.str();
+    return std::format("{:02}:{:02}:{:02}", buf.tm_hour, buf.tm_min, buf.tm_sec);
 }
 
 static std::string toLower(std::string s) {
@@ -59,6 +106,8 @@ static std::string toLower(std::string s) {
 
 static const char *LevelPrefix(Console::Level level) {
     switch (level) {
+        case Console::Level::Debug:
+            return "[DEBUG]";
         case Console::Level::Info:
             return "[INFO]";
         case Console::Level::Warn:
@@ -69,67 +118,261 @@ static const char *LevelPrefix(Console::Level level) {
     return "[UNK]";
 }
 
-static void LoggerThreadFunc() {
-    while (g_loggerRunning) {
-        std::unique_lock<std::mutex> lock(g_queueMutex);
-        g_logCv.wait(lock, [] {
-            return !g_pendingLogs.empty() || !g_loggerRunning;
-        });
+static void appendFields(std::string &out, const std::vector<Console::Field> &fields) {
+    for (const auto &field: fields) {
+        std::format_to(std::back_inserter(out), " {}=", field.key);
+        std::visit(
+            [&out](const auto &v) {
+                using T = std::decay_t<decltype(v)>;
+                if constexpr (std::is_same_v<T, std::string>) {
+                    if (v.find(' ') != std::string::npos) {
+                        std::format_to(std::back_inserter(out), "\"{}\"", v);
+                    } else {
+                        out += v;
+                    }
+                } else {
+                    std::format_to(std::back_inserter(out), "{}", v);
+                }
+            },
+            field.value
+        );
+    }
+}
 
-        while (!g_pendingLogs.empty()) {
-            LogEntry entry = std::move(g_pendingLogs.front());
-            g_pendingLogs.erase(g_pendingLogs.begin());
-            lock.unlock();
+static std::string formatEntry(const LogEntry &entry) {
+    std::string out = std::format("[{}] {} {}", formatClock(entry.time), LevelPrefix(entry.level), entry.message);
+    appendFields(out, entry.fields);
+    return out;
+}
 
-            {
-                std::lock_guard<std::mutex> lg(g_logMutex);
-                g_logMessages.push_back(entry);
-            }
-            {
-                std::lock_guard<std::mutex> lg(g_statusMessageMutex);
-                g_latestStatusMessage = entry.text;
-            }
+// File lines carry the full date and category so archived logs can be grepped per source
+static void appendFileLine(std::string &out, const LogEntry &entry) {
+    auto in_time_t = std::chrono::system_clock::to_time_t(entry.time);
+    std::tm buf {};
+
+#ifdef _WIN32
+    localtime_s(&buf, &in_time_t);
+#else
+    localtime_r(&in_time_t, &buf);
+#endif
+
+    const auto millis =
+        std::chrono::duration_cast<std::chrono::milliseconds>(entry.time.time_since_epoch()).count() % 1000;
+
+    std::format_to(
+        std::back_inserter(out),
+        "{:04}-{:02}-{:02} {:02}:{:02}:{:02}.{:03} {} [{}] {}",
+        buf.tm_year + 1900,
+        buf.tm_mon + 1,
+        buf.tm_mday,
+        buf.tm_hour,
+        buf.tm_min,
+        buf.tm_sec,
+        millis,
+        LevelPrefix(entry.level),
+        Console::CategoryName(entry.category),
+        entry.message
+    );
+    appendFields(out, entry.fields);
+    out += '\n';
+}
+
+static void trimToRetention() {
+    const size_t retention = g_logRetention.load(std::memory_order_relaxed);
+    if (g_logMessages.size() > retention) {
+        const size_t excess = g_logMessages.size() - retention;
+        g_logMessages.erase(g_logMessages.begin(), g_logMessages.begin() + static_cast<std::ptrdiff_t>(excess));
+        g_droppedRetention.fetch_add(excess, std::memory_order_relaxed);
+    }
+}
 
-            lock.lock();
+static void publishBatch(std::vector<LogEntry> &batch, Console::LogFileSink &sink) {
+    std::string chunk;
+    for (auto &e: batch) {
+        appendFileLine(chunk, e);
+    }
+    sink.append(std::move(chunk));
+
+    {
+        std::lock_guard<std::mutex> lg(g_statusMessageMutex);
+        g_latestStatusEntry = batch.back();
+    }
+    {
+        std::lock_guard<std::mutex> lg(g_logMutex);
+        for (auto &e: batch) {
+            g_logMessages.push_back(std::move(e));
         }
+        trimToRetention();
     }
+    batch.clear();
 }
 
-static struct LoggerInit {
-        LoggerInit() {
-            g_loggerThread = std::thread(LoggerThreadFunc);
+static void LoggerThreadFunc() {
+    auto &queue = pendingLogs();
+    std::vector<LogEntry> batch;
+    batch.reserve(256);
+
+    Console::LogFileSink sink(AltMan::Paths::Logs(), "altman", {});
+
+    auto lastSummary = std::chrono::steady_clock::now();
+    auto summarizeSuppressed = [&] {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - lastSummary < SUPPRESSED_SUMMARY_INTERVAL) {
+            return;
         }
-        ~LoggerInit() {
-            g_loggerRunning = false;
-            g_logCv.notify_all();
-            if (g_loggerThread.joinable()) {
-                g_loggerThread.join();
-            }
+        const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(now - lastSummary).count();
+        lastSummary = now;
+
+        for (const auto &[category, count]: Console::TakeSuppressedCounts()) {
+            batch.push_back({
+                Console::Level::Info,
+                category,
+                std::chrono::system_clock::now(),
+                "log.suppressed",
+                {{"count", count}, {"window_s", seconds}},
+            });
         }
-} s_loggerInit;
+    };
+
+    auto drain = [&] {
+        LogEntry entry;
+        while (queue.tryPop(entry)) {
+            batch.push_back(std::move(entry));
+        }
+    };
+
+    while (g_loggerRunning) {
+        drain();
+        summarizeSuppressed();
+
+        if (batch.empty()) {
+            // Producers notify without holding the mutex, so a wakeup can slip past; the timeout covers it
+            std::unique_lock<std::mutex> lock(g_wakeMutex);
+            g_logCv.wait_for(lock, LOGGER_IDLE_WAIT);
+            continue;
+        }
+
+        publishBatch(batch, sink);
+    }
+
+    drain();
+    if (!batch.empty()) {
+        publishBatch(batch, sink);
+    }
+}
+
+// For exits that never reach StopLogger(); entries logged until then are still written
+static struct LoggerShutdown {
+        ~LoggerShutdown() { Console::StopLogger(); }
+} s_loggerShutdown;
 
 namespace Console {
 
+    void StartLogger() {
+        if (g_loggerThread.joinable()) {
+            return;
+        }
+        g_loggerRunning = true;
+        g_loggerThread = std::thread(LoggerThreadFunc);
+    }
+
+    void StopLogger() {
+        g_loggerRunning = false;
+        g_logCv.notify_all();
+        if (g_loggerThread.joinable()) {
+            g_loggerThread.join();
+        }
+    }
+
+    const char *CategoryName(Category category) {
+        switch (category) {
+            case Category::General:
+                return "General";
+            case Category::Network:
+                return "Network";
+            case Category::Auth:
+                return "Auth";
+            case Category::Accounts:
+                return "Accounts";
+            case Category::Presence:
+                return "Presence";
+            case Category::Friends:
+                return "Friends";
+            case Category::Games:
+                return "Games";
+            case Category::History:
+                return "History";
+            case Category::Launcher:
+                return "Launcher";
+            case Category::Count:
+                break;
+        }
+        return "Unknown";
+    }
+
     void Log(Level level, const std::string &message) {
-        auto finalEntry = std::format("[{}] {} {}", getCurrentTimestamp(), LevelPrefix(level), message);
+        Log(Category::General, level, message);
+    }
+
+    void Log(Category category, Level level, const std::string &message) {
+        auto &volume = g_categoryVolume[static_cast<size_t>(category)];
+        volume.messages.fetch_add(1, std::memory_order_relaxed);
+        volume.bytes.fetch_add(message.size(), std::memory_order_relaxed);
 
-        {
-            std::lock_guard<std::mutex> lock(g_queueMutex);
-            g_pendingLogs.push_back({level, finalEntry});
+        if (!pendingLogs().tryPush({level, category, std::chrono::system_clock::now(), message, {}})) {
+            g_droppedQueueFull.fetch_add(1, std::memory_order_relaxed);
         }
         g_logCv.notify_one();
     }
 
+    void Event(Category category, Level level, const char *event, std::initializer_list<Field> fields) {
+        auto &volume = g_categoryVolume[static_cast<size_t>(category)];
+        volume.messages.fetch_add(1, std::memory_order_relaxed);
+        volume.bytes.fetch_add(std::char_traits<char>::length(event), std::memory_order_relaxed);
+
+        if (!pendingLogs().tryPush({level, category, std::chrono::system_clock::now(), event, fields})) {
+            g_droppedQueueFull.fetch_add(1, std::memory_order_relaxed);
+        }
+        g_logCv.notify_one();
+    }
+
+    std::vector<CategoryVolume> GetCategoryVolumes() {
+        std::vector<CategoryVolume> out;
+        out.reserve(g_categoryVolume.size());
+        for (size_t i = 0; i < g_categoryVolume.size(); ++i) {
+            out.push_back({
+                static_cast<Category>(i),
+                g_categoryVolume[i].messages.load(std::memory_order_relaxed),
+                g_categoryVolume[i].bytes.load(std::memory_order_relaxed),
+            });
+        }
+        return out;
+    }
+
+    void SetRetention(size_t lines) {
+        g_logRetention.store(std::max<size_t>(lines, 1), std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(g_logMutex);
+        trimToRetention();
+    }
+
+    size_t GetRetention() {
+        return g_logRetention.load(std::memory_order_relaxed);
+    }
+
     std::string GetLatestLogMessageForStatus() {
         std::lock_guard<std::mutex> lock(g_statusMessageMutex);
-        return g_latestStatusMessage;
+        if (g_latestStatusEntry.time == std::chrono::system_clock::time_point {}) {
+            return g_latestStatusEntry.message;
+        }
+        return formatEntry(g_latestStatusEntry);
     }
 
     std::vector<std::string> GetLogs() {
         std::lock_guard<std::mutex> lock(g_logMutex);
         std::vector<std::string> out;
+        out.reserve(g_logMessages.size());
         for (const auto &e: g_logMessages) {
-            out.push_back(e.text);
+            out.push_back(formatEntry(e));
         }
         return out;
     }
@@ -158,13 +401,294 @@ namespace Console {
             allLogs.reserve(8192);
 
             for (const auto& entry : g_logMessages) {
-                allLogs += entry.text;
+                allLogs += formatEntry(entry);
                 allLogs += '\n';
             }
 
             ImGui::SetClipboardText(allLogs.c_str());
         }
 
+        ImGui::SameLine();
+
+        if (ImGui::Button("Categories")) {
+            ImGui::OpenPopup("LogCategoriesPopup");
+        }
+
+        if (ImGui::BeginPopup("LogCategoriesPopup")) {
+            static constexpr const char *LEVEL_NAMES[] = {"Debug", "Info", "Warn", "Error"};
+
+            if (ImGui::BeginTable("LogCategoriesTable", 5, ImGuiTableFlags_BordersInnerH | ImGuiTableFlags_RowBg)) {
+                ImGui::TableSetupColumn("Category");
+                ImGui::TableSetupColumn("Level", ImGuiTableColumnFlags_WidthFixed, ImGui::GetFontSize() * 6.0f);
+                ImGui::TableSetupColumn("Messages");
+                ImGui::TableSetupColumn("Bytes");
+                ImGui::TableSetupColumn("Suppressed");
+                ImGui::TableHeadersRow();
+
+                for (const auto &volume: GetCategoryVolumes()) {
+                    ImGui::PushID(static_cast<int>(volume.category));
+                    ImGui::TableNextRow();
+                    ImGui::TableSetColumnIndex(0);
+                    ImGui::TextUnformatted(CategoryName(volume.category));
+                    ImGui::TableSetColumnIndex(1);
+                    int level = static_cast<int>(GetCategoryLevel(volume.category));
+                    ImGui::SetNextItemWidth(-FLT_MIN);
+                    if (ImGui::Combo("##level", &level, LEVEL_NAMES, IM_ARRAYSIZE(LEVEL_NAMES))) {
+                        SetCategoryLevel(volume.category, static_cast<Level>(level));
+                        Data::SaveSettings();
+                    }
+                    ImGui::TableSetColumnIndex(2);
+                    ImGui::TextUnformatted(std::format("{}", volume.messages).c_str());
+                    ImGui::TableSetColumnIndex(3);
+                    ImGui::TextUnformatted(std::format("{}", volume.bytes).c_str());
+                    ImGui::TableSetColumnIndex(4);
+                    ImGui::TextUnformatted(std::format("{}", GetSuppressedTotal(volume.category)).c_str());
+                    ImGui::PopID();
+                }
+                ImGui::EndTable();
+            }
+            ImGui::EndPopup();
+        }
+
+        ImGui::SameLine();
+
+        if (ImGui::Button("Transfers")) {
+            ImGui::OpenPopup("NetworkTransfersPopup");
+        }
+
+        if (ImGui::BeginPopup("NetworkTransfersPopup")) {
+            const auto stats = HttpClient::endpointMetrics();
+            uint64_t totalWire = 0;
+            uint64_t totalDecoded = 0;
+            for (const auto &stat: stats) {
+                totalWire += stat.wireBytes;
+                totalDecoded += stat.decodedBytes;
+            }
+
+            ImGui::TextUnformatted(
+                std::format("{} received, {} decoded", formatBytes(totalWire), formatBytes(totalDecoded)).c_str()
+            );
+            ImGui::SameLine();
+            if (ImGui::SmallButton("Reset")) {
+                HttpClient::resetTransferStats();
+                HttpClient::RateLimiter::instance().resetQueueStats();
+            }
+            ImGui::SameLine();
+            if (ImGui::SmallButton("Copy JSON")) {
+                ImGui::SetClipboardText(HttpClient::endpointMetricsJson().c_str());
+            }
+            ImGui::SameLine();
+            if (ImGui::SmallButton("Copy Prometheus")) {
+                ImGui::SetClipboardText(HttpClient::endpointMetricsPrometheus().c_str());
+            }
+
+            if (const auto ttfb = HttpClient::ttfbSummary(); ttfb.samples > 0) {
+                ImGui::TextUnformatted(
+                    std::format(
+                        "Time to first byte: median {:.0f} ms, p99 {:.0f} ms ({} requests, {} on a reused "
+                        "connection, new connections set up in {:.0f} ms median)",
+                        ttfb.medianMs,
+                        ttfb.p99Ms,
+                        ttfb.samples,
+                        ttfb.reused,
+                        ttfb.setupMedianMs
+                    )
+                        .c_str()
+                );
+            }
+
+            const auto queues = HttpClient::RateLimiter::instance().queueStats();
+            std::string queueLine = "Rate limiter wait:";
+            for (size_t i = 0; i < queues.size(); ++i) {
+                if (queues[i].acquired == 0) {
+                    continue;
+                }
+                queueLine += std::format(
+                    " {} {:.0f} ms avg / {:.0f} max ({}),",
+                    HttpClient::requestPriorityName(static_cast<HttpClient::RequestPriority>(i)),
+                    queues[i].meanWaitMs,
+                    queues[i].maxWaitMs,
+                    queues[i].acquired
+                );
+            }
+            if (queueLine.back() == ',') {
+                queueLine.pop_back();
+                ImGui::TextUnformatted(queueLine.c_str());
+            }
+
+            if (const auto usage = HttpClient::RateLimiter::instance().accountUsage(); !usage.empty()
+                && ImGui::TreeNode("Rate limiter by account")) {
+                constexpr ImGuiTableFlags flags = ImGuiTableFlags_BordersInnerH | ImGuiTableFlags_RowBg;
+                if (ImGui::BeginTable("NetworkAccountsTable", 4, flags)) {
+                    ImGui::TableSetupColumn("Account");
+                    ImGui::TableSetupColumn("Slots used");
+                    ImGui::TableSetupColumn("In window");
+                    ImGui::TableSetupColumn("In flight");
+                    ImGui::TableHeadersRow();
+
+                    std::shared_lock lock(g_accountsMutex);
+                    for (const auto &entry: usage) {
+                        std::string name = "(no account)";
+                        if (entry.accountId != 0) {
+                            const auto it = std::ranges::find(g_accounts, entry.accountId, &AccountData::id);
+                            name = it != g_accounts.end() ? it->username : std::format("#{}", entry.accountId);
+                        }
+                        ImGui::TableNextRow();
+                        ImGui::TableSetColumnIndex(0);
+                        ImGui::TextUnformatted(name.c_str());
+                        ImGui::TableSetColumnIndex(1);
+                        ImGui::TextUnformatted(std::format("{}", entry.acquired).c_str());
+                        ImGui::TableSetColumnIndex(2);
+                        ImGui::TextUnformatted(std::format("{}", entry.inWindow).c_str());
+                        ImGui::TableSetColumnIndex(3);
+                        ImGui::TextUnformatted(std::format("{}", entry.inFlight).c_str());
+                    }
+                    ImGui::EndTable();
+                }
+                ImGui::TreePop();
+            }
+
+            if (const auto proxies = HttpClient::proxyStatus(); !proxies.empty() && ImGui::TreeNode("Proxies")) {
+                for (const auto &proxy: proxies) {
+                    const std::string line = std::format(
+                        "{}: {} accounts, {} requests, {} connection failures",
+                        proxy.proxy,
+                        proxy.accounts,
+                        proxy.requests,
+                        proxy.failures
+                    );
+                    if (proxy.healthy) {
+                        ImGui::TextUnformatted(line.c_str());
+                    } else {
+                        ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s (down, probing)", line.c_str());
+                    }
+                }
+                ImGui::TreePop();
+            }
+
+            if (!stats.empty() && ImGui::TreeNode("Latency and status by endpoint")) {
+                constexpr ImGuiTableFlags flags = ImGuiTableFlags_BordersInnerH | ImGuiTableFlags_RowBg;
+                if (ImGui::BeginTable("NetworkLatencyTable", 10, flags)) {
+                    ImGui::TableSetupColumn("Endpoint");
+                    ImGui::TableSetupColumn("p50");
+                    ImGui::TableSetupColumn("p90");
+                    ImGui::TableSetupColumn("p99");
+                    ImGui::TableSetupColumn("2xx/3xx");
+                    ImGui::TableSetupColumn("4xx");
+                    ImGui::TableSetupColumn("429");
+                    ImGui::TableSetupColumn("5xx");
+                    ImGui::TableSetupColumn("Failed");
+                    ImGui::TableSetupColumn("Waited (limiter / backoff)");
+                    ImGui::TableHeadersRow();
+
+                    for (const auto &stat: stats) {
+                        if (stat.requests == 0) {
+                            continue;
+                        }
+                        ImGui::TableNextRow();
+                        ImGui::TableSetColumnIndex(0);
+                        ImGui::TextUnformatted(stat.endpoint.c_str());
+                        ImGui::TableSetColumnIndex(1);
+                        ImGui::TextUnformatted(std::format("{:.0f} ms", stat.percentileMs(0.5)).c_str());
+                        ImGui::TableSetColumnIndex(2);
+                        ImGui::TextUnformatted(std::format("{:.0f} ms", stat.percentileMs(0.9)).c_str());
+                        ImGui::TableSetColumnIndex(3);
+                        ImGui::TextUnformatted(std::format("{:.0f} ms", stat.percentileMs(0.99)).c_str());
+                        ImGui::TableSetColumnIndex(4);
+                        ImGui::TextUnformatted(std::format("{}", stat.statusCount(200, 399)).c_str());
+                        ImGui::TableSetColumnIndex(5);
+                        ImGui::TextUnformatted(std::format("{}", stat.statusCount(400, 499)).c_str());
+                        ImGui::TableSetColumnIndex(6);
+                        const uint64_t limited = stat.statusCount(429, 429);
+                        ImGui::TextUnformatted(
+                            std::format(
+                                "{} ({:.1f}%)",
+                                limited,
+                                100.0 * static_cast<double>(limited) / static_cast<double>(stat.requests)
+                            )
+                                .c_str()
+                        );
+                        ImGui::TableSetColumnIndex(7);
+                        ImGui::TextUnformatted(std::format("{}", stat.statusCount(500, 599)).c_str());
+                        ImGui::TableSetColumnIndex(8);
+                        ImGui::TextUnformatted(std::format("{}", stat.statusCount(0, 0)).c_str());
+                        ImGui::TableSetColumnIndex(9);
+                        ImGui::TextUnformatted(
+                            std::format("{:.1f} s / {:.1f} s", stat.limiterWaitMs / 1000.0, stat.backoffMs / 1000.0)
+                                .c_str()
+                        );
+                    }
+                    ImGui::EndTable();
+                }
+                ImGui::TreePop();
+            }
+
+            if (ImGui::BeginTable("NetworkTransfersTable", 7, ImGuiTableFlags_BordersInnerH | ImGuiTableFlags_RowBg)) {
+                ImGui::TableSetupColumn("Endpoint");
+                ImGui::TableSetupColumn("Requests");
+                ImGui::TableSetupColumn("Wire");
+                ImGui::TableSetupColumn("Decoded");
+                ImGui::TableSetupColumn("Saved");
+                ImGui::TableSetupColumn("Retries");
+                ImGui::TableSetupColumn("Hedges (won)");
+                ImGui::TableHeadersRow();
+
+                for (const auto &stat: stats) {
+                    ImGui::TableNextRow();
+                    ImGui::TableSetColumnIndex(0);
+                    ImGui::TextUnformatted(stat.endpoint.c_str());
+                    ImGui::TableSetColumnIndex(1);
+                    ImGui::TextUnformatted(std::format("{}", stat.requests).c_str());
+                    ImGui::TableSetColumnIndex(2);
+                    ImGui::TextUnformatted(formatBytes(stat.wireBytes).c_str());
+                    ImGui::TableSetColumnIndex(3);
+                    ImGui::TextUnformatted(formatBytes(stat.decodedBytes).c_str());
+                    ImGui::TableSetColumnIndex(4);
+                    if (stat.decodedBytes > 0 && stat.wireBytes < stat.decodedBytes) {
+                        const double saved = 100.0 * static_cast<double>(stat.decodedBytes - stat.wireBytes)
+                                             / static_cast<double>(stat.decodedBytes);
+                        ImGui::TextUnformatted(std::format("{:.0f}%", saved).c_str());
+                    } else {
+                        ImGui::TextDisabled("-");
+                    }
+                    ImGui::TableSetColumnIndex(5);
+                    ImGui::TextUnformatted(std::format("{}", stat.retries).c_str());
+                    ImGui::TableSetColumnIndex(6);
+                    ImGui::TextUnformatted(std::format("{} ({})", stat.hedges, stat.hedgeWins).c_str());
+                }
+                ImGui::EndTable();
+            }
+            ImGui::EndPopup();
+        }
+
+        ImGui::SameLine();
+        bool tracing = IsTracing();
+        if (ImGui::Checkbox("Trace", &tracing)) {
+            SetTracing(tracing);
+        }
+        if (const size_t spans = TraceEventCount(); spans > 0) {
+            ImGui::SameLine();
+            if (ImGui::Button(std::format("Save trace ({} spans)", spans).c_str())) {
+                if (const auto path = WriteTrace(AltMan::Paths::Logs()); !path.empty()) {
+                    LOG_INFO("Trace written to {} (open in chrome://tracing or ui.perfetto.dev)", path.string());
+                    ClearTrace();
+                } else {
+                    LOG_ERROR("Failed to write trace file");
+                }
+            }
+        }
+
+        const uint64_t droppedFull = g_droppedQueueFull.load(std::memory_order_relaxed);
+        const uint64_t droppedOld = g_droppedRetention.load(std::memory_order_relaxed);
+        if (droppedFull > 0 || droppedOld > 0) {
+            ImGui::SameLine();
+            ImGui::TextDisabled(
+                "%s",
+                std::format("Dropped {} (queue full), {} (over {} line limit)", droppedFull, droppedOld, GetRetention())
+                    .c_str()
+            );
+        }
+
         ImGui::Separator();
 
         ImGui::BeginChild("LogScrollingRegion", ImVec2(0, 0), ImGuiChildFlags_Borders, ImGuiWindowFlags_None);
@@ -172,29 +696,59 @@ namespace Console {
         std::string searchLower = toLower(g_searchBuffer);
 
         std::lock_guard<std::mutex> lock(g_logMutex);
-        for (const auto &entry: g_logMessages) {
-            if (!searchLower.empty() && toLower(entry.text).find(searchLower) == std::string::npos) {
-                continue;
-            }
-
-            ImVec4 color;
-            switch (entry.level) {
-                case Level::Info:
-                    color = {0.85f, 0.85f, 0.85f, 1.0f};
-                    break;
-                case Level::Warn:
-                    color = {1.0f, 0.85f, 0.3f, 1.0f};
-                    break;
-                case Level::Error:
-                    color = {1.0f, 0.4f, 0.4f, 1.0f};
-                    break;
-            }
-
-            ImGui::PushStyleColor(ImGuiCol_Text, color);
-            ImGui::Indent(desiredTextIndent);
-            ImGui::TextUnformatted(entry.text.c_str());
-            ImGui::Unindent(desiredTextIndent);
-            ImGui::PopStyleColor();
+
+        // The searchable text is built the first time a search looks at an entry and dropped with
+        // the search, so only a console that is being searched pays for a second copy of every line
+        std::vector<int> matches;
+        if (!searchLower.empty()) {
+            for (size_t i = 0; i < g_logMessages.size(); ++i) {
+                auto &entry = g_logMessages[i];
+                if (entry.searchText.empty()) {
+                    entry.searchText = toLower(formatEntry(entry));
+                }
+                if (entry.searchText.find(searchLower) != std::string::npos) {
+                    matches.push_back(static_cast<int>(i));
+                }
+            }
+            g_searchCached = true;
+        } else if (g_searchCached) {
+            for (auto &entry: g_logMessages) {
+                std::string().swap(entry.searchText);
+            }
+            g_searchCached = false;
+        }
+
+        const int count = searchLower.empty() ? static_cast<int>(g_logMessages.size()) : static_cast<int>(matches.size());
+
+        // Only visible rows are formatted; the timestamp and prefix never exist as stored strings
+        ImGuiListClipper clipper;
+        clipper.Begin(count);
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                const auto &entry = g_logMessages[searchLower.empty() ? row : matches[row]];
+
+                ImVec4 color;
+                switch (entry.level) {
+                    case Level::Debug:
+                        color = {0.6f, 0.6f, 0.6f, 1.0f};
+                        break;
+                    case Level::Info:
+                        color = {0.85f, 0.85f, 0.85f, 1.0f};
+                        break;
+                    case Level::Warn:
+                        color = {1.0f, 0.85f, 0.3f, 1.0f};
+                        break;
+                    case Level::Error:
+                        color = {1.0f, 0.4f, 0.4f, 1.0f};
+                        break;
+                }
+
+                ImGui::PushStyleColor(ImGuiCol_Text, color);
+                ImGui::Indent(desiredTextIndent);
+                ImGui::TextUnformatted(formatEntry(entry).c_str());
+                ImGui::Unindent(desiredTextIndent);
+                ImGui::PopStyleColor();
+            }
         }
 
         if (ImGui::GetScrollY() >= ImGui::GetScrollMaxY()) {
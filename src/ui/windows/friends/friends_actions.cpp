@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "console/console.h"
+#include "network/http.h"
 #include "network/roblox/common.h"
 #include "network/roblox/auth.h"
 #include "network/roblox/common.h"
@@ -122,6 +123,8 @@ namespace FriendsActions {
 
         loadingFlag = true;
         LOG_INFO("Fetching friends list...");
+        // The list, presence and detail loads are all the account's own traffic in the limiter
+        HttpClient::AccountScope accountScope(accountId);
 
         auto list = Roblox::getFriends(userId, cookie);
         list.reserve(list.size());
@@ -198,6 +201,7 @@ namespace FriendsActions {
     }
 
     void FetchFriendDetails(
+        int accountId,
         const std::string &friendId,
         const std::string &cookie,
         Roblox::FriendDetail &outFriendDetail,
@@ -206,6 +210,7 @@ namespace FriendsActions {
 
         loadingFlag = true;
         LOG_INFO("Fetching friend details...");
+        HttpClient::AccountScope accountScope(accountId);
         outFriendDetail = Roblox::getUserDetails(friendId, cookie);
         loadingFlag = false;
         LOG_INFO("Friend details loaded.");
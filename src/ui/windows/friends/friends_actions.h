@@ -21,6 +21,7 @@ namespace FriendsActions {
     );
 
     void FetchFriendDetails(
+        int accountId,
         const std::string &friendId,
         const std::string &cookie,
         Roblox::FriendDetail &outFriendDetail,
@@ -19,6 +19,7 @@
 #include "network/roblox/session.h"
 #include "network/roblox/social.h"
 #include "system/roblox_launcher.h"
+#include "ui/ui.h"
 #include "ui/webview/webview.h"
 #include "ui/widgets/bottom_right_status.h"
 #include "ui/widgets/context_menus.h"
@@ -138,7 +139,7 @@ namespace {
         return !outSpecs.empty();
     }
 
-    void loadIncomingRequests(std::string_view cookie, bool reset) {
+    void loadIncomingRequests(int accountId, std::string_view cookie, bool reset) {
         if (g_requests.loading.load()) {
             return;
         }
@@ -156,7 +157,8 @@ namespace {
             cursor = reset ? "" : g_requests.nextCursor;
         }
 
-        WorkerThreads::runBackground([cookieCopy = std::string(cookie), cursor]() {
+        WorkerThreads::runBackground([accountId, cookieCopy = std::string(cookie), cursor]() {
+            HttpClient::AccountScope accountScope(accountId);
             auto page = Roblox::getIncomingFriendRequests(cookieCopy, cursor, 100);
             {
                 std::lock_guard lock(g_requests.mutex);
@@ -225,7 +227,7 @@ namespace {
                 g_requests.selectedIdx = -1;
 
                 if (g_state.viewMode == VIEW_MODE_REQUESTS) {
-                    loadIncomingRequests(account.cookie, true);
+                    loadIncomingRequests(account.id, account.cookie, true);
                 }
             }
         }
@@ -289,7 +291,9 @@ namespace {
 
         if (doSend) {
             g_addFriend.loading = true;
-            WorkerThreads::runBackground([specs, cookie = account.cookie]() {
+            WorkerThreads::runBackground([specs, cookie = account.cookie, accountId = account.id]() {
+                HttpClient::PriorityScope priority(HttpClient::RequestPriority::Bulk);
+                HttpClient::AccountScope accountScope(accountId);
                 for (const auto &spec : specs) {
                     if (!g_addFriend.loading.load())
                         break;
@@ -308,9 +312,13 @@ namespace {
                         LOG_INFO("Friend request sent");
                     } else {
                         LOG_ERROR("Friend request Error: {}", Roblox::apiErrorToString(result.error));
+                        // Friend requests are limited per account, so only this sender waits; pausing
+                        // the shared limiter would stall every other account's traffic too
                         if (result.error == Roblox::ApiError::RateLimited) {
                             LOG_WARN("Rate limited, backing off 30s...");
-                            HttpClient::RateLimiter::instance().backoff(std::chrono::seconds(30));
+                            if (ShutdownManager::instance().sleepFor(std::chrono::seconds(30))) {
+                                break;
+                            }
                         }
                     }
                 }
@@ -378,6 +386,7 @@ namespace {
                 std::format("Unfriend {}?", frend.username),
                 [frend, cookie = account.cookie, accountId = account.id]() {
                     WorkerThreads::runBackground([frend, cookie, accountId]() {
+                        HttpClient::AccountScope accountScope(accountId);
                         auto result = Roblox::unfriend(std::to_string(frend.id), cookie);
                         if (result.success) {
                             std::erase_if(g_friends, [&](const auto &f) {
@@ -458,6 +467,7 @@ namespace {
                     if (const auto *acc = getAccountById(g_state.viewAccountId)) {
                         WorkerThreads::runBackground(
                             FriendsActions::FetchFriendDetails,
+                            acc->id,
                             std::to_string(frend.id),
                             acc->cookie,
                             std::ref(g_state.selectedFriend),
@@ -508,7 +518,8 @@ namespace {
                         if (const auto *acc = getAccountById(g_state.viewAccountId)) {
                             const uint64_t uid = unfriend.id;
                             const std::string cookie = acc->cookie;
-                            WorkerThreads::runBackground([uid, cookie]() {
+                            WorkerThreads::runBackground([uid, cookie, accountId = acc->id]() {
+                                HttpClient::AccountScope accountScope(accountId);
                                 auto result = Roblox::sendFriendRequest(std::to_string(uid), cookie);
                                 if (!result.success) {
                                     LOG_ERROR("Friend request Error: {}", Roblox::apiErrorToString(result.error));
@@ -555,6 +566,7 @@ namespace {
                     g_requests.selectedDetail = {};
                     WorkerThreads::runBackground(
                         FriendsActions::FetchFriendDetails,
+                        account.id,
                         std::to_string(req.userId),
                         account.cookie,
                         std::ref(g_requests.selectedDetail),
@@ -570,7 +582,7 @@ namespace {
             std::lock_guard lock(g_requests.mutex);
             if (!g_requests.nextCursor.empty() && !loading) {
                 if (ImGui::Button("Load more...")) {
-                    loadIncomingRequests(account.cookie, false);
+                    loadIncomingRequests(account.id, account.cookie, false);
                 }
             }
         }
@@ -729,12 +741,14 @@ namespace {
 
         const uint64_t uid = req.userId;
         const std::string cookie = account.cookie;
+        const int accountId = account.id;
 
         ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.2f, 0.55f, 0.2f, 1.0f));
         ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.25f, 0.65f, 0.25f, 1.0f));
         ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.15f, 0.45f, 0.15f, 1.0f));
         if (ImGui::Button("Accept")) {
-            WorkerThreads::runBackground([uid, cookie]() {
+            WorkerThreads::runBackground([uid, cookie, accountId]() {
+                HttpClient::AccountScope accountScope(accountId);
                 Roblox::acceptFriendRequest(std::to_string(uid), cookie);
                 std::lock_guard lock(g_requests.mutex);
                 std::erase_if(g_requests.requests, [uid](const auto &r) { return r.userId == uid; });
@@ -750,7 +764,8 @@ namespace {
         ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.65f, 0.25f, 0.25f, 1.0f));
         ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.45f, 0.15f, 0.15f, 1.0f));
         if (ImGui::Button("Decline")) {
-            WorkerThreads::runBackground([uid, cookie]() {
+            WorkerThreads::runBackground([uid, cookie, accountId]() {
+                HttpClient::AccountScope accountScope(accountId);
                 Roblox::declineFriendRequest(std::to_string(uid), cookie);
                 std::lock_guard lock(g_requests.mutex);
                 std::erase_if(g_requests.requests, [uid](const auto &r) { return r.userId == uid; });
@@ -952,6 +967,7 @@ namespace {
 
             WorkerThreads::runBackground([frend, accounts = std::move(accounts)]() {
                 const uint64_t uid = frend.id;
+                HttpClient::AccountScope accountScope(accounts.front().id);
                 const auto pres = Roblox::getPresences({uid}, accounts.front().cookie);
                 const auto it = pres.find(uid);
                 if (it == pres.end() || it->second.presence != "InGame" || it->second.placeId == 0
@@ -1087,7 +1103,7 @@ void RenderFriendsTab() {
             );
 
             if (g_state.viewMode == VIEW_MODE_REQUESTS) {
-                loadIncomingRequests(account->cookie, true);
+                loadIncomingRequests(account->id, account->cookie, true);
             }
         }
     }
@@ -1114,7 +1130,7 @@ void RenderFriendsTab() {
                 std::ref(g_state.friendsLoading)
             );
         } else {
-            loadIncomingRequests(account->cookie, true);
+            loadIncomingRequests(account->id, account->cookie, true);
         }
     }
 
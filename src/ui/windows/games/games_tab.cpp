@@ -1,8 +1,8 @@
 #include <algorithm>
 #include <format>
+#include <span>
 #include <string>
 #include <thread>
-#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -13,9 +13,11 @@
 #include "games_utils.h"
 #include "network/roblox/auth.h"
 #include "network/roblox/common.h"
+#include "network/roblox/game_search.h"
 #include "network/roblox/games.h"
 #include "network/roblox/session.h"
 #include "network/roblox/social.h"
+#include "network/roblox/universe_metadata.h"
 #include "system/roblox_launcher.h"
 #include "ui/ui.h"
 #include "ui/webview/webview.h"
@@ -53,7 +55,11 @@ namespace {
     std::vector<GameInfo> originalGamesList;
     std::vector<GameInfo> favoriteGamesList;
 
-    std::unordered_map<uint64_t, Roblox::GameDetail> gameDetailCache;
+    Roblox::GameSearch gameSearch;
+    uint64_t gameSearchVersion = 0;
+    bool searchLoading = false;
+    std::string searchError;
+
     std::unordered_set<uint64_t> favoriteGameIds;
 
     enum class GameSortMode {
@@ -103,26 +109,58 @@ namespace {
 
     void ClearSearchState() {
         searchBuffer[0] = '\0';
+        gameSearch.clear();
         selectedIndex = INVALID_INDEX;
         originalGamesList.clear();
         gamesList.clear();
-        gameDetailCache.clear();
     }
 
     void PerformSearch() {
         if (searchBuffer[0] == '\0') {
             return;
         }
+        gameSearch.submit(searchBuffer);
+    }
 
-        selectedIndex = INVALID_INDEX;
-        originalGamesList = Roblox::searchGames(searchBuffer);
+    // Pulls new results from the background search; pages land one at a time, so this runs often
+    void ApplySearchResults() {
+        gameSearch.update();
+
+        const uint64_t version = gameSearch.version();
+        if (version == gameSearchVersion) {
+            return;
+        }
+        gameSearchVersion = version;
 
+        auto snapshot = gameSearch.snapshot();
+        searchLoading = snapshot.loading;
+        searchError = std::move(snapshot.error);
+
+        uint64_t selectedUniverseId = 0;
+        if (selectedIndex >= 0 && selectedIndex < static_cast<int>(gamesList.size())) {
+            selectedUniverseId = gamesList[selectedIndex].universeId;
+        }
+
+        originalGamesList = std::move(snapshot.games);
         EraseIf(originalGamesList, [](const GameInfo &game) {
             return favoriteGameIds.contains(game.universeId);
         });
-
         SortGamesList();
-        gameDetailCache.clear();
+
+        // Keep the selected game selected as more pages arrive
+        if (selectedIndex >= 0) {
+            const auto it = std::ranges::find(gamesList, selectedUniverseId, &GameInfo::universeId);
+            selectedIndex = it == gamesList.end() ? INVALID_INDEX : static_cast<int>(it - gamesList.begin());
+        }
+
+        if (!snapshot.provisional) {
+            std::vector<uint64_t> universeIds;
+            universeIds.reserve(originalGamesList.size());
+            for (const auto &game: originalGamesList) {
+                universeIds.push_back(game.universeId);
+            }
+            Roblox::UniverseMetadata::instance().prefetch(universeIds);
+        }
     }
 
     void LaunchGameWithAccounts(uint64_t placeId) {
@@ -235,7 +273,12 @@ namespace {
         inputWidth = std::max(inputWidth, minFieldWidth);
 
         ImGui::PushItemWidth(inputWidth);
-        ImGui::InputTextWithHint("##game_search", "Search games", searchBuffer, SEARCH_BUFFER_SIZE);
+        if (ImGui::InputTextWithHint("##game_search", "Search games", searchBuffer, SEARCH_BUFFER_SIZE)) {
+            gameSearch.setQuery(searchBuffer);
+        }
+        if (ImGui::IsItemFocused() && ImGui::IsKeyPressed(ImGuiKey_Enter)) {
+            PerformSearch();
+        }
         ImGui::PopItemWidth();
 
         ImGui::SameLine(0, style.ItemSpacing.x);
@@ -298,6 +341,12 @@ namespace {
     }
 
     void RenderSearchResultsList(float listWidth, float availableHeight) {
+        if (searchLoading && gamesList.empty()) {
+            ImGui::TextDisabled("Searching...");
+        } else if (!searchError.empty() && gamesList.empty()) {
+            ImGui::TextColored(ERROR_COLOR, "Search failed: %s", searchError.c_str());
+        }
+
         for (int index = 0; index < static_cast<int>(gamesList.size()); ++index) {
             const auto &game = gamesList[index];
 
@@ -589,12 +638,13 @@ namespace {
         if (currentGameInfo) {
             const GameInfo &gameInfo = *currentGameInfo;
 
+            // Details fill in once the queued batch lands instead of blocking the frame
+            auto &metadata = Roblox::UniverseMetadata::instance();
             Roblox::GameDetail detailInfo;
-            if (auto it = gameDetailCache.find(currentUniverseId); it != gameDetailCache.end()) {
-                detailInfo = it->second;
+            if (auto cached = metadata.cached(currentUniverseId)) {
+                detailInfo = std::move(*cached);
             } else if (currentUniverseId != 0) {
-                detailInfo = Roblox::getGameDetail(currentUniverseId);
-                gameDetailCache[currentUniverseId] = detailInfo;
+                metadata.prefetch(std::span(&currentUniverseId, 1));
             }
 
             RenderGameInfoTable(gameInfo, detailInfo);
@@ -630,6 +680,13 @@ namespace {
             favoriteGamesList.push_back(favoriteGameInfo);
         }
 
+        std::vector<uint64_t> universeIds;
+        universeIds.reserve(favoriteGamesList.size());
+        for (const auto &game: favoriteGamesList) {
+            universeIds.push_back(game.universeId);
+        }
+        Roblox::UniverseMetadata::instance().prefetch(universeIds);
+
         hasLoadedFavorites = true;
     }
 
@@ -647,6 +704,7 @@ namespace {
 void RenderGamesTab() {
     LoadFavoritesOnce();
     RenderGameSearch();
+    ApplySearchResults();
 
     const float availableHeight = ImGui::GetContentRegionAvail().y;
     const float availableWidth = ImGui::GetContentRegionAvail().x;
@@ -0,0 +1,259 @@
+#include "history_analytics.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include "utils/time_utils.h"
+
+namespace HistoryAnalytics {
+
+    namespace {
+        constexpr int64_t SECONDS_PER_DAY = 86400;
+        // A client left open in a menu should not count as a day of play time
+        constexpr int64_t MAX_SESSION_SECONDS = 12 * 60 * 60;
+
+        int32_t dayOf(int64_t t) {
+            return static_cast<int32_t>(t >= 0 ? t / SECONDS_PER_DAY : (t - SECONDS_PER_DAY + 1) / SECONDS_PER_DAY);
+        }
+    } // namespace
+
+    Engine &engine() {
+        static Engine instance;
+        return instance;
+    }
+
+    uint32_t Engine::Dictionary::intern(const std::string &value) {
+        auto [it, inserted] = m_ids.try_emplace(value, static_cast<uint32_t>(m_values.size()));
+        if (inserted) {
+            m_values.push_back(value);
+        }
+        return it->second;
+    }
+
+    void Engine::Dictionary::clear() {
+        m_ids.clear();
+        m_values.clear();
+        intern({});
+    }
+
+    bool Engine::ingest(const LogInfo &log) {
+        if (log.isInstallerLog || log.sessions.empty()) {
+            return false;
+        }
+
+        std::lock_guard lock(m_mutex);
+
+        auto it = m_logs.find(log.fullPath);
+        if (it == m_logs.end()) {
+            const uint32_t logId = m_nextLogId++;
+            m_logs.emplace(log.fullPath, LogState {logId, log.lastTimestamp, log.sessions.size()});
+
+            const size_t firstRow = m_start.size();
+            appendRows(logId, log);
+            for (size_t row = firstRow; row < m_start.size(); ++row) {
+                accumulate(row);
+            }
+            return true;
+        }
+
+        LogState &state = it->second;
+        if (state.lastTimestamp == log.lastTimestamp && state.sessionCount == log.sessions.size()) {
+            return false;
+        }
+
+        // The log grew since we last saw it: swap its rows and rebuild from the columns
+        const uint32_t logId = state.id;
+        state.lastTimestamp = log.lastTimestamp;
+        state.sessionCount = log.sessions.size();
+
+        size_t kept = 0;
+        for (size_t row = 0; row < m_log.size(); ++row) {
+            if (m_log[row] == logId) {
+                continue;
+            }
+            m_log[kept] = m_log[row];
+            m_start[kept] = m_start[row];
+            m_duration[kept] = m_duration[row];
+            m_user[kept] = m_user[row];
+            m_place[kept] = m_place[row];
+            m_universe[kept] = m_universe[row];
+            m_server[kept] = m_server[row];
+            m_reconnect[kept] = m_reconnect[row];
+            ++kept;
+        }
+
+        m_log.resize(kept);
+        m_start.resize(kept);
+        m_duration.resize(kept);
+        m_user.resize(kept);
+        m_place.resize(kept);
+        m_universe.resize(kept);
+        m_server.resize(kept);
+        m_reconnect.resize(kept);
+
+        appendRows(logId, log);
+        rebuildAggregates();
+        return true;
+    }
+
+    void Engine::appendRows(uint32_t logId, const LogInfo &log) {
+        struct Timed {
+                int64_t start;
+                const GameSession *session;
+        };
+
+        std::vector<Timed> timed;
+        timed.reserve(log.sessions.size());
+        for (const auto &session: log.sessions) {
+            const time_t start = parseIsoTimestamp(session.timestamp);
+            if (start != 0 && !session.placeId.empty()) {
+                timed.push_back({static_cast<int64_t>(start), &session});
+            }
+        }
+
+        std::sort(timed.begin(), timed.end(), [](const Timed &a, const Timed &b) {
+            return a.start < b.start;
+        });
+
+        const int64_t logEnd = log.lastTimestamp.empty() ? 0 : static_cast<int64_t>(parseIsoTimestamp(log.lastTimestamp));
+        const uint32_t user = m_strings.intern(log.userId);
+
+        for (size_t i = 0; i < timed.size(); ++i) {
+            const GameSession &session = *timed[i].session;
+            const int64_t start = timed[i].start;
+            const int64_t end = i + 1 < timed.size() ? timed[i + 1].start : logEnd;
+
+            const uint32_t place = m_strings.intern(session.placeId);
+            const bool reconnect = i > 0 && timed[i - 1].session->placeId == session.placeId;
+
+            m_log.push_back(logId);
+            m_start.push_back(start);
+            m_duration.push_back(static_cast<int32_t>(std::clamp<int64_t>(end - start, 0, MAX_SESSION_SECONDS)));
+            m_user.push_back(user);
+            m_place.push_back(place);
+            m_universe.push_back(m_strings.intern(session.universeId));
+            m_server.push_back(m_strings.intern(session.jobId.empty() ? session.serverIp : session.jobId));
+            m_reconnect.push_back(reconnect ? 1 : 0);
+        }
+    }
+
+    void Engine::accumulate(size_t row) {
+        Aggregate &agg = m_byAccountPlace[aggregateKey(m_user[row], m_place[row])];
+        agg.playSeconds += m_duration[row];
+        agg.sessions += 1;
+        agg.reconnects += m_reconnect[row];
+        agg.servers.insert(m_server[row]);
+        agg.lastPlayed = std::max(agg.lastPlayed, static_cast<time_t>(m_start[row]));
+        if (m_universe[row] != Dictionary::EMPTY) {
+            agg.universe = m_universe[row];
+        }
+
+        const int32_t day = dayOf(m_start[row]);
+        DayTotals &totals = m_byDay[day];
+        totals.day = day;
+        totals.sessions += 1;
+        totals.playSeconds += m_duration[row];
+    }
+
+    void Engine::rebuildAggregates() {
+        m_byAccountPlace.clear();
+        m_byDay.clear();
+        for (size_t row = 0; row < m_start.size(); ++row) {
+            accumulate(row);
+        }
+    }
+
+    void Engine::clear() {
+        std::lock_guard lock(m_mutex);
+        m_strings.clear();
+        m_logs.clear();
+        m_nextLogId = 0;
+        m_log.clear();
+        m_start.clear();
+        m_duration.clear();
+        m_user.clear();
+        m_place.clear();
+        m_universe.clear();
+        m_server.clear();
+        m_reconnect.clear();
+        m_byAccountPlace.clear();
+        m_byDay.clear();
+    }
+
+    std::vector<PlaceTotals> Engine::totalsByAccountPlace() const {
+        std::lock_guard lock(m_mutex);
+
+        std::vector<PlaceTotals> out;
+        out.reserve(m_byAccountPlace.size());
+
+        for (const auto &[key, agg]: m_byAccountPlace) {
+            out.push_back({
+                .userId = m_strings.value(static_cast<uint32_t>(key >> 32)),
+                .placeId = m_strings.value(static_cast<uint32_t>(key & 0xFFFFFFFFu)),
+                .universeId = m_strings.value(agg.universe),
+                .playSeconds = agg.playSeconds,
+                .sessions = agg.sessions,
+                .distinctServers = static_cast<uint32_t>(agg.servers.size()),
+                .reconnects = agg.reconnects,
+                .lastPlayed = agg.lastPlayed,
+            });
+        }
+
+        std::sort(out.begin(), out.end(), [](const PlaceTotals &a, const PlaceTotals &b) {
+            return a.playSeconds > b.playSeconds;
+        });
+        return out;
+    }
+
+    std::vector<PlaceTotals> Engine::totalsByAccountUniverse() const {
+        std::map<std::pair<std::string, std::string>, PlaceTotals> grouped;
+
+        for (auto &place: totalsByAccountPlace()) {
+            const std::string &universe = place.universeId.empty() ? place.placeId : place.universeId;
+            PlaceTotals &totals = grouped[{place.userId, universe}];
+            if (totals.sessions == 0) {
+                totals.userId = place.userId;
+                totals.universeId = universe;
+                totals.placeId = place.placeId;
+            }
+            totals.playSeconds += place.playSeconds;
+            totals.sessions += place.sessions;
+            totals.distinctServers += place.distinctServers; // job ids never repeat across places
+            totals.reconnects += place.reconnects;
+            totals.lastPlayed = std::max(totals.lastPlayed, place.lastPlayed);
+        }
+
+        std::vector<PlaceTotals> out;
+        out.reserve(grouped.size());
+        for (auto &[key, totals]: grouped) {
+            out.push_back(std::move(totals));
+        }
+
+        std::sort(out.begin(), out.end(), [](const PlaceTotals &a, const PlaceTotals &b) {
+            return a.playSeconds > b.playSeconds;
+        });
+        return out;
+    }
+
+    std::vector<DayTotals> Engine::sessionsPerDay() const {
+        std::lock_guard lock(m_mutex);
+
+        std::vector<DayTotals> out;
+        out.reserve(m_byDay.size());
+        for (const auto &[day, totals]: m_byDay) {
+            out.push_back(totals);
+        }
+
+        std::sort(out.begin(), out.end(), [](const DayTotals &a, const DayTotals &b) {
+            return a.day > b.day;
+        });
+        return out;
+    }
+
+    size_t Engine::sessionCount() const {
+        std::lock_guard lock(m_mutex);
+        return m_start.size();
+    }
+
+} // namespace HistoryAnalytics
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "ui/windows/history/history_log_types.h"
+
+namespace HistoryAnalytics {
+
+    struct PlaceTotals {
+            std::string userId;
+            std::string placeId;
+            std::string universeId;
+            int64_t playSeconds = 0;
+            uint32_t sessions = 0;
+            uint32_t distinctServers = 0;
+            uint32_t reconnects = 0; // back-to-back sessions of the same place in one client
+            time_t lastPlayed = 0;
+    };
+
+    struct DayTotals {
+            int32_t day = 0; // days since the unix epoch (UTC)
+            uint32_t sessions = 0;
+            int64_t playSeconds = 0;
+    };
+
+    // Incremental aggregation over parsed game sessions. Sessions are kept as columns of interned ids
+    // so hundreds of accounts worth of history stay small, and every ingest only touches the
+    // aggregates of the sessions it adds. A log that has grown since it was last seen (a client that
+    // is still running) replaces its old rows and the aggregates are rebuilt from the columns,
+    // never from the log files.
+    class Engine {
+        public:
+            // Returns true if the log contributed new or changed sessions
+            bool ingest(const LogInfo &log);
+
+            void clear();
+
+            [[nodiscard]] std::vector<PlaceTotals> totalsByAccountPlace() const;
+            [[nodiscard]] std::vector<PlaceTotals> totalsByAccountUniverse() const;
+            [[nodiscard]] std::vector<DayTotals> sessionsPerDay() const;
+
+            [[nodiscard]] size_t sessionCount() const;
+
+        private:
+            // Id EMPTY is always the empty string, so a zero-initialised id never names a real value
+            class Dictionary {
+                public:
+                    static constexpr uint32_t EMPTY = 0;
+
+                    Dictionary() { clear(); }
+
+                    uint32_t intern(const std::string &value);
+                    [[nodiscard]] const std::string &value(uint32_t id) const {
+                        return m_values[id];
+                    }
+                    void clear();
+
+                private:
+                    std::unordered_map<std::string, uint32_t> m_ids;
+                    std::vector<std::string> m_values;
+            };
+
+            struct Aggregate {
+                    int64_t playSeconds = 0;
+                    uint32_t sessions = 0;
+                    uint32_t reconnects = 0;
+                    uint32_t universe = Dictionary::EMPTY;
+                    time_t lastPlayed = 0;
+                    std::unordered_set<uint32_t> servers;
+            };
+
+            struct LogState {
+                    uint32_t id = 0;
+                    std::string lastTimestamp;
+                    size_t sessionCount = 0;
+            };
+
+            static uint64_t aggregateKey(uint32_t user, uint32_t place) {
+                return (static_cast<uint64_t>(user) << 32) | place;
+            }
+
+            void appendRows(uint32_t logId, const LogInfo &log);
+            void accumulate(size_t row);
+            void rebuildAggregates();
+
+            mutable std::mutex m_mutex;
+
+            Dictionary m_strings; // user, place, universe and job ids share one dictionary
+            std::unordered_map<std::string, LogState> m_logs; // keyed by full path
+            uint32_t m_nextLogId = 0;
+
+            // Session table, one entry per column per session
+            std::vector<uint32_t> m_log;
+            std::vector<int64_t> m_start;
+            std::vector<int32_t> m_duration;
+            std::vector<uint32_t> m_user;
+            std::vector<uint32_t> m_place;
+            std::vector<uint32_t> m_universe;
+            std::vector<uint32_t> m_server;
+            std::vector<uint8_t> m_reconnect;
+
+            std::unordered_map<uint64_t, Aggregate> m_byAccountPlace;
+            std::unordered_map<int32_t, DayTotals> m_byDay;
+    };
+
+    Engine &engine();
+
+} // namespace HistoryAnalytics
@@ -313,6 +313,8 @@ void parseLogFile(LogInfo &logInfo) {
         pos = lineEnd + 1;
     }
 
+    logInfo.lastTimestamp = std::move(currentTimestamp);
+
     createBackwardCompatSession(logInfo);
     sortSessions(logInfo);
 }
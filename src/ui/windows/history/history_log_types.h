@@ -17,6 +17,7 @@ struct LogInfo {
         std::string fileName;
         std::string fullPath;
         std::string timestamp; // First timestamp in log (ISO UTC)
+        std::string lastTimestamp; // Last timestamp in log (ISO UTC), end of the final session
         std::string version; // Roblox client version
         std::string channel; // Channel (production, etc.)
         std::string userId; // User ID (same across sessions)
@@ -1,9 +1,12 @@
 #include <algorithm>
 #include <atomic>
+#include <charconv>
 #include <chrono>
 #include <filesystem>
 #include <format>
 #include <mutex>
+#include <shared_mutex>
+#include <span>
 #include <string>
 #include <system_error>
 #include <thread>
@@ -17,8 +20,11 @@
 #include "../accounts/accounts_join_ui.h"
 #include "components/data.h"
 #include "console/console.h"
+#include "console/trace.h"
 #include "history.h"
+#include "history_analytics.h"
 #include "history_utils.h"
+#include "network/roblox/universe_metadata.h"
 #include "system/roblox_launcher.h"
 #include "ui/widgets/bottom_right_status.h"
 #include "ui/widgets/context_menus.h"
@@ -28,12 +34,14 @@
 #include "utils/account_utils.h"
 #include "utils/worker_thread.h"
 #include "utils/time_utils.h"
+#include "utils/trigram_index.h"
 
 namespace {
     constexpr auto ICON_REFRESH = "\xEF\x8B\xB1 ";
     constexpr auto ICON_TRASH = "\xEF\x87\xB8 ";
     constexpr auto ICON_FOLDER = "\xEF\x81\xBB ";
     constexpr auto ICON_JOIN = "\xEF\x8B\xB6 ";
+    constexpr auto ICON_STATS = "\xEF\x82\x80 ";
 
     constexpr float LIST_WIDTH_RATIO = 0.25f;
     constexpr float DETAIL_WIDTH_RATIO = 0.75f;
@@ -42,6 +50,7 @@ namespace {
 
     int g_selected_log_idx = -1;
     std::vector<LogInfo> g_logs;
+    TrigramIndex g_search_index; // fields of g_logs, doc id == index into g_logs
     std::atomic_bool g_logs_loading {false};
     std::atomic_bool g_stop_log_watcher {false};
     std::once_flag g_start_log_watcher_once;
@@ -50,6 +59,8 @@ namespace {
     std::vector<int> g_filtered_log_indices;
     bool g_search_active = false;
     bool g_should_scroll_to_selection = false;
+    bool g_show_play_time = false;
+    bool g_play_time_by_universe = false;
 } // namespace
 
 static void openLogsFolder() {
@@ -57,36 +68,29 @@ static void openLogsFolder() {
     if (!dir.empty() && std::filesystem::exists(dir)) {
         OpenFileOrFolder(dir);
     } else {
-        LOG_WARN("Logs folder not found.");
+        LOG_CAT_WARN(History, "Logs folder not found.");
     }
 }
 
-static std::string toLower(std::string str) {
-    std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) {
-        return std::tolower(c);
-    });
-    return str;
-}
-
-static bool matchesSearch(const LogInfo &log, const std::string &searchTerm) {
-    auto contains = [&searchTerm](const std::string &field) {
-        return toLower(field).find(searchTerm) != std::string::npos;
-    };
-
-    if (contains(log.fileName) || contains(log.fullPath) || contains(log.version) || contains(log.placeId)
-        || contains(log.jobId) || contains(log.universeId) || contains(log.userId)) {
-        return true;
+static void indexLog(TrigramIndex &fields, TrigramIndex::DocId doc, const LogInfo &log) {
+    if (log.isInstallerLog) {
+        return;
     }
 
+    fields.add(doc, log.fileName);
+    fields.add(doc, log.fullPath);
+    fields.add(doc, log.version);
+    fields.add(doc, log.placeId);
+    fields.add(doc, log.jobId);
+    fields.add(doc, log.universeId);
+    fields.add(doc, log.userId);
+
     for (const auto &session: log.sessions) {
-        if (searchTerm.find(session.placeId) != std::string::npos || searchTerm.find(session.jobId) != std::string::npos
-            || searchTerm.find(session.universeId) != std::string::npos
-            || searchTerm.find(session.serverIp) != std::string::npos) {
-            return true;
-        }
+        fields.add(doc, session.placeId);
+        fields.add(doc, session.jobId);
+        fields.add(doc, session.universeId);
+        fields.add(doc, session.serverIp);
     }
-
-    return false;
 }
 
 static void updateFilteredLogs() {
@@ -103,20 +107,9 @@ static void updateFilteredLogs() {
         return;
     }
 
-    std::string searchTerm = toLower(g_search_buffer);
-
     std::lock_guard<std::mutex> lk(g_logs_mtx);
-    for (int i = 0; i < static_cast<int>(g_logs.size()); ++i) {
-        const auto &log = g_logs[i];
-
-        if (log.isInstallerLog) {
-            continue;
-        }
-
-        if (matchesSearch(log, searchTerm)) {
-            g_filtered_log_indices.push_back(i);
-        }
-    }
+    const auto matches = g_search_index.search(g_search_buffer);
+    g_filtered_log_indices.assign(matches.begin(), matches.end());
 
     if (g_selected_log_idx != -1) {
         bool selectionInFiltered
@@ -138,7 +131,7 @@ static void clearLogs() {
                 std::error_code ec;
                 std::filesystem::remove(entry.path(), ec);
                 if (ec) {
-                    LOG_WARN("Failed to delete log: {}", entry.path().string());
+                    LOG_CAT_WARN(History, "Failed to delete log: {}", entry.path().string());
                 }
             }
         }
@@ -146,7 +139,9 @@ static void clearLogs() {
 
     std::lock_guard<std::mutex> lk(g_logs_mtx);
     g_logs.clear();
+    g_search_index.clear();
     g_selected_log_idx = -1;
+    HistoryAnalytics::engine().clear();
 }
 
 static void refreshLogs() {
@@ -156,11 +151,13 @@ static void refreshLogs() {
 
     g_logs_loading = true;
     WorkerThreads::runBackground([]() {
-        LOG_INFO("Scanning Roblox logs folder...");
+        TRACE_SPAN(History, "history.refresh");
+        LOG_CAT_INFO(History, "Scanning Roblox logs folder...");
         std::vector<LogInfo> tempLogs;
         auto dir = GetLogsFolder();
 
         if (!dir.empty() && std::filesystem::exists(dir)) {
+            TRACE_SPAN(History, "history.scan");
             for (const auto &entry: std::filesystem::directory_iterator(dir)) {
                 if (entry.is_regular_file()) {
                     std::string fName = entry.path().filename().string();
@@ -168,6 +165,8 @@ static void refreshLogs() {
                         LogInfo logInfo;
                         logInfo.fileName = fName;
                         logInfo.fullPath = entry.path().string();
+                        Console::TraceSpan span(Console::Category::History, "history.parse");
+                        span.Detail(fName);
                         parseLogFile(logInfo);
                         if (!logInfo.timestamp.empty() || !logInfo.version.empty()) {
                             tempLogs.push_back(logInfo);
@@ -181,14 +180,35 @@ static void refreshLogs() {
             return b.timestamp < a.timestamp;
         });
 
+        size_t changedLogs = 0;
+        {
+            TRACE_SPAN(History, "history.analytics");
+            for (const auto &log: tempLogs) {
+                changedLogs += HistoryAnalytics::engine().ingest(log) ? 1 : 0;
+            }
+        }
+        if (changedLogs > 0) {
+            LOG_CAT_INFO(History, "Play time analytics updated from {} logs.", changedLogs);
+        }
+
+        TrigramIndex searchIndex;
+        searchIndex.reserve(tempLogs.size());
+        {
+            TRACE_SPAN(History, "history.index");
+            for (size_t i = 0; i < tempLogs.size(); ++i) {
+                indexLog(searchIndex, static_cast<TrigramIndex::DocId>(i), tempLogs[i]);
+            }
+        }
+
         {
             std::lock_guard<std::mutex> lk(g_logs_mtx);
             g_logs.clear();
             g_logs = std::move(tempLogs);
+            g_search_index = std::move(searchIndex);
             g_selected_log_idx = -1;
         }
 
-        LOG_INFO("Log scan complete. Recreated logs cache with {} logs.", tempLogs.size());
+        LOG_CAT_INFO(History, "Log scan complete. Recreated logs cache with {} logs.", tempLogs.size());
         g_logs_loading = false;
 
         updateFilteredLogs();
@@ -199,6 +219,7 @@ static void startLogWatcher() {
     {
         std::lock_guard<std::mutex> lk(g_logs_mtx);
         g_logs.clear();
+        g_search_index.clear();
     }
 
     g_search_buffer[0] = '\0';
@@ -390,7 +411,7 @@ static void DisplayLogDetails(const LogInfo &logInfo) {
                         if (place_id_val > 0) {
                             launchWithSelectedAccounts(LaunchParams::gameJob(place_id_val, session.jobId));
                         } else {
-                            LOG_INFO("Invalid Place ID in instance.");
+                            LOG_CAT_INFO(History, "Invalid Place ID in instance.");
                         }
                     }
 
@@ -453,11 +474,130 @@ static void DisplayLogDetails(const LogInfo &logInfo) {
     }
 }
 
+static std::string formatPlayTime(int64_t seconds) {
+    if (seconds < 60) {
+        return std::format("{}s", seconds);
+    }
+    if (seconds < 3600) {
+        return std::format("{}m", seconds / 60);
+    }
+    return std::format("{}h {}m", seconds / 3600, (seconds % 3600) / 60);
+}
+
+static std::string accountLabel(const std::string &userId) {
+    if (userId.empty()) {
+        return "Unknown";
+    }
+    std::shared_lock lock(g_accountsMutex);
+    for (const auto &account: g_accounts) {
+        if (account.userId == userId) {
+            return account.displayName.empty() ? account.username : account.displayName;
+        }
+    }
+    return userId;
+}
+
+// Game name once the shared metadata cache has it; the id alone until then
+static std::string universeLabel(const std::string &universeId) {
+    uint64_t id = 0;
+    const auto [ptr, ec] = std::from_chars(universeId.data(), universeId.data() + universeId.size(), id);
+    if (ec != std::errc {} || id == 0) {
+        return universeId;
+    }
+
+    auto &metadata = Roblox::UniverseMetadata::instance();
+    if (auto info = metadata.summary(id); info && !info->name.empty()) {
+        return std::format("{} ({})", info->name, universeId);
+    }
+    metadata.prefetch(std::span(&id, 1));
+    return universeId;
+}
+
+static void DisplayPlayTimeStats() {
+    auto &engine = HistoryAnalytics::engine();
+
+    ImGui::Indent(TEXT_INDENT);
+    ImGui::Spacing();
+    ImGui::Text("%s", std::format("{} sessions across all logs", engine.sessionCount()).c_str());
+    ImGui::SameLine();
+    ImGui::Checkbox("Group by universe", &g_play_time_by_universe);
+    ImGui::Unindent(TEXT_INDENT);
+
+    const auto totals = g_play_time_by_universe ? engine.totalsByAccountUniverse() : engine.totalsByAccountPlace();
+
+    ImGuiTableFlags tableFlags = ImGuiTableFlags_BordersInnerH | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp;
+    ImGui::SeparatorText("Play Time");
+    if (ImGui::BeginTable("PlayTimeTable", 6, tableFlags)) {
+        ImGui::TableSetupColumn("Account");
+        ImGui::TableSetupColumn(g_play_time_by_universe ? "Universe" : "Place ID");
+        ImGui::TableSetupColumn("Play Time");
+        ImGui::TableSetupColumn("Sessions");
+        ImGui::TableSetupColumn("Servers");
+        ImGui::TableSetupColumn("Reconnects");
+        ImGui::TableHeadersRow();
+
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(totals.size()));
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                const auto &row = totals[i];
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                ImGui::TextUnformatted(accountLabel(row.userId).c_str());
+                ImGui::TableSetColumnIndex(1);
+                if (g_play_time_by_universe) {
+                    ImGui::TextUnformatted(universeLabel(row.universeId).c_str());
+                } else {
+                    ImGui::TextUnformatted(row.placeId.c_str());
+                }
+                if (row.lastPlayed != 0 && ImGui::IsItemHovered()) {
+                    ImGui::SetTooltip("Last played %s", formatAbsoluteWithRelativeLocal(row.lastPlayed).c_str());
+                }
+                ImGui::TableSetColumnIndex(2);
+                ImGui::TextUnformatted(formatPlayTime(row.playSeconds).c_str());
+                ImGui::TableSetColumnIndex(3);
+                ImGui::Text("%u", row.sessions);
+                ImGui::TableSetColumnIndex(4);
+                ImGui::Text("%u", row.distinctServers);
+                ImGui::TableSetColumnIndex(5);
+                ImGui::Text("%u", row.reconnects);
+            }
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::SeparatorText("Sessions Per Day");
+    if (ImGui::BeginTable("SessionsPerDayTable", 3, tableFlags)) {
+        ImGui::TableSetupColumn("Day (UTC)");
+        ImGui::TableSetupColumn("Sessions");
+        ImGui::TableSetupColumn("Play Time");
+        ImGui::TableHeadersRow();
+
+        for (const auto &day: engine.sessionsPerDay()) {
+            const std::chrono::year_month_day date {std::chrono::sys_days {std::chrono::days {day.day}}};
+            const std::string label = std::format(
+                "{:04}-{:02}-{:02}",
+                static_cast<int>(date.year()),
+                static_cast<unsigned>(date.month()),
+                static_cast<unsigned>(date.day())
+            );
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::TextUnformatted(label.c_str());
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%u", day.sessions);
+            ImGui::TableSetColumnIndex(2);
+            ImGui::TextUnformatted(formatPlayTime(day.playSeconds).c_str());
+        }
+        ImGui::EndTable();
+    }
+}
+
 void RenderHistoryTab() {
     std::call_once(g_start_log_watcher_once, startLogWatcher);
 
     if (ImGui::Button(std::format("{} Refresh Logs", ICON_REFRESH).c_str())) {
-        LOG_INFO("Recreating logs cache from scratch...");
+        LOG_CAT_INFO(History, "Recreating logs cache from scratch...");
         refreshLogs();
         g_search_buffer[0] = '\0';
         g_search_active = false;
@@ -477,6 +617,10 @@ void RenderHistoryTab() {
         });
     }
     ImGui::SameLine();
+    if (ImGui::Button(std::format("{}{}", ICON_STATS, g_show_play_time ? "Log Details" : "Play Time").c_str())) {
+        g_show_play_time = !g_show_play_time;
+    }
+    ImGui::SameLine();
     if (g_logs_loading.load()) {
         ImGui::TextUnformatted("Loading...");
         ImGui::SameLine();
@@ -590,7 +734,9 @@ void RenderHistoryTab() {
     ImGui::BeginChild("##HistoryDetails", ImVec2(detailWidth, 0), true);
     ImGui::PopStyleVar();
 
-    if (g_selected_log_idx >= 0) {
+    if (g_show_play_time) {
+        DisplayPlayTimeStats();
+    } else if (g_selected_log_idx >= 0) {
         std::lock_guard<std::mutex> lk(g_logs_mtx);
         if (g_selected_log_idx < static_cast<int>(g_logs.size())) {
             const auto &logInfo = g_logs[g_selected_log_idx];
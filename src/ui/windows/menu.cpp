@@ -614,6 +614,9 @@ bool RenderMainMenu() {
                 acc->status = g_duplicateAccountModal.pendingPresence;
                 acc->voiceStatus = g_duplicateAccountModal.pendingVoiceStatus.status;
                 acc->voiceBanExpiry = g_duplicateAccountModal.pendingVoiceStatus.bannedUntil;
+                if (!acc->proxy.empty()) {
+                    HttpClient::setAccountProxy(acc->id, acc->proxy, acc->cookie);
+                }
 
                 LOG_INFO("Updated existing account {} - {}", acc->id, acc->displayName);
                 Data::SaveAccounts();
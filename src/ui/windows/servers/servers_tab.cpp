@@ -18,10 +18,14 @@
 
 #include "imgui_internal.h"
 
+#include "components/data.h"
 #include "console/console.h"
 #include "network/roblox/auth.h"
 #include "network/roblox/common.h"
 #include "network/roblox/games.h"
+#include "network/roblox/private_server_aggregator.h"
+#include "network/roblox/server_crawler.h"
+#include "network/roblox/server_finder.h"
 #include "network/roblox/session.h"
 #include "network/roblox/social.h"
 #include "system/roblox_launcher.h"
@@ -92,12 +96,18 @@ namespace {
             int ping;
 
             std::string shareLink;
+
+            // Set in the all-accounts view, where each server is acted on through an account that sees it
+            int accountId {0};
+            std::string cookie;
+            size_t accountCount {0};
     };
 
     struct ServerState {
             ServerSortMode sortMode {ServerSortMode::None};
             int sortComboIndex {0};
-            std::vector<PublicServerInfo> cachedServers;
+            Roblox::ServerStore pageServers;   // current page
+            Roblox::ServerStore cachedServers; // every cached page, by job id, for search
             std::unordered_map<std::string, Roblox::ServerPage> pageCache;
             std::string currentCursor;
             std::string nextCursor;
@@ -105,9 +115,26 @@ namespace {
             char searchBuffer[64] {};
             char placeIdBuffer[32] {};
             uint64_t currentPlaceId {0};
+
+            Roblox::ServerCrawler crawler;
+            bool showCrawl {false};
+            bool crawlTopOnly {false};
+
+            Roblox::ServerFinder finder;
+            bool resolvingPlayer {false};
+    };
+
+    // Row order last shown, reused until the store, search text or sort changes
+    struct ServerViewCache {
+            uint64_t storeVersion {0};
+            std::string query;
+            ServerSortMode sortMode {ServerSortMode::None};
+            bool topOnly {false};
+            std::vector<uint32_t> order;
     };
 
     ServerState g_state;
+    ServerViewCache g_view;
     int g_activeServersTab = static_cast<int>(ServerTab::Public);
 
     std::string toLowerCase(std::string_view sv) {
@@ -119,19 +146,6 @@ namespace {
         return result;
     }
 
-    bool matchesQuery(const PublicServerInfo &server, std::string_view queryLower) {
-        const auto haystack = std::format(
-            "{} {}/{} {}ms {}",
-            server.jobId,
-            server.currentPlayers,
-            server.maximumPlayers,
-            static_cast<int>(server.averagePing + 0.5),
-            static_cast<int>(server.averageFps + 0.5)
-        );
-
-        return toLowerCase(haystack).find(queryLower) != std::string::npos;
-    }
-
     std::expected<uint64_t, std::string> parsePlaceId(std::string_view input) {
         std::string cleaned;
         std::ranges::copy_if(input, std::back_inserter(cleaned), [](char c) {
@@ -158,7 +172,39 @@ namespace {
         return value;
     }
 
+    void rebuildServerStores(const Roblox::ServerPage &page) {
+        g_state.pageServers.clear();
+        g_state.pageServers.reserve(page.data.size());
+        for (const auto &server: page.data) {
+            g_state.pageServers.append(server);
+        }
+
+        std::vector<const PublicServerInfo *> all;
+        for (const auto &[cursor, cached]: g_state.pageCache) {
+            for (const auto &server: cached.data) {
+                all.push_back(&server);
+            }
+        }
+        std::ranges::sort(all, {}, &PublicServerInfo::jobId);
+
+        g_state.cachedServers.clear();
+        g_state.cachedServers.reserve(all.size());
+        for (const auto *server: all) {
+            g_state.cachedServers.append(*server);
+        }
+    }
+
+    void clearServerStores() {
+        g_state.pageServers.clear();
+        g_state.cachedServers.clear();
+    }
+
     void fetchPageServers(uint64_t placeId, std::string_view cursor = {}) {
+        if (g_state.showCrawl) {
+            g_state.showCrawl = false;
+            g_state.crawler.reset();
+        }
+
         if (placeId != g_state.currentPlaceId) {
             g_state.pageCache.clear();
             g_state.currentPlaceId = placeId;
@@ -168,7 +214,7 @@ namespace {
 
         if (const auto it = g_state.pageCache.find(cursorStr); it != g_state.pageCache.end()) {
             const auto &page = it->second;
-            g_state.cachedServers = page.data;
+            rebuildServerStores(page);
             g_state.nextCursor = page.nextCursor;
             g_state.prevCursor = page.prevCursor;
             g_state.currentCursor = cursorStr;
@@ -179,64 +225,57 @@ namespace {
         try {
             const auto page = Roblox::getPublicServersPage(placeId, cursorStr);
             g_state.pageCache.emplace(cursorStr, page);
-            g_state.cachedServers = page.data;
+            rebuildServerStores(page);
             g_state.nextCursor = page.nextCursor;
             g_state.prevCursor = page.prevCursor;
             g_state.currentCursor = cursorStr;
             LOG_INFO(page.data.empty() ? "No servers found for this page" : "Fetched servers");
         } catch (const std::exception &ex) {
             LOG_INFO("Fetch error: {}", ex.what());
-            g_state.cachedServers.clear();
+            clearServerStores();
             g_state.nextCursor.clear();
             g_state.prevCursor.clear();
         }
     }
 
-    void sortServers(std::vector<PublicServerInfo> &servers, ServerSortMode mode) {
+    constexpr size_t CRAWL_TOP_K = 100;
+
+    std::optional<Roblox::ServerStore::Sort> storeSortFor(ServerSortMode mode) {
+        using Column = Roblox::ServerStore::Column;
         switch (mode) {
             case ServerSortMode::PingAsc:
-                std::ranges::sort(servers, {}, &PublicServerInfo::averagePing);
-                break;
+                return Roblox::ServerStore::Sort {Column::Ping, false};
             case ServerSortMode::PingDesc:
-                std::ranges::sort(servers, std::ranges::greater {}, &PublicServerInfo::averagePing);
-                break;
+                return Roblox::ServerStore::Sort {Column::Ping, true};
             case ServerSortMode::PlayersAsc:
-                std::ranges::sort(servers, {}, &PublicServerInfo::currentPlayers);
-                break;
+                return Roblox::ServerStore::Sort {Column::Players, false};
             case ServerSortMode::PlayersDesc:
-                std::ranges::sort(servers, std::ranges::greater {}, &PublicServerInfo::currentPlayers);
-                break;
+                return Roblox::ServerStore::Sort {Column::Players, true};
             case ServerSortMode::None:
             default:
-                break;
+                return std::nullopt;
         }
     }
 
-    std::vector<PublicServerInfo> getFilteredServers() {
-        const std::string queryLower = toLowerCase(g_state.searchBuffer);
-        const bool isSearching = !queryLower.empty();
-
-        std::vector<PublicServerInfo> displayList;
-
-        if (isSearching) {
-            for (const auto &[cursor, page]: g_state.pageCache) {
-                for (const auto &server: page.data) {
-                    if (matchesQuery(server, queryLower)) {
-                        displayList.push_back(server);
-                    }
-                }
-            }
-        } else {
-            displayList = g_state.cachedServers;
-        }
-
-        if (g_state.sortMode == ServerSortMode::None && isSearching) {
-            std::ranges::sort(displayList, {}, &PublicServerInfo::jobId);
-        } else {
-            sortServers(displayList, g_state.sortMode);
+    // Rows of store to show: search filter, then sort, cut to the top rows when asked. Recomputed only
+    // when the store or the controls change, not every frame.
+    const std::vector<uint32_t> &getServerOrder(const Roblox::ServerStore &store, bool topOnly) {
+        const std::string_view query = g_state.searchBuffer;
+        if (g_view.storeVersion == store.version() && g_view.query == query && g_view.sortMode == g_state.sortMode
+            && g_view.topOnly == topOnly) {
+            return g_view.order;
         }
 
-        return displayList;
+        g_view.storeVersion = store.version();
+        g_view.query = query;
+        g_view.sortMode = g_state.sortMode;
+        g_view.topOnly = topOnly;
+        g_view.order = store.query(
+            Roblox::ServerQuery::parse(query),
+            storeSortFor(g_state.sortMode),
+            topOnly ? CRAWL_TOP_K : SIZE_MAX
+        );
+        return g_view.order;
     }
 
     struct RowMetrics {
@@ -263,9 +302,10 @@ namespace {
         const auto &style = ImGui::GetStyle();
 
         const float fetchWidth = ImGui::CalcTextSize("Fetch Servers").x + style.FramePadding.x * 2.0f;
+        const float crawlWidth = ImGui::CalcTextSize("Crawl All").x + style.FramePadding.x * 2.0f;
         const float prevWidth = ImGui::CalcTextSize("\xEF\x81\x93 Prev Page").x + style.FramePadding.x * 2.0f;
         const float nextWidth = ImGui::CalcTextSize("Next Page \xEF\x81\x94").x + style.FramePadding.x * 2.0f;
-        const float totalButtons = fetchWidth + prevWidth + nextWidth + style.ItemSpacing.x * 2;
+        const float totalButtons = fetchWidth + crawlWidth + prevWidth + nextWidth + style.ItemSpacing.x * 3;
 
         const float inputWidth
             = std::max(MIN_INPUT_WIDTH, ImGui::GetContentRegionAvail().x - totalButtons - style.ItemSpacing.x);
@@ -285,20 +325,152 @@ namespace {
         }
 
         ImGui::SameLine(0, style.ItemSpacing.x);
-        ImGui::BeginDisabled(g_state.prevCursor.empty());
+        if (ImGui::Button("Crawl All", ImVec2(crawlWidth, 0))) {
+            if (auto result = parsePlaceId(g_state.placeIdBuffer)) {
+                g_state.currentPlaceId = *result;
+                g_state.pageCache.clear();
+                clearServerStores();
+                g_state.nextCursor.clear();
+                g_state.prevCursor.clear();
+                g_state.showCrawl = true;
+                g_state.crawler.start(*result);
+            } else {
+                LOG_INFO(result.error());
+            }
+        }
+
+        ImGui::SameLine(0, style.ItemSpacing.x);
+        ImGui::BeginDisabled(g_state.showCrawl || g_state.prevCursor.empty());
         if (ImGui::Button("\xEF\x81\x93 Prev Page", ImVec2(prevWidth, 0))) {
             fetchPageServers(g_state.currentPlaceId, g_state.prevCursor);
         }
         ImGui::EndDisabled();
 
         ImGui::SameLine(0, style.ItemSpacing.x);
-        ImGui::BeginDisabled(g_state.nextCursor.empty());
+        ImGui::BeginDisabled(g_state.showCrawl || g_state.nextCursor.empty());
         if (ImGui::Button("Next Page \xEF\x81\x94", ImVec2(nextWidth, 0))) {
             fetchPageServers(g_state.currentPlaceId, g_state.nextCursor);
         }
         ImGui::EndDisabled();
     }
 
+    void renderCrawlStatus() {
+        const auto progress = g_state.crawler.progress();
+
+        if (progress.running) {
+            ImGui::TextUnformatted(
+                std::format("Crawling... {} servers across {} pages", progress.servers, progress.pages).c_str()
+            );
+            ImGui::SameLine();
+            if (ImGui::SmallButton("Cancel")) {
+                g_state.crawler.cancel();
+            }
+        } else if (!progress.error.empty()) {
+            ImGui::TextColored(
+                ImVec4(1.0f, 0.4f, 0.4f, 1.0f),
+                "%s",
+                std::format("Crawl stopped after {} servers: {}", progress.servers, progress.error).c_str()
+            );
+        } else {
+            const auto summary = std::format(
+                "{} {} servers across {} pages",
+                progress.cancelled ? "Cancelled with" : "Crawled",
+                progress.servers,
+                progress.pages
+            );
+            ImGui::TextUnformatted(summary.c_str());
+        }
+
+        ImGui::SameLine();
+        ImGui::Checkbox("Top 100 only", &g_state.crawlTopOnly);
+    }
+
+    void startPlayerSearch(uint64_t placeId) {
+        UserSpecifier spec {};
+        if (!parseUserSpecifier(s_playerBuffer.data(), spec)) {
+            LOG_INFO("Enter username or userId (id=000)");
+            return;
+        }
+
+        if (spec.isId) {
+            g_state.finder.start(placeId, spec.id);
+            return;
+        }
+
+        g_state.resolvingPlayer = true;
+        WorkerThreads::runBackground([placeId, username = spec.username]() {
+            const uint64_t userId = Roblox::getUserIdFromUsername(username);
+            WorkerThreads::RunOnMain([placeId, userId, username]() {
+                g_state.resolvingPlayer = false;
+                if (userId == 0) {
+                    LOG_WARN("User not found: {}", username);
+                    return;
+                }
+                g_state.finder.start(placeId, userId);
+            });
+        });
+    }
+
+    void renderPlayerFinder() {
+        const auto &style = ImGui::GetStyle();
+        const auto progress = g_state.finder.progress();
+        const bool busy = progress.running || g_state.resolvingPlayer;
+
+        const float buttonWidth = ImGui::CalcTextSize("Find Player").x + style.FramePadding.x * 2.0f;
+        const float inputWidth
+            = std::max(MIN_INPUT_WIDTH, ImGui::GetContentRegionAvail().x - buttonWidth - style.ItemSpacing.x);
+        ImGui::PushItemWidth(inputWidth);
+        ImGui::InputTextWithHint(
+            "##find_player",
+            "Find player in this place: username or userId (id=000)",
+            s_playerBuffer.data(),
+            s_playerBuffer.size()
+        );
+        ImGui::PopItemWidth();
+
+        ImGui::SameLine(0, style.ItemSpacing.x);
+        if (busy) {
+            if (ImGui::Button("Cancel##find_player", ImVec2(buttonWidth, 0))) {
+                g_state.finder.cancel();
+            }
+        } else if (ImGui::Button("Find Player", ImVec2(buttonWidth, 0))) {
+            if (auto result = parsePlaceId(g_state.placeIdBuffer)) {
+                g_state.currentPlaceId = *result;
+                startPlayerSearch(*result);
+            } else {
+                LOG_INFO(result.error());
+            }
+        }
+
+        if (g_state.resolvingPlayer) {
+            ImGui::TextUnformatted("Looking up user...");
+        } else if (progress.running) {
+            const auto status = std::format(
+                "Searching... {} players checked in {} servers across {} pages",
+                progress.tokensChecked,
+                progress.servers,
+                progress.pages
+            );
+            ImGui::TextUnformatted(status.c_str());
+        } else if (!progress.foundJobId.empty()) {
+            ImGui::TextUnformatted(std::format("Found in server {}", progress.foundJobId).c_str());
+            ImGui::SameLine();
+            if (ImGui::SmallButton("Join##found_player")) {
+                launchWithSelectedAccounts(LaunchParams::gameJob(progress.placeId, progress.foundJobId));
+            }
+        } else if (!progress.error.empty()) {
+            ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "%s", progress.error.c_str());
+        } else if (g_state.finder.active()) {
+            const auto summary = std::format(
+                "{} after checking {} players in {} servers",
+                progress.cancelled ? "Cancelled" : "Not found",
+                progress.tokensChecked,
+                progress.servers
+            );
+            ImGui::TextUnformatted(summary.c_str());
+        }
+    }
+
     void renderFilterControls() {
         constexpr const char *SORT_OPTIONS[] = {"None", "Ping (Asc)", "Ping (Desc)", "Players (Asc)", "Players (Desc)"};
 
@@ -308,7 +480,12 @@ namespace {
             = std::max(MIN_INPUT_WIDTH, ImGui::GetContentRegionAvail().x - comboWidth - style.ItemSpacing.x);
 
         ImGui::PushItemWidth(searchWidth);
-        ImGui::InputTextWithHint("##search_servers", "Search...", g_state.searchBuffer, sizeof(g_state.searchBuffer));
+        ImGui::InputTextWithHint(
+            "##search_servers",
+            "Search... (e.g. ping<100 free>0)",
+            g_state.searchBuffer,
+            sizeof(g_state.searchBuffer)
+        );
         ImGui::PopItemWidth();
 
         ImGui::SameLine(0, style.ItemSpacing.x);
@@ -400,7 +577,7 @@ namespace {
         ImGui::PopID();
     }
 
-    void renderServerTable(const std::vector<PublicServerInfo> &servers) {
+    template<typename RowAt> void renderServerTable(size_t rowCount, RowAt &&rowAt) {
         constexpr ImGuiTableFlags tableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg
                                                | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY
                                                | ImGuiTableFlags_Hideable | ImGuiTableFlags_Reorderable;
@@ -430,8 +607,12 @@ namespace {
         ImGui::TextUnformatted("Actions");
 
         const auto metrics = calculateRowMetrics();
-        for (const auto &server: servers) {
-            renderServerRow(server, metrics);
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(rowCount), metrics.height + ImGui::GetStyle().CellPadding.y * 2.0f);
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                renderServerRow(rowAt(static_cast<size_t>(i)), metrics);
+            }
         }
 
         ImGui::EndTable();
@@ -439,11 +620,28 @@ namespace {
 
     void renderPublicServers() {
         renderSearchControls();
+        renderPlayerFinder();
         ImGui::Separator();
         renderFilterControls();
 
-        const auto displayList = getFilteredServers();
-        renderServerTable(displayList);
+        if (g_state.showCrawl) {
+            renderCrawlStatus();
+            g_state.crawler.withStore([](const Roblox::ServerStore &store) {
+                const auto &order = getServerOrder(store, g_state.crawlTopOnly);
+                renderServerTable(order.size(), [&](size_t i) {
+                    return store.row(order[i]);
+                });
+            });
+            return;
+        }
+
+        // A search looks through every page fetched so far, not just the current one
+        const bool isSearching = g_state.searchBuffer[0] != '\0';
+        const auto &store = isSearching ? g_state.cachedServers : g_state.pageServers;
+        const auto &order = getServerOrder(store, false);
+        renderServerTable(order.size(), [&](size_t i) {
+            return store.row(order[i]);
+        });
     }
 
     class PrivateServerUI {
@@ -464,12 +662,73 @@ namespace {
             std::string currentCursor;
             std::vector<std::string> cursorHistory;
 
+            bool allAccounts = false;
+            Roblox::PrivateServerAggregator ownedAggregate {static_cast<int>(ServerType::MyServers)};
+            Roblox::PrivateServerAggregator joinableAggregate {static_cast<int>(ServerType::JoinableServers)};
+            std::vector<PrivateServer> aggregateServers;
+            uint64_t aggregateVersion = 0;
+            ServerType aggregateTab = ServerType::JoinableServers;
+
+            Roblox::PrivateServerAggregator &aggregator() {
+                return selectedTab == ServerType::MyServers ? ownedAggregate : joinableAggregate;
+            }
+
+            void refreshAggregate() {
+                std::vector<Roblox::PrivateServerAggregator::Account> accounts;
+                for (const auto &account: g_accounts) {
+                    if (AccountFilters::IsAccountUsable(account)) {
+                        accounts.push_back({account.id, account.cookie});
+                    }
+                }
+                aggregator().refresh(std::move(accounts));
+            }
+
+            // Rebuilds the table rows only when the aggregate has changed
+            void syncAggregate() {
+                auto &source = aggregator();
+                const uint64_t version = source.version();
+                if (version == aggregateVersion && aggregateTab == selectedTab) {
+                    return;
+                }
+                aggregateVersion = version;
+                aggregateTab = selectedTab;
+
+                aggregateServers.clear();
+                for (auto &entry: source.servers()) {
+                    const AccountData *owner = getAccountById(entry.accountIds.front());
+                    if (!owner) {
+                        continue;
+                    }
+
+                    const auto &info = entry.info;
+                    PrivateServer server {};
+                    server.name = info.name;
+                    server.ownerName = info.ownerName;
+                    server.ownerDisplayName = info.ownerName;
+                    server.universeName = info.universeName;
+                    server.vipServerId = info.privateServerId;
+                    server.placeId = info.placeId;
+                    server.universeId = info.universeId;
+                    server.ownerId = info.ownerId;
+                    server.active = info.active;
+                    server.expirationDate = info.expirationDate;
+                    server.willRenew = info.willRenew;
+                    server.priceInRobux = info.priceInRobux;
+                    server.accountId = owner->id;
+                    server.cookie = owner->cookie;
+                    server.accountCount = entry.accountIds.size();
+                    aggregateServers.push_back(std::move(server));
+                }
+            }
+
         public:
             void loadServers(ServerType tabType, const AccountData &account, const std::string &cursor = {}) {
                 isLoading = true;
                 errorMessage.clear();
 
-                WorkerThreads::runBackground([this, tabType, cookie = account.cookie, cursor]() {
+                const int accountId = account.id;
+                WorkerThreads::runBackground([this, tabType, accountId, cookie = account.cookie, cursor]() {
+                    HttpClient::AccountScope accountScope(accountId);
                     try {
                         auto page = Roblox::getAllPrivateServers(static_cast<int>(tabType), cookie, cursor);
 
@@ -530,7 +789,7 @@ namespace {
                 });
             }
 
-            void joinServer(const PrivateServer &server, const std::string &cookie) {
+            void joinServer(const PrivateServer &server, int accountId, const std::string &cookie) {
                 auto accountPtrs = getUsableSelectedAccounts();
                 if (accountPtrs.empty()) {
                     LOG_ERROR("No account selected to join server");
@@ -547,9 +806,12 @@ namespace {
 
                 LOG_INFO("Joining private server: {}", server.name);
 
-                WorkerThreads::runBackground([server, accounts = std::move(accounts), cookie]() {
+                WorkerThreads::runBackground([server, accounts = std::move(accounts), accountId, cookie]() {
                     try {
-                        auto page = Roblox::getPrivateServersForGame(server.placeId, cookie);
+                        auto page = [&] {
+                            HttpClient::AccountScope accountScope(accountId);
+                            return Roblox::getPrivateServersForGame(server.placeId, cookie);
+                        }();
 
                         std::string accessCode;
                         for (const auto &gameServer: page.data) {
@@ -571,8 +833,9 @@ namespace {
                 });
             }
 
-            void copyShareLink(const PrivateServer &server, const std::string &cookie) {
-                WorkerThreads::runBackground([vipServerId = server.vipServerId, cookie]() {
+            void copyShareLink(const PrivateServer &server, int accountId, const std::string &cookie) {
+                WorkerThreads::runBackground([vipServerId = server.vipServerId, accountId, cookie]() {
+                    HttpClient::AccountScope accountScope(accountId);
                     auto result = Roblox::getVipServerInfo(vipServerId, cookie);
                     if (result && !result->link.empty()) {
                         ImGui::SetClipboardText(result->link.c_str());
@@ -585,7 +848,7 @@ namespace {
                 });
             }
 
-            void regenerateShareLink(const PrivateServer &server, const std::string &cookie) {
+            void regenerateShareLink(const PrivateServer &server, int accountId, const std::string &cookie) {
                 ModalPopup::AddYesNo(
                     std::format(
                         "Regenerate the share link for \"{}\"?\n\n"
@@ -593,8 +856,9 @@ namespace {
                         "The new link will be copied to your clipboard.",
                         server.name
                     ),
-                    [vipServerId = server.vipServerId, cookie]() {
-                        WorkerThreads::runBackground([vipServerId, cookie]() {
+                    [vipServerId = server.vipServerId, accountId, cookie]() {
+                        WorkerThreads::runBackground([vipServerId, accountId, cookie]() {
+                            HttpClient::AccountScope accountScope(accountId);
                             auto result = Roblox::regenerateVipServerLink(vipServerId, cookie);
                             if (result) {
                                 ImGui::SetClipboardText(result->link.c_str());
@@ -627,7 +891,11 @@ namespace {
                             selectedTab = ServerType::JoinableServers;
                             currentCursor.clear();
                             cursorHistory.clear();
-                            loadServers(ServerType::JoinableServers, account);
+                            if (allAccounts) {
+                                refreshAggregate();
+                            } else {
+                                loadServers(ServerType::JoinableServers, account);
+                            }
                         }
                         ImGui::EndTabItem();
                     }
@@ -637,7 +905,11 @@ namespace {
                             selectedTab = ServerType::MyServers;
                             currentCursor.clear();
                             cursorHistory.clear();
-                            loadServers(ServerType::MyServers, account);
+                            if (allAccounts) {
+                                refreshAggregate();
+                            } else {
+                                loadServers(ServerType::MyServers, account);
+                            }
                         }
                         ImGui::EndTabItem();
                     }
@@ -649,7 +921,9 @@ namespace {
                 const float refreshWidth = ImGui::CalcTextSize("Refresh").x + style.FramePadding.x * 2.0f;
                 const float prevWidth = ImGui::CalcTextSize("\xEF\x81\x93 Prev").x + style.FramePadding.x * 2.0f;
                 const float nextWidth = ImGui::CalcTextSize("Next \xEF\x81\x94").x + style.FramePadding.x * 2.0f;
-                const float buttonsWidth = refreshWidth + prevWidth + nextWidth + style.ItemSpacing.x * 2;
+                const float allWidth = ImGui::CalcTextSize("All accounts").x + ImGui::GetFrameHeight()
+                                       + style.ItemInnerSpacing.x;
+                const float buttonsWidth = allWidth + refreshWidth + prevWidth + nextWidth + style.ItemSpacing.x * 3;
                 const float searchWidth
                     = std::max(MIN_INPUT_WIDTH, ImGui::GetContentRegionAvail().x - buttonsWidth - style.ItemSpacing.x);
 
@@ -657,15 +931,31 @@ namespace {
                 ImGui::InputTextWithHint("##private_search", "Search servers...", searchFilter, sizeof(searchFilter));
                 ImGui::PopItemWidth();
 
+                ImGui::SameLine(0, style.ItemSpacing.x);
+                if (ImGui::Checkbox("All accounts", &allAccounts)) {
+                    if (allAccounts) {
+                        refreshAggregate();
+                    } else {
+                        currentCursor.clear();
+                        cursorHistory.clear();
+                        loadServers(selectedTab, account);
+                    }
+                }
+
                 ImGui::SameLine(0, style.ItemSpacing.x);
                 if (ImGui::Button("Refresh", ImVec2(refreshWidth, 0))) {
-                    currentCursor.clear();
-                    cursorHistory.clear();
-                    loadServers(selectedTab, account);
+                    if (allAccounts) {
+                        // Pages fetched within the last few minutes are reused
+                        refreshAggregate();
+                    } else {
+                        currentCursor.clear();
+                        cursorHistory.clear();
+                        loadServers(selectedTab, account);
+                    }
                 }
 
                 ImGui::SameLine(0, style.ItemSpacing.x);
-                ImGui::BeginDisabled(cursorHistory.empty() || isLoading);
+                ImGui::BeginDisabled(allAccounts || cursorHistory.empty() || isLoading);
                 if (ImGui::Button("\xEF\x81\x93 Prev", ImVec2(prevWidth, 0))) {
                     if (!cursorHistory.empty()) {
                         std::string previousCursor = cursorHistory.back();
@@ -676,7 +966,7 @@ namespace {
                 ImGui::EndDisabled();
 
                 ImGui::SameLine(0, style.ItemSpacing.x);
-                ImGui::BeginDisabled(!nextPageCursor.has_value() || isLoading);
+                ImGui::BeginDisabled(allAccounts || !nextPageCursor.has_value() || isLoading);
                 if (ImGui::Button("Next \xEF\x81\x94", ImVec2(nextWidth, 0))) {
                     if (nextPageCursor.has_value()) {
                         cursorHistory.push_back(currentCursor);
@@ -687,20 +977,41 @@ namespace {
 
                 ImGui::Separator();
 
-                if (isLoading) {
-                    ImGui::Text("Loading servers...");
-                    return;
-                }
+                const std::vector<PrivateServer> *source = &servers;
+                if (allAccounts) {
+                    syncAggregate();
+                    source = &aggregateServers;
 
-                if (servers.empty() && errorMessage.empty()) {
-                    ImGui::Text("No servers found");
-                    return;
+                    // Rows stream in as each account's pages land, so keep rendering while loading
+                    const auto status = aggregator().status();
+                    if (status.running) {
+                        ImGui::Text("Loading accounts... %zu/%zu", status.accountsDone, status.accountsTotal);
+                    }
+                    for (const auto &error: status.errors) {
+                        ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%s", error.c_str());
+                    }
+                    if (aggregateServers.empty()) {
+                        if (!status.running) {
+                            ImGui::Text("No servers found");
+                        }
+                        return;
+                    }
+                } else {
+                    if (isLoading) {
+                        ImGui::Text("Loading servers...");
+                        return;
+                    }
+
+                    if (servers.empty() && errorMessage.empty()) {
+                        ImGui::Text("No servers found");
+                        return;
+                    }
                 }
 
                 const std::string filterLower = toLowerCase(searchFilter);
                 std::vector<PrivateServer> displayList;
 
-                for (const auto &server: servers) {
+                for (const auto &server: *source) {
                     if (!filterLower.empty()) {
                         const std::string name = toLowerCase(server.name);
                         const std::string game = toLowerCase(server.universeName);
@@ -714,11 +1025,11 @@ namespace {
                     displayList.push_back(server);
                 }
 
-                renderTable(displayList, account.cookie);
+                renderTable(displayList, account.id, account.cookie);
             }
 
         private:
-            void renderTable(const std::vector<PrivateServer> &displayList, const std::string &cookie) {
+            void renderTable(const std::vector<PrivateServer> &displayList, int accountId, const std::string &cookie) {
                 RowMetrics metrics = calculateRowMetrics();
                 const int columnCount = selectedTab == ServerType::JoinableServers ? 4 : 5;
                 constexpr ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg
@@ -750,6 +1061,8 @@ namespace {
                 ImGui::TableHeadersRow();
 
                 for (const auto &server: displayList) {
+                    const std::string &serverCookie = server.cookie.empty() ? cookie : server.cookie;
+                    const int serverAccountId = server.cookie.empty() ? accountId : server.accountId;
                     ImGui::TableNextRow();
                     ImGui::PushID(static_cast<int>(server.vipServerId));
 
@@ -768,10 +1081,17 @@ namespace {
                             menu.vipServerId = server.vipServerId;
                             menu.placeId = server.placeId;
                             menu.serverName = server.name;
-                            menu.onCopyShareLink = [this, &server, &cookie]() { copyShareLink(server, cookie); };
-                            menu.onRegenerateShareLink = [this, &server, &cookie]() { regenerateShareLink(server, cookie); };
-                            menu.onFillJoinOption = [vipServerId = server.vipServerId, cookie]() {
-                                WorkerThreads::runBackground([vipServerId, cookie]() {
+                            menu.onCopyShareLink = [this, &server, serverAccountId, &serverCookie]() {
+                                copyShareLink(server, serverAccountId, serverCookie);
+                            };
+                            menu.onRegenerateShareLink = [this, &server, serverAccountId, &serverCookie]() {
+                                regenerateShareLink(server, serverAccountId, serverCookie);
+                            };
+                            menu.onFillJoinOption = [vipServerId = server.vipServerId,
+                                                     accountId = serverAccountId,
+                                                     cookie = serverCookie]() {
+                                WorkerThreads::runBackground([vipServerId, accountId, cookie]() {
+                                    HttpClient::AccountScope accountScope(accountId);
                                     auto result = Roblox::getVipServerInfo(vipServerId, cookie);
                                     if (result && !result->link.empty()) {
                                         FillJoinOptions(result->link);
@@ -818,13 +1138,16 @@ namespace {
 
                     ImGui::TableNextColumn();
                     if (ImGui::Button("Join", ImVec2(-1, 0))) {
-                        joinServer(server, cookie);
+                        joinServer(server, serverAccountId, serverCookie);
                     }
 
                     if (ImGui::IsItemHovered()) {
                         ImGui::BeginTooltip();
                         ImGui::Text("Server ID: %llu", server.vipServerId);
                         ImGui::Text("Place ID: %llu", server.placeId);
+                        if (server.accountCount > 1) {
+                            ImGui::Text("Visible to %zu accounts", server.accountCount);
+                        }
                         if (selectedTab == ServerType::MyServers) {
                             if (!server.expirationDate.empty()) {
                                 ImGui::Text("Expires: %s", server.expirationDate.c_str());
@@ -843,7 +1166,7 @@ namespace {
 
                 ImGui::Separator();
                 ImGui::Text("Total servers: %zu", displayList.size());
-                if (nextPageCursor.has_value()) {
+                if (!allAccounts && nextPageCursor.has_value()) {
                     ImGui::SameLine();
                     ImGui::TextUnformatted("| More results available");
                 }
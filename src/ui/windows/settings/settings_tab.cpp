@@ -767,6 +767,16 @@ void RenderSettingsTab() {
         Data::SaveSettings();
     }
 
+    int retention = g_consoleRetention;
+    if (ImGui::InputInt("Console History (lines)", &retention, 500, 5000)) {
+        retention = std::clamp(retention, 100, 200000);
+        if (retention != g_consoleRetention) {
+            g_consoleRetention = retention;
+            Console::SetRetention(static_cast<size_t>(retention));
+            Data::SaveSettings();
+        }
+    }
+
     ImGui::Spacing();
     ImGui::SeparatorText("Updates");
 
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <tuple>
+#include <utility>
+
+#include <nlohmann/json.hpp>
+
+// Declarative JSON mappings. A struct's JSON shape is written once as a constexpr tuple of field
+// descriptors and read() / write() are expanded from it at compile time:
+//
+//     constexpr auto kFriendFields = JsonFields::fields(
+//         JsonFields::field("userId", &FriendInfo::id),
+//         JsonFields::field("username", &FriendInfo::username)
+//     );
+//
+// read() walks the object's members once and dispatches each key against the descriptor names, so
+// there is no find() per field and no temporary key strings. Missing and null members leave the
+// struct's default in place, which is how safeGet() and json::value() behaved.
+namespace JsonFields {
+
+    template<typename T, typename M>
+    struct Field {
+            std::string_view name;
+            M T::*member;
+    };
+
+    // A nested JSON object whose members map onto fields of the same struct, e.g. "creator": {...}
+    template<typename... Fs>
+    struct Object {
+            std::string_view name;
+            std::tuple<Fs...> fields;
+    };
+
+    template<typename T, typename M>
+    constexpr Field<T, M> field(std::string_view name, M T::*member) {
+        return {name, member};
+    }
+
+    template<typename... Fs>
+    constexpr std::tuple<Fs...> fields(Fs... fs) {
+        return {fs...};
+    }
+
+    template<typename... Fs>
+    constexpr Object<Fs...> object(std::string_view name, std::tuple<Fs...> inner) {
+        return {name, inner};
+    }
+
+    namespace detail {
+        template<typename T, typename M, typename Fn>
+        bool visitOne(const Field<T, M> &f, T &obj, std::string_view key, Fn &fn) {
+            if (f.name != key) {
+                return false;
+            }
+            fn(obj.*f.member);
+            return true;
+        }
+
+        template<typename T, typename... Fs, typename Fn>
+        bool visitOne(const Object<Fs...> &, T &, std::string_view, Fn &) {
+            return false;
+        }
+
+        template<typename T, typename M>
+        bool readOne(const Field<T, M> &f, T &obj, std::string_view key, const nlohmann::json &value) {
+            if (f.name != key) {
+                return false;
+            }
+            value.get_to(obj.*f.member);
+            return true;
+        }
+
+        template<typename T, typename... Fs>
+        bool readOne(const Object<Fs...> &f, T &obj, std::string_view key, const nlohmann::json &value);
+
+        template<typename T, typename M>
+        void writeOne(const Field<T, M> &f, const T &obj, nlohmann::json &out) {
+            out[f.name] = obj.*f.member;
+        }
+
+        template<typename T, typename... Fs>
+        void writeOne(const Object<Fs...> &f, const T &obj, nlohmann::json &out);
+
+        template<typename T, typename M>
+        constexpr void collectNames(const Field<T, M> &f, std::string_view *&out) {
+            *out++ = f.name;
+        }
+
+        template<typename... Fs>
+        constexpr void collectNames(const Object<Fs...> &f, std::string_view *&out) {
+            *out++ = f.name;
+        }
+    } // namespace detail
+
+    // Calls fn(member) for the field named key, for streaming decoders that see one member at a time.
+    // Nested objects are not visited; their members arrive at a deeper path.
+    template<typename T, typename... Fs, typename Fn>
+    bool visit(const std::tuple<Fs...> &fs, T &obj, std::string_view key, Fn &&fn) {
+        return std::apply([&](const auto &...f) { return (detail::visitOne(f, obj, key, fn) || ...); }, fs);
+    }
+
+    template<typename T, typename... Fs>
+    void read(const nlohmann::json &j, T &obj, const std::tuple<Fs...> &fs) {
+        if (!j.is_object()) {
+            return;
+        }
+        for (auto it = j.begin(); it != j.end(); ++it) {
+            if (it->is_null()) {
+                continue;
+            }
+            const std::string_view key = it.key();
+            std::apply([&](const auto &...f) { (detail::readOne(f, obj, key, *it) || ...); }, fs);
+        }
+    }
+
+    template<typename T, typename... Fs>
+    void write(nlohmann::json &j, const T &obj, const std::tuple<Fs...> &fs) {
+        std::apply([&](const auto &...f) { (detail::writeOne(f, obj, j), ...); }, fs);
+    }
+
+    // For static_assert: a repeated name would silently shadow the later field
+    template<typename... Fs>
+    constexpr bool uniqueNames(const std::tuple<Fs...> &fs) {
+        std::array<std::string_view, sizeof...(Fs)> names {};
+        std::string_view *out = names.data();
+        std::apply([&](const auto &...f) { (detail::collectNames(f, out), ...); }, fs);
+        for (size_t i = 0; i < names.size(); ++i) {
+            for (size_t k = i + 1; k < names.size(); ++k) {
+                if (names[i] == names[k]) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    namespace detail {
+        template<typename T, typename... Fs>
+        bool readOne(const Object<Fs...> &f, T &obj, std::string_view key, const nlohmann::json &value) {
+            if (f.name != key) {
+                return false;
+            }
+            read(value, obj, f.fields);
+            return true;
+        }
+
+        template<typename T, typename... Fs>
+        void writeOne(const Object<Fs...> &f, const T &obj, nlohmann::json &out) {
+            write(out[f.name], obj, f.fields);
+        }
+    } // namespace detail
+
+} // namespace JsonFields
@@ -56,6 +56,10 @@ namespace AltMan {
 		return EnsureDir(AppData() / "backups");
 	}
 
+	std::filesystem::path Paths::Logs() {
+		return EnsureDir(AppData() / "logs");
+	}
+
 	std::filesystem::path Paths::WebViewProfiles() {
 		return EnsureDir(AppData() / "WebViewProfiles" / "Roblox");
 	}
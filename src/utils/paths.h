@@ -9,6 +9,7 @@ namespace AltMan {
 
 			static std::filesystem::path Storage();
 			static std::filesystem::path Backups();
+			static std::filesystem::path Logs();
 			static std::filesystem::path WebViewProfiles();
 			static std::filesystem::path Config(std::string_view filename);
 
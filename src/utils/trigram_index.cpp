@@ -0,0 +1,160 @@
+#include "trigram_index.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace {
+
+    char lowerChar(char c) noexcept {
+        return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+
+    std::string toLowerCopy(std::string_view s) {
+        std::string out(s.size(), '\0');
+        std::transform(s.begin(), s.end(), out.begin(), lowerChar);
+        return out;
+    }
+
+    // Intersects two ascending lists in place. acc is the shorter one; for each of its ids the
+    // longer list is galloped through, doubling the step until it passes the id and then binary
+    // searching the last step, so a short list costs O(n log(m/n)) against a long one.
+    void intersectInto(std::vector<TrigramIndex::DocId> &acc, const std::vector<TrigramIndex::DocId> &other) {
+        auto first = other.begin(); // everything before first is below the current id
+        size_t kept = 0;
+
+        for (TrigramIndex::DocId doc: acc) {
+            auto bound = first;
+            std::ptrdiff_t step = 1;
+            while (bound != other.end() && *bound < doc) {
+                first = bound + 1;
+                bound = first + std::min(step, other.end() - first);
+                step *= 2;
+            }
+
+            first = std::lower_bound(first, bound, doc);
+            if (first == other.end()) {
+                break;
+            }
+            if (*first == doc) {
+                acc[kept++] = doc;
+            }
+        }
+
+        acc.resize(kept);
+    }
+
+} // namespace
+
+void TrigramIndex::addPosting(uint32_t trigram, DocId doc) {
+    auto &list = m_postings[trigram];
+
+    if (list.empty() || list.back() < doc) {
+        list.push_back(doc);
+        return;
+    }
+
+    if (list.back() == doc) {
+        return;
+    }
+
+    auto it = std::lower_bound(list.begin(), list.end(), doc);
+    if (it == list.end() || *it != doc) {
+        list.insert(it, doc);
+    }
+}
+
+void TrigramIndex::add(DocId doc, std::string_view field) {
+    if (field.empty()) {
+        return;
+    }
+
+    if (doc >= m_text.size()) {
+        m_text.resize(static_cast<size_t>(doc) + 1);
+    }
+
+    std::string lowered = toLowerCopy(field);
+
+    for (size_t i = 0; i + 3 <= lowered.size(); ++i) {
+        addPosting(
+            packTrigram(
+                static_cast<unsigned char>(lowered[i]),
+                static_cast<unsigned char>(lowered[i + 1]),
+                static_cast<unsigned char>(lowered[i + 2])
+            ),
+            doc
+        );
+    }
+
+    auto &text = m_text[doc];
+    if (!text.empty()) {
+        text.push_back(FIELD_SEPARATOR);
+    }
+    text.append(lowered);
+}
+
+void TrigramIndex::clear() {
+    m_postings.clear();
+    m_text.clear();
+}
+
+void TrigramIndex::reserve(size_t documentCount) {
+    m_text.reserve(documentCount);
+}
+
+bool TrigramIndex::contains(DocId doc, std::string_view queryLower) const {
+    return doc < m_text.size() && m_text[doc].find(queryLower) != std::string::npos;
+}
+
+std::vector<TrigramIndex::DocId> TrigramIndex::search(std::string_view query) const {
+    std::vector<DocId> result;
+    if (query.empty()) {
+        return result;
+    }
+
+    const std::string queryLower = toLowerCopy(query);
+
+    // Too short to produce a trigram: scan the pre-lowered text instead of re-lowercasing every field
+    if (queryLower.size() < 3) {
+        for (DocId doc = 0; doc < m_text.size(); ++doc) {
+            if (contains(doc, queryLower)) {
+                result.push_back(doc);
+            }
+        }
+        return result;
+    }
+
+    std::vector<const std::vector<DocId> *> lists;
+    lists.reserve(queryLower.size() - 2);
+
+    for (size_t i = 0; i + 3 <= queryLower.size(); ++i) {
+        const uint32_t trigram = packTrigram(
+            static_cast<unsigned char>(queryLower[i]),
+            static_cast<unsigned char>(queryLower[i + 1]),
+            static_cast<unsigned char>(queryLower[i + 2])
+        );
+
+        auto it = m_postings.find(trigram);
+        if (it == m_postings.end()) {
+            return result;
+        }
+        lists.push_back(&it->second);
+    }
+
+    std::sort(lists.begin(), lists.end());
+    lists.erase(std::unique(lists.begin(), lists.end()), lists.end());
+    std::sort(lists.begin(), lists.end(), [](const auto *a, const auto *b) {
+        return a->size() < b->size();
+    });
+
+    result = *lists.front();
+    for (size_t i = 1; i < lists.size() && !result.empty(); ++i) {
+        intersectInto(result, *lists[i]);
+    }
+
+    // Trigrams only prove the pieces exist, not that they are adjacent
+    std::erase_if(result, [&](DocId doc) {
+        return !contains(doc, queryLower);
+    });
+
+    return result;
+}
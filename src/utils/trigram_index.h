@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Case-insensitive substring index. Every document is lowercased once when it is added and
+// split into overlapping 3-byte grams; a query is answered by intersecting the posting lists
+// of its own trigrams and verifying the surviving candidates against the stored text.
+class TrigramIndex {
+    public:
+        using DocId = uint32_t;
+
+        // Appends a field to a document. Fields are kept apart so a match never spans two of them.
+        // Documents are expected to be added in ascending id order, which keeps posting lists sorted
+        // without any extra work; out-of-order ids are still handled.
+        void add(DocId doc, std::string_view field);
+
+        void clear();
+
+        void reserve(size_t documentCount);
+
+        // Returns ascending ids of every document that contains query as a case-insensitive substring.
+        [[nodiscard]] std::vector<DocId> search(std::string_view query) const;
+
+        [[nodiscard]] bool contains(DocId doc, std::string_view queryLower) const;
+
+        [[nodiscard]] size_t documentCount() const {
+            return m_text.size();
+        }
+
+        [[nodiscard]] size_t trigramCount() const {
+            return m_postings.size();
+        }
+
+    private:
+        static constexpr char FIELD_SEPARATOR = '\n';
+
+        static uint32_t packTrigram(unsigned char a, unsigned char b, unsigned char c) noexcept {
+            return (static_cast<uint32_t>(a) << 16) | (static_cast<uint32_t>(b) << 8) | c;
+        }
+
+        void addPosting(uint32_t trigram, DocId doc);
+
+        std::unordered_map<uint32_t, std::vector<DocId>> m_postings;
+        std::vector<std::string> m_text; // lowercased fields per document, used for verification
+};